@@ -236,6 +236,7 @@ if (NOT MUE_BUILD_UNIT_TESTS)
     set(MUE_BUILD_BRAILLE_TESTS OFF)
     set(MUE_BUILD_DIAGNOSTICS_TESTS OFF)
     set(MUE_BUILD_ENGRAVING_TESTS OFF)
+    set(MUE_BUILD_ENGRAVING_BENCHMARKS OFF)
     set(MUE_BUILD_IMPORTEXPORT_TESTS OFF)
     set(MUE_BUILD_NOTATION_TESTS OFF)
     set(MUE_BUILD_PLAYBACK_TESTS OFF)
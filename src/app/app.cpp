@@ -471,9 +471,13 @@ int App::processConverter(const CommandLineParser::ConverterTask& task)
     case CommandLineParser::ConvertType::File:
         ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode, soundProfile);
         break;
-    case CommandLineParser::ConvertType::ConvertScoreParts:
-        ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
-        break;
+    case CommandLineParser::ConvertType::ConvertScoreParts: {
+        std::optional<double> otherPartsVolume;
+        if (task.params.contains(CommandLineParser::ParamKey::OtherPartsVolume)) {
+            otherPartsVolume = task.params[CommandLineParser::ParamKey::OtherPartsVolume].toDouble();
+        }
+        ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath, forceMode, otherPartsVolume);
+    } break;
     case CommandLineParser::ConvertType::ExportScoreMedia: {
         io::path_t highlightConfigPath = task.params[CommandLineParser::ParamKey::HighlightConfigPath].toString();
         ret = converter()->exportScoreMedia(task.inputFile, task.outputFile, highlightConfigPath, stylePath, forceMode);
@@ -498,6 +502,9 @@ int App::processConverter(const CommandLineParser::ConverterTask& task)
         std::string scoreSource = task.params[CommandLineParser::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
     } break;
+    case CommandLineParser::ConvertType::Daemon:
+        ret = converter()->runDaemon();
+        break;
     }
 
     if (!ret) {
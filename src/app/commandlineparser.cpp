@@ -88,7 +88,12 @@ void CommandLineParser::init()
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
     m_parser.addOption(QCommandLineOption({ "M", "midi-operations" }, "Specify MIDI import operations file", "file"));
-    m_parser.addOption(QCommandLineOption({ "P", "export-score-parts" }, "Use with '-o <file>.pdf', export score and parts"));
+    m_parser.addOption(QCommandLineOption({ "P", "export-score-parts" },
+                                          "Use with '-o <file>.pdf', export score and parts; "
+                                          "with '-o <file>.mp3|ogg|flac|wav', export the audio of each part"));
+    m_parser.addOption(QCommandLineOption("other-parts-volume",
+                                          "Use with '-P -o <file>.mp3|ogg|flac|wav', keep the other parts in the audio of each part "
+                                          "at the given volume in dB", "dB"));
     m_parser.addOption(QCommandLineOption({ "f", "force" },
                                           "Use with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
 
@@ -103,6 +108,9 @@ void CommandLineParser::init()
                                           "Transpose the given score and export the data to a single JSON file, print it to stdout",
                                           "options"));
     m_parser.addOption(QCommandLineOption("source-update", "Update the source in the given score"));
+    m_parser.addOption(QCommandLineOption("converter-daemon",
+                                          "Keep running and process conversion requests read from stdin, one JSON object per line, "
+                                          "print a JSON line with the result of each to stdout, and the log to stderr"));
 
     m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
 
@@ -293,6 +301,16 @@ void CommandLineParser::parse(int argc, char** argv)
         } else {
             m_converterTask.type = ConvertType::ConvertScoreParts;
         }
+
+        if (m_parser.isSet("other-parts-volume")) {
+            bool ok = false;
+            double volume = m_parser.value("other-parts-volume").toDouble(&ok);
+            if (ok) {
+                m_converterTask.params[CommandLineParser::ParamKey::OtherPartsVolume] = volume;
+            } else {
+                LOGE() << "Option: --other-parts-volume not recognized value: " << m_parser.value("other-parts-volume");
+            }
+        }
     }
 
     if (m_parser.isSet("j")) {
@@ -336,6 +354,11 @@ void CommandLineParser::parse(int argc, char** argv)
         m_converterTask.params[CommandLineParser::ParamKey::ScoreTransposeOptions] = m_parser.value("score-transpose");
     }
 
+    if (m_parser.isSet("converter-daemon")) {
+        m_runMode = IApplication::RunMode::ConsoleApp;
+        m_converterTask.type = ConvertType::Daemon;
+    }
+
     if (m_parser.isSet("source-update")) {
         QStringList args2 = m_parser.positionalArguments();
 
@@ -102,7 +102,8 @@ public:
         ExportScorePartsPdf,
         ExportScoreTranspose,
         SourceUpdate,
-        ExportScoreVideo
+        ExportScoreVideo,
+        Daemon
     };
 
     enum class ParamKey {
@@ -112,6 +113,7 @@ public:
         ScoreTransposeOptions,
         ForceMode,
         SoundProfile,
+        OtherPartsVolume,
 
         // Video
     };
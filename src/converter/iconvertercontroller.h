@@ -22,6 +22,8 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <optional>
+
 #include "modularity/imoduleinterface.h"
 #include "types/ret.h"
 #include "io/path.h"
@@ -38,8 +40,11 @@ public:
     virtual Ret batchConvert(const io::path_t& batchJobFile,
                              const io::path_t& stylePath = io::path_t(), bool forceMode = false, const String& soundProfile = String()) = 0;
 
+    //! NOTE otherPartsVolume (dB) applies to the audio formats only:
+    //! without it, the audio of each part contains only that part
     virtual Ret convertScoreParts(const io::path_t& in, const io::path_t& out,
-                                  const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+                                  const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                                  std::optional<double> otherPartsVolume = std::nullopt) = 0;
 
     virtual Ret exportScoreMedia(const io::path_t& in, const io::path_t& out,
                                  const io::path_t& highlightConfigPath = io::path_t(),
@@ -56,6 +61,11 @@ public:
     virtual Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) = 0;
 
     virtual Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) = 0;
+
+    //! NOTE Processes requests read from stdin, one JSON object per line, until the end of the input,
+    //! and writes one JSON line with the result of each to stdout. Nothing else is written to stdout
+    //! while it runs, the rest of the output goes to stderr
+    virtual Ret runDaemon() = 0;
 };
 }
 
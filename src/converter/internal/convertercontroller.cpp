@@ -21,11 +21,23 @@
  */
 #include "convertercontroller.h"
 
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <set>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QTemporaryFile>
 
 #include "io/dir.h"
 #include "stringutils.h"
@@ -43,6 +55,43 @@ static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 static const std::string SVG_SUFFIX = "svg";
 
+//! NOTE Moves stdout to a new file, and stderr to stdout, so that anything else
+//! written to stdout (the console log, the messages of the libraries) goes to stderr
+static FILE* takeStdout()
+{
+    std::cout.flush();
+    std::fflush(stdout);
+
+#ifdef Q_OS_WIN
+    int fd = _dup(_fileno(stdout));
+    if (fd < 0 || _dup2(_fileno(stderr), _fileno(stdout)) < 0) {
+        return nullptr;
+    }
+    return _fdopen(fd, "w");
+#else
+    int fd = dup(fileno(stdout));
+    if (fd < 0 || dup2(fileno(stderr), fileno(stdout)) < 0) {
+        return nullptr;
+    }
+    return fdopen(fd, "w");
+#endif
+}
+
+static void restoreStdout(FILE* file)
+{
+    std::cout.flush();
+    std::fflush(stdout);
+    std::fflush(file);
+
+#ifdef Q_OS_WIN
+    _dup2(_fileno(file), _fileno(stdout));
+#else
+    dup2(fileno(file), fileno(stdout));
+#endif
+
+    std::fclose(file);
+}
+
 mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
                                           const String& soundProfile)
 {
@@ -123,7 +172,7 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
-                                               bool forceMode)
+                                               bool forceMode, std::optional<double> otherPartsVolume)
 {
     TRACEFUNC;
 
@@ -148,6 +197,11 @@ mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const m
         ret = convertScorePartsToPdf(writer, notationProject->masterNotation(), out);
     } else if (suffix == PNG_SUFFIX) {
         ret = convertScorePartsToPngs(writer, notationProject->masterNotation(), out);
+    } else if (isConvertScorePartsToAudio(suffix)) {
+        //! NOTE The playback is set up for the current project only
+        globalContext()->setCurrentProject(notationProject);
+        ret = convertScorePartsToAudio(writer, notationProject->masterNotation(), out, otherPartsVolume);
+        globalContext()->setCurrentProject(nullptr);
     } else {
         ret = make_ret(Ret::Code::NotSupported);
     }
@@ -315,6 +369,63 @@ mu::Ret ConverterController::convertScorePartsToPngs(INotationWriterPtr writer,
     return make_ret(Ret::Code::Ok);
 }
 
+bool ConverterController::isConvertScorePartsToAudio(const std::string& suffix) const
+{
+    static const std::set<std::string> SUFFIXES {
+        "mp3", "ogg", "flac", "wav"
+    };
+
+    return SUFFIXES.find(suffix) != SUFFIXES.cend();
+}
+
+mu::Ret ConverterController::convertScorePartsToAudio(INotationWriterPtr writer, IMasterNotationPtr masterNotation,
+                                                      const io::path_t& out, std::optional<double> otherPartsVolume) const
+{
+    TRACEFUNC;
+
+    //! NOTE The score goes to the given file, each part to <name>-<part name>.<suffix>,
+    //!      all of them rendered in one playback of the score
+    INotationPtrList notations;
+    notations.push_back(masterNotation->notation());
+
+    std::vector<io::path_t> paths;
+    paths.push_back(out);
+
+    for (IExcerptNotationPtr e : masterNotation->excerpts()) {
+        notations.push_back(e->notation());
+        paths.push_back(io::dirpath(out) + "/" + io::completeBasename(out) + "-" + io::escapeFileName(e->name()) + "." + io::suffix(out));
+    }
+
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<QIODevice*> devices;
+    for (const io::path_t& path : paths) {
+        auto file = std::make_unique<QFile>(path.toQString());
+        if (!file->open(QFile::WriteOnly)) {
+            return make_ret(Err::OutFileFailedOpen);
+        }
+
+        devices.push_back(file.get());
+        files.push_back(std::move(file));
+    }
+
+    INotationWriter::Options options;
+    if (otherPartsVolume.has_value()) {
+        options[INotationWriter::OptionKey::OTHER_PARTS_VOLUME] = Val(otherPartsVolume.value());
+    }
+
+    Ret ret = writer->writeEach(notations, devices, options);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    for (const std::unique_ptr<QFile>& file : files) {
+        file->close();
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::Ret ConverterController::exportScoreMedia(const mu::io::path_t& in, const mu::io::path_t& out,
                                               const mu::io::path_t& highlightConfigPath,
                                               const io::path_t& stylePath, bool forceMode)
@@ -392,3 +503,124 @@ mu::Ret ConverterController::updateSource(const io::path_t& in, const std::strin
 
     return BackendApi::updateSource(in, newSource, forceMode);
 }
+
+mu::Ret ConverterController::runDaemon()
+{
+    TRACEFUNC;
+
+    //! NOTE stdout carries only the responses, one JSON object per line
+    FILE* responses = takeStdout();
+    if (!responses) {
+        LOGE() << "failed redirect stdout";
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    LOGI() << "converter daemon started, waiting for requests";
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        strings::trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        QByteArray response = processDaemonRequest(QByteArray::fromStdString(line));
+        response.append('\n');
+
+        std::fwrite(response.constData(), 1, response.size(), responses);
+        std::fflush(responses);
+    }
+
+    LOGI() << "converter daemon finished, end of input";
+
+    restoreStdout(responses);
+
+    return make_ret(Ret::Code::Ok);
+}
+
+QByteArray ConverterController::processDaemonRequest(const QByteArray& line)
+{
+    TRACEFUNC;
+
+    QJsonObject response;
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        response["ok"] = false;
+        response["error"] = QString("failed parse request: %1").arg(err.errorString());
+        return QJsonDocument(response).toJson(QJsonDocument::Compact);
+    }
+
+    const QJsonObject request = doc.object();
+    response["id"] = request["id"];
+
+    const QString type = request["type"].toString("convert");
+    const io::path_t in = io::Dir::fromNativeSeparators(request["in"].toString());
+    io::path_t out = io::Dir::fromNativeSeparators(request["out"].toString());
+    const io::path_t stylePath = io::Dir::fromNativeSeparators(request["style"].toString());
+    const bool forceMode = request["force"].toBool();
+
+    //! NOTE The modes that print JSON to stdout without an output file return it in the response instead
+    const bool isJsonResult = type == "score-media" || type == "score-meta" || type == "score-parts-pdf" || type == "score-transpose";
+    const bool isResultInResponse = isJsonResult && out.empty();
+    QTemporaryFile resultFile;
+    if (isResultInResponse) {
+        if (!resultFile.open()) {
+            response["ok"] = false;
+            response["error"] = "failed create a temporary file for the result";
+            return QJsonDocument(response).toJson(QJsonDocument::Compact);
+        }
+        resultFile.close();
+        out = resultFile.fileName();
+    }
+
+    Ret ret;
+    if (in.empty()) {
+        ret = make_ret(Err::InFileFailedLoad, "no input file");
+    } else if (type == "convert") {
+        ret = fileConvert(in, out, stylePath, forceMode, request["soundProfile"].toString());
+    } else if (type == "score-parts") {
+        ret = convertScoreParts(in, out, stylePath, forceMode);
+    } else if (type == "score-media") {
+        ret = exportScoreMedia(in, out, io::Dir::fromNativeSeparators(request["highlightConfig"].toString()), stylePath, forceMode);
+    } else if (type == "score-meta") {
+        ret = exportScoreMeta(in, out, stylePath, forceMode);
+    } else if (type == "score-parts-pdf") {
+        ret = exportScorePartsPdfs(in, out, stylePath, forceMode);
+    } else if (type == "score-transpose") {
+        const QJsonValue options = request["options"];
+        const QByteArray optionsJson = options.isObject()
+                                       ? QJsonDocument(options.toObject()).toJson(QJsonDocument::Compact)
+                                       : options.toString().toUtf8();
+        ret = exportScoreTranspose(in, out, optionsJson.toStdString(), stylePath, forceMode);
+    } else if (type == "source-update") {
+        ret = updateSource(in, request["source"].toString().toStdString(), forceMode);
+    } else {
+        ret = make_ret(Err::ConvertTypeUnknown, "unknown request type: " + type.toStdString());
+    }
+
+    response["ok"] = ret.success();
+    if (!ret) {
+        response["error"] = QString::fromStdString(ret.toString());
+    } else if (isResultInResponse) {
+        QFile result(resultFile.fileName());
+        if (!result.open(QFile::ReadOnly)) {
+            response["ok"] = false;
+            response["error"] = "failed read the result";
+            return QJsonDocument(response).toJson(QJsonDocument::Compact);
+        }
+
+        QJsonParseError resultErr;
+        QJsonDocument resultDoc = QJsonDocument::fromJson(result.readAll(), &resultErr);
+        if (resultErr.error != QJsonParseError::NoError || resultDoc.isNull()) {
+            response["ok"] = false;
+            response["error"] = QString("failed parse the result: %1").arg(resultErr.errorString());
+            return QJsonDocument(response).toJson(QJsonDocument::Compact);
+        }
+
+        response["result"] = resultDoc.isArray() ? QJsonValue(resultDoc.array()) : QJsonValue(resultDoc.object());
+    }
+
+    return QJsonDocument(response).toJson(QJsonDocument::Compact);
+}
@@ -24,6 +24,8 @@
 
 #include <list>
 
+#include <QByteArray>
+
 #include "../iconvertercontroller.h"
 
 #include "modularity/ioc.h"
@@ -51,7 +53,7 @@ public:
                      const io::path_t& stylePath = io::path_t(), bool forceMode = false, const String& soundProfile = String()) override;
 
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
-                          bool forceMode = false) override;
+                          bool forceMode = false, std::optional<double> otherPartsVolume = std::nullopt) override;
 
     Ret exportScoreMedia(const io::path_t& in, const io::path_t& out,
                          const io::path_t& highlightConfigPath = io::path_t(), const io::path_t& stylePath = io::path_t(),
@@ -69,6 +71,8 @@ public:
 
     Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) override;
 
+    Ret runDaemon() override;
+
 private:
 
     struct Job {
@@ -80,6 +84,8 @@ private:
 
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
 
+    QByteArray processDaemonRequest(const QByteArray& line);
+
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
     Ret convertFullNotation(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
@@ -88,6 +94,9 @@ private:
                                const io::path_t& out) const;
     Ret convertScorePartsToPngs(project::INotationWriterPtr writer, notation::IMasterNotationPtr masterNotation,
                                 const io::path_t& out) const;
+    bool isConvertScorePartsToAudio(const std::string& suffix) const;
+    Ret convertScorePartsToAudio(project::INotationWriterPtr writer, notation::IMasterNotationPtr masterNotation,
+                                 const io::path_t& out, std::optional<double> otherPartsVolume) const;
 };
 }
 
@@ -62,6 +62,7 @@ void WriteScoreHook::onWriteExcerpts302(Score* score, XmlWriter& xml, WriteConte
 
     if (isWriteExcerpts && score->isMaster() && !selectionOnly) {
         MasterScore* mScore = static_cast<MasterScore*>(score);
+        mScore->loadLazyExcerpts();
         for (const Excerpt* excerpt : mScore->excerpts()) {
             if (excerpt->excerptScore() != score) {
                 write::Writer::write(excerpt->excerptScore(), xml, ctx, selectionOnly, *this);         // recursion write
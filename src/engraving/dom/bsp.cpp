@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "bsp.h"
@@ -38,7 +39,7 @@ class InsertItemBspTreeVisitor : public BspTreeVisitor
 public:
     EngravingItem* item;
 
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
+    inline void visit(std::vector<EngravingItem*>* items) { items->push_back(item); }
 };
 
 //---------------------------------------------------------
@@ -51,7 +52,16 @@ class RemoveItemBspTreeVisitor : public BspTreeVisitor
 public:
     EngravingItem* item;
 
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
+    //! NOTE Removes a single occurrence: an item inserted twice
+    //! is also removed twice
+    inline void visit(std::vector<EngravingItem*>* items)
+    {
+        auto it = std::find(items->begin(), items->end(), item);
+        if (it != items->end()) {
+            *it = items->back();
+            items->pop_back();
+        }
+    }
 };
 
 //---------------------------------------------------------
@@ -62,15 +72,14 @@ class FindItemBspTreeVisitor : public BspTreeVisitor
 {
     OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
 public:
-    std::list<EngravingItem*> foundItems;
+    std::vector<EngravingItem*> foundItems;
 
-    void visit(std::list<EngravingItem*>* items)
+    void visit(std::vector<EngravingItem*>* items)
     {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
+        for (EngravingItem* item : *items) {
             if (!item->itemDiscovered) {
                 item->itemDiscovered = true;
-                foundItems.push_front(item);
+                foundItems.push_back(item);
             }
         }
     }
@@ -107,7 +116,9 @@ void BspTree::initialize(const RectF& rec, int n)
 
     m_nodes.resize((1 << (m_depth + 1)) - 1);
     m_leaves.resize(1LL << m_depth);
-    std::fill(m_leaves.begin(), m_leaves.end(), std::list<EngravingItem*>());
+    for (std::vector<EngravingItem*>& leaf : m_leaves) {
+        leaf.clear(); // keeps the allocated storage for the next rebuild
+    }
     initialize(rec, m_depth, 0);
 }
 
@@ -127,10 +138,15 @@ void BspTree::clear()
 //---------------------------------------------------------
 
 void BspTree::insert(EngravingItem* element)
+{
+    insert(element, element->pageBoundingRect());
+}
+
+void BspTree::insert(EngravingItem* element, const RectF& rect)
 {
     InsertItemBspTreeVisitor insertVisitor;
     insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    climbTree(&insertVisitor, rect);
 }
 
 //---------------------------------------------------------
@@ -138,10 +154,15 @@ void BspTree::insert(EngravingItem* element)
 //---------------------------------------------------------
 
 void BspTree::remove(EngravingItem* element)
+{
+    remove(element, element->pageBoundingRect());
+}
+
+void BspTree::remove(EngravingItem* element, const RectF& rect)
 {
     RemoveItemBspTreeVisitor removeVisitor;
     removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    climbTree(&removeVisitor, rect);
 }
 
 //---------------------------------------------------------
@@ -23,7 +23,7 @@
 #ifndef MU_ENGRAVING_BSP_H
 #define MU_ENGRAVING_BSP_H
 
-#include <list>
+#include <vector>
 
 #include "global/allocator.h"
 #include "types/string.h"
@@ -61,13 +61,11 @@ private:
     void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
     void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
 
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
     mu::RectF rectForIndex(int index) const;
 
     unsigned int m_depth = 0;
     std::vector<Node> m_nodes;
-    std::vector<std::list<EngravingItem*> > m_leaves;
+    std::vector<std::vector<EngravingItem*> > m_leaves;
     int m_leafCnt = 0;
     mu::RectF m_rect;
 
@@ -79,6 +77,10 @@ public:
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
+    // rect is the page bounding rect the item had (or has) in the tree;
+    // remove() never dereferences the item, so it can be used for deleted ones
+    void insert(EngravingItem* item, const mu::RectF& rect);
+    void remove(EngravingItem* item, const mu::RectF& rect);
 
     std::vector<EngravingItem*> items(const mu::RectF& rect);
     std::vector<EngravingItem*> items(const mu::PointF& pos);
@@ -105,7 +107,7 @@ class BspTreeVisitor
     OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
 public:
     virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
+    virtual void visit(std::vector<EngravingItem*>* items) = 0;
 };
 } // namespace mu::engraving
 #endif
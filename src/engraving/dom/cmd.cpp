@@ -280,6 +280,14 @@ void Score::startCmd()
 
     MScore::setError(MsError::MS_NO_ERROR);
 
+    // Edits of the master score are propagated to the excerpts,
+    // and they invalidate the links lazy excerpts would be read with.
+    // The excerpts are read while the application is idle after the
+    // score is opened, only the ones not read yet are read here
+    if (masterScore()->hasLazyExcerpts()) {
+        masterScore()->loadLazyExcerpts();
+    }
+
     cmdState().reset();
 
     // Start collecting low-level undo operations for a
@@ -1641,9 +1641,7 @@ RectF EngravingItem::symBbox(const SymIdList& symbols) const
 Shape EngravingItem::symShapeWithCutouts(SymId id) const
 {
     Shape shape = score()->engravingFont()->shapeWithCutouts(id, magS());
-    for (ShapeElement& element : shape.elements()) {
-        element.setItem(this);
-    }
+    shape.setItem(this);
 
     return shape;
 }
@@ -2328,9 +2326,39 @@ bool EngravingItem::selected() const
 
 void EngravingItem::setSelected(bool f)
 {
+    if (selected() != f) {
+        invalidateAppearance();
+    }
     setFlag(ElementFlag::SELECTED, f);
 }
 
+//---------------------------------------------------------
+//   setDropTarget
+//---------------------------------------------------------
+
+void EngravingItem::setDropTarget(bool v) const
+{
+    if (flag(ElementFlag::DROP_TARGET) != v) {
+        invalidateAppearance();
+    }
+    setFlag(ElementFlag::DROP_TARGET, v);
+}
+
+//---------------------------------------------------------
+//   invalidateAppearance
+//    the item will be drawn differently, although
+//    its layout didn't change
+//---------------------------------------------------------
+
+void EngravingItem::invalidateAppearance() const
+{
+    if (const EngravingItem* system = findAncestor(ElementType::SYSTEM)) {
+        toSystem(system)->invalidateAppearance();
+    } else if (score()) {
+        score()->invalidateAppearance();
+    }
+}
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
 void EngravingItem::initAccessibleIfNeed()
 {
@@ -424,7 +424,7 @@ public:
     void setSelectable(bool val) { setFlag(ElementFlag::NOT_SELECTABLE, !val); }
 
     bool dropTarget() const { return flag(ElementFlag::DROP_TARGET); }
-    void setDropTarget(bool v) const { setFlag(ElementFlag::DROP_TARGET, v); }
+    void setDropTarget(bool v) const;
 
     bool composition() const { return flag(ElementFlag::COMPOSITION); }
     void setComposition(bool v) const { setFlag(ElementFlag::COMPOSITION, v); }
@@ -672,6 +672,8 @@ private:
 
     friend class Factory;
 
+    void invalidateAppearance() const;
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     void doInitAccessible();
     AccessibleItemPtr m_accessible;
@@ -125,6 +125,29 @@ void Excerpt::setExcerptScore(Score* s)
     }
 }
 
+void Excerpt::setLazyData(const ByteArray& styleData, const ByteArray& scoreData, bool ignoreVersionError)
+{
+    //! NOTE: the parts are known, they were found by scanning the data
+    m_inited = true;
+    m_lazy = true;
+    m_lazyStyleData = styleData;
+    m_lazyScoreData = scoreData;
+    m_lazyIgnoreVersionError = ignoreVersionError;
+}
+
+void Excerpt::clearLazyData()
+{
+    m_lazy = false;
+    m_lazyStyleData = ByteArray();
+    m_lazyScoreData = ByteArray();
+    m_lazyIgnoreVersionError = false;
+}
+
+async::Notification Excerpt::scoreLoaded() const
+{
+    return m_scoreLoaded;
+}
+
 const String& Excerpt::name() const
 {
     return m_name;
@@ -555,6 +578,7 @@ void MasterScore::initAndAddExcerpt(Excerpt* excerpt, bool fakeUndo)
 void MasterScore::initExcerpt(Excerpt* excerpt)
 {
     if (excerpt->inited()) {
+        loadLazyExcerpt(excerpt);
         excerpt->excerptScore()->doLayout();
         return;
     }
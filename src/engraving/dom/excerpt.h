@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_EXCERPT_H
 #define MU_ENGRAVING_EXCERPT_H
 
+#include "types/bytearray.h"
 #include "types/fraction.h"
 #include "types/types.h"
 #include "types/string.h"
@@ -56,6 +57,15 @@ public:
     Score* excerptScore() const { return m_excerptScore; }
     void setExcerptScore(Score* s);
 
+    //! NOTE A lazy excerpt is known only by its name and parts, its score is
+    //! read from the kept file data on first access (see MasterScore::loadLazyExcerpt)
+    bool isLazy() const { return m_lazy; }
+    void setLazyData(const ByteArray& styleData, const ByteArray& scoreData, bool ignoreVersionError);
+    const ByteArray& lazyStyleData() const { return m_lazyStyleData; }
+    const ByteArray& lazyScoreData() const { return m_lazyScoreData; }
+    bool lazyIgnoreVersionError() const { return m_lazyIgnoreVersionError; }
+    async::Notification scoreLoaded() const;
+
     const String& name() const;
     void setName(const String& name, bool saveAndNotify = true);
     async::Notification nameChanged() const;
@@ -97,6 +107,7 @@ private:
     friend class MasterScore;
 
     void setInited(bool inited);
+    void clearLazyData();
     void writeNameToMetaTags();
 
     void updateTracksMapping();
@@ -110,6 +121,12 @@ private:
     TracksMap m_tracksMapping;
     bool m_inited = false;
     ID m_initialPartId;
+
+    bool m_lazy = false;
+    ByteArray m_lazyStyleData;
+    ByteArray m_lazyScoreData;
+    bool m_lazyIgnoreVersionError = false;     // as the master score was read
+    async::Notification m_scoreLoaded;
 };
 }
 
@@ -26,6 +26,7 @@
 #include "compat/writescorehook.h"
 #include "infrastructure/mscwriter.h"
 
+#include "rw/inoutdata.h"
 #include "rw/mscloader.h"
 #include "rw/xmlreader.h"
 #include "rw/rwregister.h"
@@ -247,6 +248,90 @@ void MasterScore::removeExcerpt(Excerpt* ex)
     }
 }
 
+//---------------------------------------------------------
+//   hasLazyExcerpts
+//---------------------------------------------------------
+
+bool MasterScore::hasLazyExcerpts() const
+{
+    return m_lazyExcerptsLinks != nullptr;
+}
+
+//---------------------------------------------------------
+//   loadLazyExcerpt
+//    read the score of an excerpt that was kept as file data
+//    when the master score was loaded. The links of the master
+//    score are the ones collected while reading it, so this must
+//    happen before the master score is edited
+//---------------------------------------------------------
+
+Ret MasterScore::loadLazyExcerpt(Excerpt* ex)
+{
+    if (!ex->isLazy()) {
+        return make_ok();
+    }
+
+    IF_ASSERT_FAILED(m_lazyExcerptsLinks) {
+        ex->clearLazyData();
+        return make_ret(Err::FileUnknownError);
+    }
+
+    TRACEFUNC;
+
+    Ret ret = MscLoader().readLazyExcerpt(this, ex, *m_lazyExcerptsLinks);
+    ex->clearLazyData();
+
+    //! NOTE: parts were found by scanning the file, now take them from the score
+    ex->parts().clear();
+    initParts(ex);
+
+    ex->excerptScore()->setPlaylistDirty();
+    ex->excerptScore()->setLayoutAll();
+    ex->m_scoreLoaded.notify();
+
+    return ret;
+}
+
+//---------------------------------------------------------
+//   loadNextLazyExcerpt
+//    read the first excerpt that is still lazy, so that they
+//    can be read one by one while the application is idle.
+//    Returns false when there are none left
+//---------------------------------------------------------
+
+bool MasterScore::loadNextLazyExcerpt()
+{
+    if (!m_lazyExcerptsLinks) {
+        return false;
+    }
+
+    for (Excerpt* ex : m_excerpts) {
+        if (!ex->isLazy()) {
+            continue;
+        }
+
+        Ret ret = loadLazyExcerpt(ex);
+        if (!ret) {
+            LOGE() << "failed to read excerpt " << ex->fileName() << ": " << ret.toString();
+        }
+
+        return true;
+    }
+
+    m_lazyExcerptsLinks.reset();
+    return false;
+}
+
+//---------------------------------------------------------
+//   loadLazyExcerpts
+//---------------------------------------------------------
+
+void MasterScore::loadLazyExcerpts()
+{
+    while (loadNextLazyExcerpt()) {
+    }
+}
+
 //---------------------------------------------------------
 //   clone
 //---------------------------------------------------------
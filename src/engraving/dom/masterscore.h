@@ -40,6 +40,10 @@ class ScoreAccess;
 class ReadStyleHook;
 }
 
+namespace mu::engraving::rw {
+struct ReadLinks;
+}
+
 namespace mu::engraving {
 class Excerpt;
 class MasterScore;
@@ -165,6 +169,11 @@ public:
     void initExcerpt(Excerpt*);
     void initEmptyExcerpt(Excerpt*);
 
+    bool hasLazyExcerpts() const;
+    Ret loadLazyExcerpt(Excerpt*);
+    bool loadNextLazyExcerpt();
+    void loadLazyExcerpts();
+
     void setPlaybackScore(Score*);
     Score* playbackScore() { return m_playbackScore; }
     const Score* playbackScore() const { return m_playbackScore; }
@@ -199,6 +208,7 @@ private:
     int updateMidiMapping();
 
     friend class EngravingProject;
+    friend class MscLoader;
     friend class compat::ScoreAccess;
     friend class read114::Read114;
     friend class read400::Read400;
@@ -217,6 +227,7 @@ private:
     bool m_expandRepeats = true;
     bool m_playlistDirty = true;
     std::vector<Excerpt*> m_excerpts;
+    std::shared_ptr<rw::ReadLinks> m_lazyExcerptsLinks;   // links of the master score as read, for lazy excerpts
     std::vector<PartChannelSettingsLink> m_playbackSettingsLinks;
     Score* m_playbackScore = nullptr;
     async::Channel<ScoreChangesRange> m_changesRangeChannel;
@@ -2765,6 +2765,23 @@ void Measure::undoChangeProperty(Pid id, const PropertyValue& v, PropertyFlags p
     EngravingObject::undoChangeProperty(id, v, ps);
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//    the multimeasure rest replaces this measure in the
+//    nextMeasureMM() chain, the tick index must see it
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest == m) {
+        return;
+    }
+    m_mmRest = m;
+    if (score()) {
+        score()->measures()->invalidateTickIndex();
+    }
+}
+
 //-------------------------------------------------------------------
 //   mmRestFirst
 //    this is a multi measure rest
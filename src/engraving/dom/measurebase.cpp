@@ -22,6 +22,8 @@
 
 #include "measurebase.h"
 
+#include <algorithm>
+
 #include "factory.h"
 #include "layoutbreak.h"
 #include "measure.h"
@@ -337,7 +339,13 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
+    if (m_tick == f) {
+        return;
+    }
     m_tick = f;
+    if (score()) {
+        score()->measures()->invalidateTickIndex();
+    }
 }
 
 //---------------------------------------------------------
@@ -683,6 +691,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++m_size;
     if (m_last) {
         m_last->setNext(e);
@@ -702,6 +711,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++m_size;
     if (m_first) {
         m_first->setPrev(e);
@@ -732,6 +742,7 @@ void MeasureBaseList::add(MeasureBase* e)
         return;
     }
     ++m_size;
+    invalidateTickIndex();
     e->setPrev(el->prev());
     el->prev()->setNext(e);
     el->setPrev(e);
@@ -743,6 +754,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    invalidateTickIndex();
     --m_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -762,6 +774,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     ++m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++m_size;
@@ -786,6 +799,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     --m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --m_size;
@@ -810,6 +824,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    invalidateTickIndex();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -832,3 +847,110 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
         e->setParent(nb);
     }
 }
+
+//---------------------------------------------------------
+//   firstMeasure
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::firstMeasure(bool mm, bool createMMRests) const
+{
+    MeasureBase* mb = m_first;
+    while (mb && !mb->isMeasure()) {
+        mb = mb->next();
+    }
+    Measure* m = toMeasure(mb);
+    if (mm && m && createMMRests && m->hasMMRest()) {
+        return m->mmRest();
+    }
+    return m;
+}
+
+//---------------------------------------------------------
+//   rebuildTickIndex
+//    if mm is set, the index holds the measures as seen when
+//    walking with nextMeasureMM(), i.e. with multimeasure
+//    rests replacing the measures they cover
+//---------------------------------------------------------
+
+void MeasureBaseList::rebuildTickIndex(TickIndex& index, bool mm, bool createMMRests) const
+{
+    index.measures.clear();
+    index.measures.reserve(m_size);
+
+    for (Measure* m = firstMeasure(mm, createMMRests); m; m = mm ? m->nextMeasureMM() : m->nextMeasure()) {
+        index.measures.push_back(m);
+    }
+
+    index.ordered = true;
+    for (size_t i = 1; i < index.measures.size(); ++i) {
+        if (!(index.measures[i - 1]->tick() < index.measures[i]->tick())) {
+            index.ordered = false;
+            break;
+        }
+    }
+    index.createMMRests = createMMRests;
+    index.valid = true;
+}
+
+//---------------------------------------------------------
+//   lookupTickIndex
+//---------------------------------------------------------
+
+bool MeasureBaseList::lookupTickIndex(TickIndex& index, const Fraction& tick, bool mm, bool createMMRests, Measure*& measure) const
+{
+    auto next = [mm](const Measure* m) { return mm ? m->nextMeasureMM() : m->nextMeasure(); };
+
+    // The index is invalidated by list changes and measure tick changes, but
+    // the multimeasure rest chain may be relinked behind our back during layout.
+    // Check the neighbours of the found entry, which is cheap, and rebuild the
+    // index once if they don't match the linked list anymore.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!index.valid || index.createMMRests != createMMRests) {
+            rebuildTickIndex(index, mm, createMMRests);
+        }
+        if (!index.ordered) {
+            return false;
+        }
+
+        const std::vector<Measure*>& measures = index.measures;
+        auto it = std::upper_bound(measures.cbegin(), measures.cend(), tick, [](const Fraction& t, const Measure* m) {
+            return t < m->tick();
+        });
+        if (it == measures.cbegin()) {
+            measure = nullptr;
+            return true;
+        }
+
+        size_t idx = std::distance(measures.cbegin(), it) - 1;
+        Measure* m = measures[idx];
+        Measure* expectedPrev = idx > 0 ? measures[idx - 1] : nullptr;
+        Measure* expectedNext = idx + 1 < measures.size() ? measures[idx + 1] : nullptr;
+        bool prevOk = expectedPrev ? next(expectedPrev) == m : firstMeasure(mm, createMMRests) == m;
+        if (prevOk && next(m) == expectedNext) {
+            measure = m;
+            return true;
+        }
+
+        index.valid = false;
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------
+//   measureAtTick
+//---------------------------------------------------------
+
+bool MeasureBaseList::measureAtTick(const Fraction& tick, Measure*& measure) const
+{
+    return lookupTickIndex(m_tickIndex, tick, false, false, measure);
+}
+
+//---------------------------------------------------------
+//   measureAtTickMM
+//---------------------------------------------------------
+
+bool MeasureBaseList::measureAtTickMM(const Fraction& tick, bool createMMRests, Measure*& measure) const
+{
+    return lookupTickIndex(m_tickIndexMM, tick, true, createMMRests, measure);
+}
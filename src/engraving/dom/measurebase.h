@@ -210,7 +210,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return m_first; }
     MeasureBase* last()  const { return m_last; }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear() { m_first = m_last = 0; m_size = 0; invalidateTickIndex(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -219,13 +219,35 @@ public:
     int size() const { return m_size; }
     bool empty() const { return m_size == 0; }
 
+    // Binary search for the last measure starting at or before tick, using a
+    // tick-ordered index which is rebuilt lazily after the list or a measure tick
+    // has changed. Returns false if the index can't be used (measure ticks not in
+    // ascending order, e.g. in the middle of an edit); the caller must then walk the list.
+    bool measureAtTick(const Fraction& tick, Measure*& measure) const;
+    bool measureAtTickMM(const Fraction& tick, bool createMMRests, Measure*& measure) const;
+    void invalidateTickIndex() const { m_tickIndex.valid = false; m_tickIndexMM.valid = false; }
+
 private:
+    struct TickIndex {
+        std::vector<Measure*> measures;
+        bool valid = false;
+        bool ordered = false;
+        bool createMMRests = false;
+    };
+
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
 
+    Measure* firstMeasure(bool mm, bool createMMRests) const;
+    void rebuildTickIndex(TickIndex& index, bool mm, bool createMMRests) const;
+    bool lookupTickIndex(TickIndex& index, const Fraction& tick, bool mm, bool createMMRests, Measure*& measure) const;
+
     int m_size = 0;
     MeasureBase* m_first = nullptr;
     MeasureBase* m_last = nullptr;
+
+    mutable TickIndex m_tickIndex;
+    mutable TickIndex m_tickIndexMM;
 };
 } // namespace mu::engraving
 #endif
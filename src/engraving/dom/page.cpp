@@ -22,6 +22,8 @@
 
 #include "page.h"
 
+#include <algorithm>
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
 #include "accessibility/accessibleitem.h"
 #endif
@@ -51,7 +53,6 @@ static String revision;
 Page::Page(RootItem* parent)
     : EngravingItem(ElementType::PAGE, parent, ElementFlag::NOT_SELECTABLE), m_no(0)
 {
-    m_bspTreeValid = false;
 }
 
 //---------------------------------------------------------
@@ -60,20 +61,27 @@ Page::Page(RootItem* parent)
 
 std::vector<EngravingItem*> Page::items(const RectF& rect)
 {
-    if (!m_bspTreeValid) {
-        doRebuildBspTree();
-    }
+    doUpdateBspTree();
     return bspTree.items(rect);
 }
 
 std::vector<EngravingItem*> Page::items(const mu::PointF& point)
 {
-    if (!m_bspTreeValid) {
-        doRebuildBspTree();
-    }
+    doUpdateBspTree();
     return bspTree.items(point);
 }
 
+//---------------------------------------------------------
+//   invalidateBspTreeSystems
+//---------------------------------------------------------
+
+void Page::invalidateBspTreeSystems()
+{
+    if (m_bspTreeState == BspTreeState::Valid) {
+        m_bspTreeState = BspTreeState::SystemsChanged;
+    }
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -248,12 +256,12 @@ void Page::scanElements(void* data, void (* func)(void*, EngravingItem*), bool a
 }
 
 //---------------------------------------------------------
-//   bspInsert
+//   bspCollect
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, EngravingItem* e)
+static void bspCollect(void* data, EngravingItem* e)
 {
-    ((BspTree*)bspTree)->insert(e);
+    static_cast<std::vector<std::pair<EngravingItem*, RectF> >*>(data)->emplace_back(e, e->pageBoundingRect());
 }
 
 static void countElements(void* data, EngravingItem* /*e*/)
@@ -262,15 +270,11 @@ static void countElements(void* data, EngravingItem* /*e*/)
 }
 
 //---------------------------------------------------------
-//   doRebuildBspTree
+//   bspTreeRect
 //---------------------------------------------------------
 
-void Page::doRebuildBspTree()
+RectF Page::bspTreeRect() const
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
-
-    RectF r;
     if (score()->linearMode()) {
         double w = 0.0;
         double h = 0.0;
@@ -281,14 +285,158 @@ void Page::doRebuildBspTree()
                 w = mb->x() + mb->width();
             }
         }
-        r = RectF(0.0, 0.0, w, h);
-    } else {
-        r = abbox();
+        return RectF(0.0, 0.0, w, h);
+    }
+    return abbox();
+}
+
+//---------------------------------------------------------
+//   bspInsertSystem
+//    same elements as scanElements() visits for the system
+//---------------------------------------------------------
+
+void Page::bspInsertSystem(System* system)
+{
+    BspSystemEntry& entry = m_bspSystems[system];
+    entry.layoutId = system->layoutId();
+    entry.pos = system->pagePos();
+    entry.bbox = system->ldata()->bbox();
+    entry.staffY.clear();
+    for (const SysStaff* staff : system->staves()) {
+        entry.staffY.push_back(staff->show() ? staff->y() : -1.0);
+    }
+
+    entry.items.clear();
+    for (MeasureBase* m : system->measures()) {
+        m->scanElements(&entry.items, bspCollect, false);
+    }
+    system->scanElements(&entry.items, bspCollect, false);
+
+    for (const auto& item : entry.items) {
+        bspTree.insert(item.first, item.second);
+    }
+    m_bspTreeItemCount += entry.items.size();
+}
+
+//---------------------------------------------------------
+//   bspRemoveSystem
+//    doesn't touch the elements, they may be gone already
+//---------------------------------------------------------
+
+void Page::bspRemoveSystem(const System* system)
+{
+    auto it = m_bspSystems.find(system);
+    if (it == m_bspSystems.end()) {
+        return;
+    }
+    for (const auto& item : it->second.items) {
+        bspTree.remove(item.first, item.second);
+    }
+    m_bspTreeItemCount -= it->second.items.size();
+    m_bspSystems.erase(it);
+}
+
+//---------------------------------------------------------
+//   doRebuildBspTree
+//---------------------------------------------------------
+
+void Page::doRebuildBspTree()
+{
+    int n = 0;
+    scanElements(&n, countElements, false);
+
+    m_bspTreeRect = bspTreeRect();
+    m_bspTreeCapacity = static_cast<size_t>(n);
+    m_bspTreeItemCount = 0;
+    m_bspSystems.clear();
+    m_bspUpdatedSystems.assign(m_systems.begin(), m_systems.end());
+
+    bspTree.initialize(m_bspTreeRect, n);
+    for (System* system : m_systems) {
+        bspInsertSystem(system);
+    }
+    m_bspPageRect = pageBoundingRect();
+    bspTree.insert(this, m_bspPageRect);
+    m_bspTreeState = BspTreeState::Valid;
+}
+
+//---------------------------------------------------------
+//   bspSystemChanged
+//---------------------------------------------------------
+
+static bool bspSystemChanged(const System* system, uint64_t layoutId, const PointF& pos, const RectF& bbox,
+                             const std::vector<double>& staffY)
+{
+    if (layoutId != system->layoutId() || pos != system->pagePos() || bbox != system->ldata()->bbox()
+        || staffY.size() != system->staves().size()) {
+        return true;
+    }
+    for (size_t i = 0; i < staffY.size(); ++i) {
+        const SysStaff* staff = system->staves().at(i);
+        if (staffY.at(i) != (staff->show() ? staff->y() : -1.0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   doUpdateBspTree
+//    After a partial relayout, replaces only the elements of
+//    systems that were laid out again, moved or left the page.
+//    Falls back to a full rebuild when the page itself has
+//    changed or the tree has grown too deep for its items.
+//---------------------------------------------------------
+
+void Page::doUpdateBspTree()
+{
+    if (m_bspTreeState == BspTreeState::Valid) {
+        return;
+    }
+    if (m_bspTreeState == BspTreeState::Invalid || bspTreeRect() != m_bspTreeRect) {
+        doRebuildBspTree();
+        return;
+    }
+
+    std::vector<System*> changed;
+    for (System* system : m_systems) {
+        auto it = m_bspSystems.find(system);
+        if (it == m_bspSystems.end()
+            || bspSystemChanged(system, it->second.layoutId, it->second.pos, it->second.bbox, it->second.staffY)) {
+            changed.push_back(system);
+        }
+    }
+    if (changed.size() == m_systems.size()) {
+        // nothing to keep
+        doRebuildBspTree();
+        return;
+    }
+
+    std::vector<const System*> gone;
+    for (const auto& entry : m_bspSystems) {
+        if (std::find(m_systems.begin(), m_systems.end(), entry.first) == m_systems.end()) {
+            gone.push_back(entry.first);
+        }
+    }
+    for (const System* system : gone) {
+        bspRemoveSystem(system);
+    }
+    for (System* system : changed) {
+        bspRemoveSystem(system);
+        bspInsertSystem(system);
+    }
+    m_bspUpdatedSystems.assign(changed.begin(), changed.end());
+
+    bspTree.remove(this, m_bspPageRect);
+    m_bspPageRect = pageBoundingRect();
+    bspTree.insert(this, m_bspPageRect);
+
+    if (m_bspTreeItemCount > 2 * m_bspTreeCapacity) {
+        doRebuildBspTree();
+        return;
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
-    m_bspTreeValid = true;
+    m_bspTreeState = BspTreeState::Valid;
 }
 
 //---------------------------------------------------------
@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_PAGE_H
 #define MU_ENGRAVING_PAGE_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "engravingitem.h"
@@ -75,7 +76,10 @@ public:
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
-    void invalidateBspTree() { m_bspTreeValid = false; }
+    void invalidateBspTree() { m_bspTreeState = BspTreeState::Invalid; }
+    void invalidateBspTreeSystems();        // only systems laid out again need to be updated
+    //! NOTE The systems put into the tree again by its last update, all of them after a rebuild
+    const std::vector<const System*>& bspTreeUpdatedSystems() const { return m_bspUpdatedSystems; }
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox() const;                             // tight bounding box, excluding white space
@@ -93,13 +97,40 @@ private:
     Page(RootItem* parent);
 
     void doRebuildBspTree();
+    void doUpdateBspTree();
+    mu::RectF bspTreeRect() const;
+    void bspInsertSystem(System* system);
+    void bspRemoveSystem(const System* system);
     String replaceTextMacros(const String&) const;
 
     std::vector<System*> m_systems;
     page_idx_t m_no = 0;                        // page number
 
+    enum class BspTreeState {
+        Valid,
+        SystemsChanged,
+        Invalid
+    };
+
+    //! NOTE What the tree holds for each system, so that after a partial
+    //! relayout only the systems that have moved or were laid out again
+    //! need to be taken out of the tree and put back in
+    struct BspSystemEntry {
+        uint64_t layoutId = 0;
+        mu::PointF pos;
+        mu::RectF bbox;
+        std::vector<double> staffY;
+        std::vector<std::pair<EngravingItem*, mu::RectF> > items;
+    };
+
     BspTree bspTree;
-    bool m_bspTreeValid = false;
+    BspTreeState m_bspTreeState = BspTreeState::Invalid;
+    mu::RectF m_bspTreeRect;
+    mu::RectF m_bspPageRect;
+    size_t m_bspTreeCapacity = 0;       // items the tree depth was chosen for
+    size_t m_bspTreeItemCount = 0;
+    std::unordered_map<const System*, BspSystemEntry> m_bspSystems;
+    std::vector<const System*> m_bspUpdatedSystems;
 };
 } // namespace mu::engraving
 #endif
@@ -510,6 +510,27 @@ PropertyValue propertyFromString(P_TYPE type, String)
     return PropertyValue();
 }
 
+//---------------------------------------------------------
+//   propertyWrittenAsString
+//    the properties which propertyToString() gives a string for in mscx,
+//    the others are written as their type
+//---------------------------------------------------------
+
+bool propertyWrittenAsString(Pid id)
+{
+    switch (id) {
+    case Pid::SYSTEM_BRACKET:
+    case Pid::ACCIDENTAL_TYPE:
+    case Pid::OTTAVA_TYPE:
+    case Pid::TREMOLO_TYPE:
+    case Pid::TRILL_TYPE:
+    case Pid::VIBRATO_TYPE:
+        return true;
+    default:
+        return false;
+    }
+}
+
 //---------------------------------------------------------
 //   propertyToString
 //    Originally extracted from XmlWriter
@@ -455,6 +455,7 @@ using PropertyIdSet = std::unordered_set<Pid>;
 
 extern PropertyValue propertyFromString(P_TYPE type, String value);
 extern String propertyToString(Pid, const PropertyValue& value, bool mscx);
+extern bool propertyWrittenAsString(Pid);
 extern P_TYPE propertyType(Pid);
 extern const char* propertyName(Pid);
 extern bool propertyLink(Pid id);
@@ -696,6 +696,7 @@ void Score::dragPosition(const PointF& p, staff_idx_t* rst, Segment** seg, doubl
 void Score::setShowInvisible(bool v)
 {
     m_showInvisible = v;
+    invalidateAppearance();
     // BSP tree does not include elements which are not
     // displayed, so we need to refresh it to get
     // invisible elements displayed or properly hidden.
@@ -709,6 +710,7 @@ void Score::setShowInvisible(bool v)
 void Score::setShowUnprintable(bool v)
 {
     m_showUnprintable = v;
+    invalidateAppearance();
 }
 
 //---------------------------------------------------------
@@ -718,6 +720,7 @@ void Score::setShowUnprintable(bool v)
 void Score::setShowFrames(bool v)
 {
     m_showFrames = v;
+    invalidateAppearance();
 }
 
 //---------------------------------------------------------
@@ -727,6 +730,7 @@ void Score::setShowFrames(bool v)
 void Score::setShowPageborders(bool v)
 {
     m_showPageborders = v;
+    invalidateAppearance();
 }
 
 //---------------------------------------------------------
@@ -736,6 +740,7 @@ void Score::setShowPageborders(bool v)
 void Score::setMarkIrregularMeasures(bool v)
 {
     m_markIrregularMeasures = v;
+    invalidateAppearance();
 }
 
 //---------------------------------------------------------
@@ -5477,6 +5482,7 @@ void Score::rebuildBspTree()
     for (Page* page : pages()) {
         page->invalidateBspTree();
     }
+    invalidateAppearance();
 }
 
 //---------------------------------------------------------
@@ -5633,6 +5639,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 
     renderer()->layoutScore(this, start, end);
+    m_systemStartHints.clear();
 
     if (m_resetAutoplace) {
         m_resetAutoplace = false;
@@ -5645,6 +5652,24 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 }
 
+void Score::setSystemStartHints(std::unordered_set<const MeasureBase*>&& hints)
+{
+    m_systemStartHints = std::move(hints);
+}
+
+bool Score::isSystemStartHint(const MeasureBase* mb) const
+{
+    if (m_systemStartHints.empty()) {
+        return false;
+    }
+
+    if (mb->isMeasure() && toMeasure(mb)->isMMRest()) {
+        mb = toMeasure(mb)->mmRestFirst();
+    }
+
+    return m_systemStartHints.find(mb) != m_systemStartHints.end();
+}
+
 void Score::createPaddingTable()
 {
     m_paddingTable.createTable(style());
@@ -29,6 +29,7 @@
 */
 
 #include <set>
+#include <unordered_set>
 #include <memory>
 #include <optional>
 
@@ -543,6 +544,12 @@ public:
     void setMarkIrregularMeasures(bool v);
     void setShowInstrumentNames(bool v) { m_showInstrumentNames = v; }
 
+    //! NOTE Changes whenever elements may look different without being laid out
+    //! again (display options etc.), so that recorded drawing of unchanged
+    //! systems is not replayed (see rendering/dev/systemdrawcache.cpp)
+    uint64_t appearanceId() const { return m_appearanceId; }
+    void invalidateAppearance() const { ++m_appearanceId; }
+
     void print(mu::draw::Painter* printer, int page);
     ChordRest* getSelectedChordRest() const;
     std::set<ChordRest*> getSelectedChordRests() const;
@@ -771,6 +778,11 @@ public:
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
 
+    //! NOTE The measures which started a system when the score was saved (see EngravingCache),
+    //! used by the first layout only
+    void setSystemStartHints(std::unordered_set<const MeasureBase*>&& hints);
+    bool isSystemStartHint(const MeasureBase* mb) const;
+
     SynthesizerState& synthesizerState() { return m_synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
 
@@ -1062,12 +1074,14 @@ private:
     bool m_showFrames = true;
     bool m_showPageborders = false;
     bool m_markIrregularMeasures = true;
+    mutable uint64_t m_appearanceId = 0;
     bool m_showInstrumentNames = true;
     bool m_printing = false;                // True if we are drawing to a printer
     bool m_savedCapture = false;            // True if we saved an image capture
 
     ScoreOrder m_scoreOrder;                 // used for score ordering
     bool m_resetAutoplace = false;
+    std::unordered_set<const MeasureBase*> m_systemStartHints;
     bool m_resetDefaults = false;
     int m_mscVersion = Constants::MSC_VERSION;     // version of current loading *.msc file
 
@@ -22,8 +22,6 @@
 
 #include "segment.h"
 
-#include <climits>
-
 #include "translation.h"
 
 #include "types/typesconv.h"
@@ -2465,28 +2463,15 @@ double Segment::elementsTopOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine north = staffSystem->skyline().north();
-    int topOffset = INT_MAX;
-    for (SkylineSegment segment: north) {
-        Segment* seg = prev1enabled();
-        if (!seg) {
-            continue;
-        }
-        bool ok = seg->pagePos().x() <= segment.x && segment.x <= pagePos().x();
-        if (!ok) {
-            continue;
-        }
-
-        if (segment.y < topOffset) {
-            topOffset = segment.y;
-        }
+    const Segment* prevSeg = prev1enabled();
+    if (!prevSeg) {
+        return 0;
     }
 
-    if (topOffset == INT_MAX) {
-        topOffset = 0;
-    }
+    const SkylineLine& north = staffSystem->skyline().north();
+    const double topOffset = north.max(prevSeg->pagePos().x(), pagePos().x());
 
-    return topOffset;
+    return north.valid(topOffset) ? int(topOffset) : 0;
 }
 
 double Segment::elementsBottomOffsetFromSkyline(staff_idx_t staffIndex) const
@@ -2498,28 +2483,15 @@ double Segment::elementsBottomOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine south = staffSystem->skyline().south();
-    int bottomOffset = INT_MIN;
-    for (SkylineSegment segment: south) {
-        Segment* seg = prev1enabled();
-        if (!seg) {
-            continue;
-        }
-        bool ok = seg->pagePos().x() <= segment.x && segment.x <= pagePos().x();
-        if (!ok) {
-            continue;
-        }
-
-        if (segment.y > bottomOffset) {
-            bottomOffset = segment.y;
-        }
+    const Segment* prevSeg = prev1enabled();
+    if (!prevSeg) {
+        return staffSystem->bbox().height();
     }
 
-    if (bottomOffset == INT_MIN) {
-        bottomOffset = staffSystem->bbox().height();
-    }
+    const SkylineLine& south = staffSystem->skyline().south();
+    const double bottomOffset = south.max(prevSeg->pagePos().x(), pagePos().x());
 
-    return bottomOffset;
+    return south.valid(bottomOffset) ? int(bottomOffset) : staffSystem->bbox().height();
 }
 
 //------------------------------------------------------
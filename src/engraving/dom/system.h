@@ -189,6 +189,30 @@ public:
     double distance() const { return m_distance; }
     void setDistance(double d) { m_distance = d; }
 
+    // Identifies the current layout of this system; changes whenever the system is laid out again.
+    // Used to reuse results computed from untouched systems during partial relayout.
+    uint64_t layoutId() const { return m_layoutId; }
+    void setLayoutId(uint64_t id) { m_layoutId = id; }
+
+    // Changes when elements of this system look different without being laid out again (e.g. selection).
+    uint64_t appearanceId() const { return m_appearanceId; }
+    void invalidateAppearance() const { ++m_appearanceId; }
+
+    struct MinDistanceCache {
+        uint64_t topLayoutId = 0;           // layoutId() of the system above
+        uint64_t layoutId = 0;              // layoutId() of this system
+        // style and staff settings the distance was computed with
+        double minVerticalDistance = 0.0;
+        double minSystemDistance = 0.0;     // style distance or spread, or the staff's user distance
+        staff_idx_t firstStaff = 0;
+        staff_idx_t lastStaff = 0;
+
+        double distance = 0.0;
+        bool topFixedDownDistance = false;
+    };
+    const MinDistanceCache& minDistanceCache() const { return m_minDistanceCache; }
+    void setMinDistanceCache(const MinDistanceCache& c) const { m_minDistanceCache = c; }
+
     staff_idx_t firstSysStaffOfPart(const Part* part) const;
     staff_idx_t firstVisibleSysStaffOfPart(const Part* part) const;
     staff_idx_t lastSysStaffOfPart(const Part* part) const;
@@ -229,6 +253,10 @@ private:
     mutable bool m_fixedDownDistance = false;
     double m_distance = 0.0;        // temp. variable used during layout
     double m_systemHeight = 0.0;
+
+    uint64_t m_layoutId = 0;
+    mutable uint64_t m_appearanceId = 0;
+    mutable MinDistanceCache m_minDistanceCache;    // distance to the system above
 };
 
 typedef std::vector<System*>::iterator iSystem;
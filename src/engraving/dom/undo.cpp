@@ -2771,6 +2771,8 @@ void ChangeMMRest::flip(EditData*)
     Measure* mmr = m->mmRest();
     m->setMMRest(mmrest);
     mmrest = mmr;
+    // setMMRest() doesn't see a change if the same mmrest is set again after relinking it
+    m->score()->measures()->invalidateTickIndex();
 }
 
 //---------------------------------------------------------
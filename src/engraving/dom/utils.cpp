@@ -72,6 +72,15 @@ Measure* Score::tick2measure(const Fraction& tick) const
     }
 
     Measure* lm = 0;
+    if (m_measures.measureAtTick(tick, lm)) {
+        assert(lm);
+        if (lm && (lm->nextMeasure() || tick <= lm->endTick())) {
+            return lm;
+        }
+        LOGD("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+        return 0;
+    }
+
     for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
         if (tick < m->tick()) {
             assert(lm);
@@ -102,6 +111,13 @@ Measure* Score::tick2measureMM(const Fraction& t) const
     }
 
     Measure* lm = 0;
+    if (m_measures.measureAtTickMM(tick, style().styleB(Sid::createMultiMeasureRests), lm)) {
+        if (lm && (lm->nextMeasureMM() || tick <= lm->endTick())) {
+            return lm;
+        }
+        LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+        return 0;
+    }
 
     for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
         if (tick < m->tick()) {
@@ -124,6 +140,12 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
 {
+    // frames have no duration, so only a measure can contain the tick
+    Measure* m = nullptr;
+    if (m_measures.measureAtTick(tick, m)) {
+        return (m && tick < m->endTick()) ? m : nullptr;
+    }
+
     for (MeasureBase* mb = first(); mb; mb = mb->next()) {
         Fraction st = mb->tick();
         Fraction l  = mb->ticks();
@@ -139,13 +139,13 @@ MasterScore* EngravingProject::masterScore() const
     return m_masterScore;
 }
 
-Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError)
+Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError, bool lazyExcerpts)
 {
     TRACEFUNC;
 
     MScore::setError(MsError::MS_NO_ERROR);
     MscLoader loader;
-    return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
+    return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError, lazyExcerpts);
 }
 
 bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail)
@@ -22,6 +22,8 @@
 #include "mscreader.h"
 
 #include "io/file.h"
+#include "io/mappedfile.h"
+#include "io/buffer.h"
 #include "io/fileinfo.h"
 #include "io/dir.h"
 #include "serialization/zipreader.h"
@@ -145,11 +147,10 @@ String MscReader::mainFileName() const
     return completeBaseName + u".mscx";
 }
 
-ByteArray MscReader::readScoreFile() const
+String MscReader::scoreFileName() const
 {
     String mscxFileName = mainFileName();
-    ByteArray data = fileData(mscxFileName);
-    if (data.empty() && reader()->isContainer()) {
+    if (!fileExists(mscxFileName) && reader()->isContainer()) {
         StringList files = reader()->fileList();
         for (const String& name : files) {
             // mscx file in the root dir
@@ -160,7 +161,17 @@ ByteArray MscReader::readScoreFile() const
         }
     }
 
-    return fileData(mscxFileName);
+    return mscxFileName;
+}
+
+ByteArray MscReader::readScoreFile() const
+{
+    return fileData(scoreFileName());
+}
+
+std::unique_ptr<IODevice> MscReader::openScoreFile() const
+{
+    return reader()->openFile(scoreFileName());
 }
 
 std::vector<String> MscReader::excerptFileNames() const
@@ -200,6 +211,14 @@ ByteArray MscReader::readChordListFile() const
     return fileData(u"chordlist.xml");
 }
 
+ByteArray MscReader::readEngravingCacheFile() const
+{
+    if (!fileExists(u"engravingcache.bin")) {
+        return ByteArray();
+    }
+    return fileData(u"engravingcache.bin");
+}
+
 ByteArray MscReader::readThumbnailFile() const
 {
     return fileData(u"Thumbnails/thumbnail.png");
@@ -246,6 +265,13 @@ ByteArray MscReader::readViewSettingsJsonFile(const io::path_t& pathPrefix) cons
 // Readers
 // =======================================================================
 
+std::unique_ptr<IODevice> MscReader::IReader::openFile(const String& fileName) const
+{
+    auto buf = std::make_unique<Buffer>(fileData(fileName));
+    buf->open(IODevice::ReadOnly);
+    return buf;
+}
+
 MscReader::ZipFileReader::~ZipFileReader()
 {
     delete m_zip;
@@ -263,8 +289,14 @@ Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
             return make_ret(Err::FileNotFound, filePath);
         }
 
-        m_device = new File(filePath);
+        //! NOTE Mapped, so only the parts that are read are loaded,
+        //! if it can't be mapped, it's read through the file system
+        m_device = new MappedFile(filePath);
         m_selfDeviceOwner = true;
+        if (!m_device->open(IODevice::ReadOnly)) {
+            delete m_device;
+            m_device = new File(filePath);
+        }
     }
 
     if (!m_device->isOpen()) {
@@ -344,6 +376,20 @@ ByteArray MscReader::ZipFileReader::fileData(const String& fileName) const
     return data;
 }
 
+std::unique_ptr<IODevice> MscReader::ZipFileReader::openFile(const String& fileName) const
+{
+    IF_ASSERT_FAILED(m_zip) {
+        return nullptr;
+    }
+
+    std::unique_ptr<IODevice> device = m_zip->openFile(fileName.toStdString());
+    if (!device) {
+        LOGE() << "failed open file " << fileName;
+        return IReader::openFile(fileName);
+    }
+    return device;
+}
+
 Ret MscReader::DirReader::open(IODevice* device, const path_t& filePath)
 {
     if (device) {
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_MSCREADER_H
 #define MU_ENGRAVING_MSCREADER_H
 
+#include <memory>
+
 #include "types/ret.h"
 #include "types/string.h"
 #include "io/path.h"
@@ -58,12 +60,15 @@ public:
 
     ByteArray readStyleFile() const;
     ByteArray readScoreFile() const;
+    //! NOTE Reads the score as it is decompressed, without holding all of it in memory
+    std::unique_ptr<io::IODevice> openScoreFile() const;
 
     std::vector<String> excerptFileNames() const;
     ByteArray readExcerptStyleFile(const String& excerptFileName) const;
     ByteArray readExcerptFile(const String& excerptFileName) const;
 
     ByteArray readChordListFile() const;
+    ByteArray readEngravingCacheFile() const;
     ByteArray readThumbnailFile() const;
 
     std::vector<String> imageFileNames() const;
@@ -88,6 +93,7 @@ private:
         virtual StringList fileList() const = 0;
         virtual bool fileExists(const String& fileName) const = 0;
         virtual ByteArray fileData(const String& fileName) const = 0;
+        virtual std::unique_ptr<io::IODevice> openFile(const String& fileName) const;
     };
 
     struct ZipFileReader : public IReader
@@ -100,6 +106,7 @@ private:
         StringList fileList() const override;
         bool fileExists(const String& fileName) const override;
         ByteArray fileData(const String& fileName) const override;
+        std::unique_ptr<io::IODevice> openFile(const String& fileName) const override;
     private:
         io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
@@ -138,6 +145,7 @@ private:
     ByteArray fileData(const String& fileName) const;
 
     String mainFileName() const;
+    String scoreFileName() const;
 
     Params m_params;
     mutable IReader* m_reader = nullptr;
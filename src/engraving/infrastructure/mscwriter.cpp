@@ -99,6 +99,12 @@ bool MscWriter::hasError() const
 
 MscWriter::IWriter* MscWriter::writer() const
 {
+    if (!m_writer && m_params.files) {
+        MemoryWriter* memory = new MemoryWriter();
+        memory->files = m_params.files;
+        m_writer = memory;
+    }
+
     if (!m_writer) {
         switch (m_params.mode) {
         case MscIoMode::Zip:
@@ -177,6 +183,11 @@ void MscWriter::writeChordListFile(const ByteArray& data)
     addFileData(u"chordlist.xml", data);
 }
 
+void MscWriter::writeEngravingCacheFile(const ByteArray& data)
+{
+    addFileData(u"engravingcache.bin", data);
+}
+
 void MscWriter::writeThumbnailFile(const ByteArray& data)
 {
     addFileData(u"Thumbnails/thumbnail.png", data);
@@ -202,6 +213,20 @@ void MscWriter::writeViewSettingsJsonFile(const ByteArray& data, const io::path_
     addFileData(pathPrefix.toString() + u"viewsettings.json", data);
 }
 
+void MscWriter::addFiles(const Files& files)
+{
+    static const String CONTAINER_FILE(u"META-INF/container.xml");
+
+    for (const auto& file : files) {
+        // written again on close, from the files added
+        if (file.first == CONTAINER_FILE) {
+            continue;
+        }
+
+        addFileData(file.first, file.second);
+    }
+}
+
 void MscWriter::writeMeta()
 {
     if (m_meta.isWritten) {
@@ -395,6 +420,45 @@ bool MscWriter::DirWriter::addFileData(const String& fileName, const ByteArray&
     return true;
 }
 
+Ret MscWriter::MemoryWriter::open(io::IODevice*, const io::path_t&)
+{
+    IF_ASSERT_FAILED(files) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    files->clear();
+    m_isOpened = true;
+
+    return true;
+}
+
+void MscWriter::MemoryWriter::close()
+{
+    m_isOpened = false;
+}
+
+bool MscWriter::MemoryWriter::isOpened() const
+{
+    return m_isOpened;
+}
+
+bool MscWriter::MemoryWriter::hasError() const
+{
+    return false;
+}
+
+bool MscWriter::MemoryWriter::addFileData(const String& fileName, const ByteArray& data)
+{
+    if (!m_isOpened) {
+        return false;
+    }
+
+    //! NOTE A copy, the data may be raw (not owned) and must outlive the writer
+    files->push_back({ fileName, ByteArray(data.constData(), data.size()) });
+
+    return true;
+}
+
 MscWriter::XmlFileWriter::~XmlFileWriter()
 {
     delete m_stream;
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_MSCWRITER_H
 #define MU_ENGRAVING_MSCWRITER_H
 
+#include <vector>
+
 #include "types/string.h"
 #include "types/ret.h"
 #include "io/path.h"
@@ -38,12 +40,16 @@ class MscWriter
 {
 public:
 
+    //! NOTE Files in the order they were written
+    using Files = std::vector<std::pair<String, ByteArray> >;
+
     struct Params
     {
         io::IODevice* device = nullptr;
         io::path_t filePath;
         String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+        Files* files = nullptr;     // if set, the files are collected here instead of writing the container
     };
 
     MscWriter() = default;
@@ -63,12 +69,16 @@ public:
     void addExcerptStyleFile(const String& excerptFileName, const ByteArray& data);
     void addExcerptFile(const String& excerptFileName, const ByteArray& data);
     void writeChordListFile(const ByteArray& data);
+    void writeEngravingCacheFile(const ByteArray& data);
     void writeThumbnailFile(const ByteArray& data);
     void addImageFile(const String& fileName, const ByteArray& data);
     void writeAudioFile(const ByteArray& data);
     void writeAudioSettingsJsonFile(const ByteArray& data, const io::path_t& pathPrefix = "");
     void writeViewSettingsJsonFile(const ByteArray& data, const io::path_t& pathPrefix = "");
 
+    //! NOTE Writes the files collected by another writer (see Params::files)
+    void addFiles(const Files& files);
+
 private:
 
     struct IWriter {
@@ -122,6 +132,19 @@ private:
         TextStream* m_stream = nullptr;
     };
 
+    struct MemoryWriter : public IWriter
+    {
+        Ret open(io::IODevice* device, const io::path_t& filePath) override;
+        void close() override;
+        bool isOpened() const override;
+        bool hasError() const override;
+        bool addFileData(const String& fileName, const ByteArray& data) override;
+
+        Files* files = nullptr;
+    private:
+        bool m_isOpened = false;
+    };
+
     struct Meta {
         std::vector<String> files;
         bool isWritten = false;
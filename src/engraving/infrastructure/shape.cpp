@@ -19,7 +19,9 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 
 #include "shape.h"
 
@@ -33,6 +35,23 @@ using namespace mu;
 using namespace mu::draw;
 using namespace mu::engraving;
 
+// below this size a plain walk over the elements is cheaper than the index
+static constexpr size_t Y_INDEX_MIN_SIZE = 16;
+
+//---------------------------------------------------------
+//   isOutside
+//    true if r can't intersect anything inside bbox
+//---------------------------------------------------------
+
+static bool isOutside(const RectF& bbox, const RectF& r)
+{
+    double l = std::min(r.left(), r.right());
+    double rt = std::max(r.left(), r.right());
+    double t = std::min(r.top(), r.bottom());
+    double b = std::max(r.top(), r.bottom());
+    return rt < bbox.left() || l > bbox.right() || b < bbox.top() || t > bbox.bottom();
+}
+
 Shape::Shape(const std::vector<RectF>& rects, const EngravingItem* p)
 {
     m_type = Type::Composite;
@@ -60,6 +79,33 @@ void Shape::addHorizontalSpacing(EngravingItem* item, double leftEdge, double ri
     add(RectF(leftEdge, 0, rightEdge - leftEdge, 0), item);
 }
 
+//---------------------------------------------------------
+//   setItem
+//    makes item the owner of all elements
+//---------------------------------------------------------
+
+void Shape::setItem(const EngravingItem* item)
+{
+    for (ShapeElement& e : m_elements) {
+        e.setItem(item);
+    }
+}
+
+//---------------------------------------------------------
+//   translateItem
+//    translates only the elements of item
+//---------------------------------------------------------
+
+void Shape::translateItem(const EngravingItem* item, const PointF& pt)
+{
+    for (ShapeElement& e : m_elements) {
+        if (e.item() == item) {
+            e.translate(pt);
+        }
+    }
+    invalidateBBox();
+}
+
 //---------------------------------------------------------
 //   translate
 //---------------------------------------------------------
@@ -127,6 +173,63 @@ Shape Shape::scaled(const SizeF& mag) const
 void Shape::invalidateBBox()
 {
     m_bbox = RectF();
+    m_yIndex.valid = false;
+}
+
+//---------------------------------------------------------
+//   buildYIndex
+//---------------------------------------------------------
+
+void Shape::buildYIndex() const
+{
+    m_yIndex.byTop.clear();
+    m_yIndex.byTop.reserve(m_elements.size());
+    m_yIndex.maxHeight = 0.0;
+    for (size_t i = 0; i < m_elements.size(); ++i) {
+        const ShapeElement& e = m_elements[i];
+        m_yIndex.byTop.emplace_back(std::min(e.top(), e.bottom()), i);
+        m_yIndex.maxHeight = std::max(m_yIndex.maxHeight, std::abs(e.height()));
+    }
+    std::sort(m_yIndex.byTop.begin(), m_yIndex.byTop.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    m_yIndex.valid = true;
+}
+
+//---------------------------------------------------------
+//   forEachInYRange
+//    Calls func for every element that may reach into
+//    the range y1..y2; callers still apply their exact test.
+//    func returns false to stop the walk.
+//---------------------------------------------------------
+
+template<typename Func>
+void Shape::forEachInYRange(double y1, double y2, Func func) const
+{
+    if (m_elements.size() < Y_INDEX_MIN_SIZE) {
+        for (const ShapeElement& e : m_elements) {
+            if (!func(e)) {
+                return;
+            }
+        }
+        return;
+    }
+
+    if (!m_yIndex.valid) {
+        buildYIndex();
+    }
+
+    // some slack, so that rounding never drops an element
+    const double lo = std::min(y1, y2) - m_yIndex.maxHeight - 1.0;
+    const double hi = std::max(y1, y2) + 1.0;
+    auto it = std::lower_bound(m_yIndex.byTop.cbegin(), m_yIndex.byTop.cend(), lo, [](const auto& e, double y) {
+        return e.first < y;
+    });
+    for (; it != m_yIndex.byTop.cend() && it->first <= hi; ++it) {
+        if (!func(m_elements[it->second])) {
+            return;
+        }
+    }
 }
 
 const RectF& Shape::bbox() const
@@ -186,6 +289,7 @@ double Shape::minVerticalDistance(const Shape& a) const
         return 0.0;
     }
 
+    const RectF& bb = bbox();
     double dist = -DBL_MAX; // min real
     for (const RectF& r2 : a.m_elements) {
         if (r2.height() <= 0.0) {
@@ -193,6 +297,9 @@ double Shape::minVerticalDistance(const Shape& a) const
         }
         double bx1 = r2.left();
         double bx2 = r2.right();
+        if (bb.right() <= std::min(bx1, bx2) || bb.left() >= std::max(bx1, bx2)) {
+            continue;
+        }
         for (const RectF& r1 : m_elements) {
             if (r1.height() <= 0.0) {
                 continue;
@@ -221,6 +328,7 @@ double Shape::verticalClearance(const Shape& a, double minHorizontalDistance) co
         return 0.0;
     }
 
+    const RectF& bb = bbox();
     double dist = DBL_MAX; // max real
     for (const RectF& r2 : a.m_elements) {
         if (r2.height() <= 0.0) {
@@ -228,6 +336,9 @@ double Shape::verticalClearance(const Shape& a, double minHorizontalDistance) co
         }
         double bx1 = r2.left() - minHorizontalDistance;
         double bx2 = r2.right() + minHorizontalDistance;
+        if (bb.right() <= std::min(bx1, bx2) || bb.left() >= std::max(bx1, bx2)) {
+            continue;
+        }
         for (const RectF& r1 : m_elements) {
             if (r1.height() <= 0.0) {
                 continue;
@@ -250,7 +361,11 @@ double Shape::verticalClearance(const Shape& a, double minHorizontalDistance) co
 //----------------------------------------------------------------
 bool Shape::clearsVertically(const Shape& a) const
 {
+    const RectF& bb = bbox();
     for (const RectF& r1 : a.m_elements) {
+        if (bb.right() <= std::min(r1.left(), r1.right()) || bb.left() >= std::max(r1.left(), r1.right())) {
+            continue;
+        }
         for (const RectF& r2 : m_elements) {
             if (mu::engraving::intersects(r1.left(), r1.right(), r2.left(), r2.right(), 0.0)) {
                 if (std::min(r1.top(), r1.bottom()) <= std::max(r2.top(), r2.bottom())) {
@@ -333,11 +448,12 @@ double Shape::bottom() const
 double Shape::rightMostEdgeAtHeight(double yAbove, double yBelow) const
 {
     double edge = -DBL_MAX;
-    for (const ShapeElement& sh : m_elements) {
+    forEachInYRange(yAbove, yBelow, [&](const ShapeElement& sh) {
         if (sh.bottom() > yAbove && sh.top() < yBelow) {
             edge = std::max(edge, sh.right());
         }
-    }
+        return true;
+    });
 
     return edge;
 }
@@ -345,11 +461,12 @@ double Shape::rightMostEdgeAtHeight(double yAbove, double yBelow) const
 double Shape::leftMostEdgeAtHeight(double yAbove, double yBelow) const
 {
     double edge = DBL_MAX;
-    for (const ShapeElement& sh : m_elements) {
+    forEachInYRange(yAbove, yBelow, [&](const ShapeElement& sh) {
         if (sh.bottom() > yAbove && sh.top() < yBelow) {
             edge = std::min(edge, sh.left());
         }
-    }
+        return true;
+    });
 
     return edge;
 }
@@ -399,6 +516,7 @@ void Shape::setBBox(const mu::RectF& r, const EngravingItem* p)
     } else {
         m_elements[0] = ShapeElement(r, p);
     }
+    invalidateBBox();
 }
 
 void Shape::addBBox(const mu::RectF& r)
@@ -412,24 +530,36 @@ void Shape::addBBox(const mu::RectF& r)
     }
 
     m_elements[0].unite(r);
+    invalidateBBox();
 }
 
 //---------------------------------------------------------
 //   add
+//    A bbox that is already computed is extended rather
+//    than dropped, so that building up a shape piece by
+//    piece doesn't recompute it over and over.
 //---------------------------------------------------------
 
 void Shape::add(const Shape& s)
 {
     m_type = Type::Composite;
     m_elements.insert(m_elements.end(), s.m_elements.begin(), s.m_elements.end());
-    invalidateBBox();
+    if (!m_bbox.isNull()) {
+        for (const ShapeElement& e : s.m_elements) {
+            m_bbox.unite(e);
+        }
+    }
+    m_yIndex.valid = false;
 }
 
 void Shape::add(const ShapeElement& shapeEl)
 {
     m_type = Type::Composite;
     m_elements.push_back(shapeEl);
-    invalidateBBox();
+    if (!m_bbox.isNull()) {
+        m_bbox.unite(shapeEl);
+    }
+    m_yIndex.valid = false;
 }
 
 //---------------------------------------------------------
@@ -441,6 +571,7 @@ void Shape::remove(const RectF& r)
     for (auto i = m_elements.begin(); i != m_elements.end(); ++i) {
         if (*i == r) {
             m_elements.erase(i);
+            invalidateBBox();
             return;
         }
     }
@@ -481,12 +612,12 @@ void Shape::removeTypes(const std::set<ElementType>& types)
 
 bool Shape::contains(const PointF& p) const
 {
-    for (const RectF& r : m_elements) {
-        if (r.contains(p)) {
-            return true;
-        }
-    }
-    return false;
+    bool found = false;
+    forEachInYRange(p.y(), p.y(), [&](const ShapeElement& r) {
+        found = r.contains(p);
+        return !found;
+    });
+    return found;
 }
 
 //---------------------------------------------------------
@@ -495,12 +626,16 @@ bool Shape::contains(const PointF& p) const
 
 bool Shape::intersects(const RectF& rr) const
 {
-    for (const RectF& r : m_elements) {
-        if (r.intersects(rr)) {
-            return true;
-        }
+    if (m_elements.size() >= Y_INDEX_MIN_SIZE && isOutside(bbox(), rr)) {
+        return false;
     }
-    return false;
+
+    bool found = false;
+    forEachInYRange(rr.top(), rr.bottom(), [&](const ShapeElement& r) {
+        found = r.intersects(rr);
+        return !found;
+    });
+    return found;
 }
 
 //---------------------------------------------------------
@@ -509,6 +644,10 @@ bool Shape::intersects(const RectF& rr) const
 
 bool Shape::intersects(const Shape& other) const
 {
+    if (empty() || other.empty() || isOutside(bbox(), other.bbox())) {
+        return false;
+    }
+
     for (const RectF& r : other.m_elements) {
         if (intersects(r)) {
             return true;
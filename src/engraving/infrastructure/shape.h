@@ -86,7 +86,7 @@ public:
 
     size_t size() const { return m_elements.size(); }
     bool empty() const { return m_elements.empty(); }
-    void clear() { m_elements.clear(); }
+    void clear() { m_elements.clear(); invalidateBBox(); }
 
     bool equal(const Shape& sh) const
     {
@@ -126,8 +126,9 @@ public:
 
     // ---
 
+    //! NOTE Read only: the elements are changed through the methods below,
+    //! so that the bbox and the height index are always dropped with them
     const std::vector<ShapeElement>& elements() const { return m_elements; }
-    std::vector<ShapeElement>& elements() { return m_elements; }
 
     std::optional<ShapeElement> find_if(const std::function<bool(const ShapeElement&)>& func) const;
     std::optional<ShapeElement> find_first(ElementType type) const;
@@ -138,6 +139,9 @@ public:
 
     void addHorizontalSpacing(EngravingItem* item, double left, double right);
 
+    void setItem(const EngravingItem* item);
+    void translateItem(const EngravingItem* item, const mu::PointF&);
+
     Shape& translate(const mu::PointF&);
     void translateX(double);
     void translateY(double);
@@ -168,9 +172,23 @@ private:
 
     void invalidateBBox();
 
+    template<typename Func>
+    void forEachInYRange(double y1, double y2, Func func) const;
+    void buildYIndex() const;
+
+    //! NOTE Elements sorted by their top edge, so that queries limited to
+    //! a vertical range don't have to visit every element of large shapes.
+    //! Built on first use and dropped together with the bbox cache.
+    struct YIndex {
+        std::vector<std::pair<double, size_t> > byTop;   // top, element index
+        double maxHeight = 0.0;
+        bool valid = false;
+    };
+
     Type m_type = Type::Fixed;
     std::vector<ShapeElement> m_elements;
     mutable RectF m_bbox;   // cache
+    mutable YIndex m_yIndex; // cache
 };
 
 void dump(const ShapeElement& sh, std::stringstream& ss);
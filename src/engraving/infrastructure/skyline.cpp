@@ -106,6 +106,57 @@ void Skyline::add(const ShapeElement& r)
     }
 }
 
+//---------------------------------------------------------
+//   SkylineLine
+//---------------------------------------------------------
+
+SkylineLine::SkylineLine(bool n)
+    : north(n)
+{
+    clear();
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SkylineLine::clear()
+{
+    seg.clear();
+    m_rangeTableValid = false;
+    m_minY = MAXIMUM_Y;
+    m_maxY = MINIMUM_Y;
+}
+
+//---------------------------------------------------------
+//   updateBounds
+//    segment heights only ever move outwards (up for north,
+//    down for south), so the outer bound is exact while the
+//    inner one is conservative
+//---------------------------------------------------------
+
+void SkylineLine::updateBounds(double y)
+{
+    m_rangeTableValid = false;
+    m_minY = std::min(m_minY, y);
+    m_maxY = std::max(m_maxY, y);
+}
+
+//---------------------------------------------------------
+//   reserveFor
+//    every added element splits at most one segment
+//    into three, grow geometrically to avoid repeated
+//    reallocation in the middle of bulk adds
+//---------------------------------------------------------
+
+void SkylineLine::reserveFor(size_t elements)
+{
+    const size_t needed = seg.size() + 2 * elements + 1;
+    if (needed > seg.capacity()) {
+        seg.reserve(std::max(needed, 2 * seg.capacity()));
+    }
+}
+
 //---------------------------------------------------------
 //   insert
 //---------------------------------------------------------
@@ -118,6 +169,7 @@ SkylineLine::SegIter SkylineLine::insert(SegIter i, double x, double y, double w
     if (i != seg.end() && xr > i->x) {
         i->x = xr;
     }
+    updateBounds(y);
     return seg.emplace(i, x, y, w);
 }
 
@@ -127,9 +179,20 @@ SkylineLine::SegIter SkylineLine::insert(SegIter i, double x, double y, double w
 
 void SkylineLine::append(double x, double y, double w)
 {
+    updateBounds(y);
     seg.emplace_back(x, y, w);
 }
 
+//---------------------------------------------------------
+//   setY
+//---------------------------------------------------------
+
+void SkylineLine::setY(SegIter i, double y)
+{
+    updateBounds(y);
+    i->y = y;
+}
+
 //---------------------------------------------------------
 //   getApproxPosition
 //---------------------------------------------------------
@@ -154,6 +217,7 @@ SkylineLine::SegConstIter SkylineLine::find(double x) const
 
 void SkylineLine::add(const Shape& s)
 {
+    reserveFor(s.elements().size());
     for (const auto& r : s.elements()) {
         add(r);
     }
@@ -173,6 +237,8 @@ void SkylineLine::add(const ShapeElement& r)
 
 void Skyline::add(const Shape& s)
 {
+    _north.reserveFor(s.elements().size());
+    _south.reserveFor(s.elements().size());
     for (const auto& r : s.elements()) {
         add(r);
     }
@@ -218,7 +284,7 @@ void SkylineLine::add(double x, double y, double w)
                 DP("       A w1 %f w2 %f\n", w1, w2);
             } else {
                 i->w = w2;
-                i->y = y;
+                setY(i, y);
                 DP("       B w2 %f\n", w2);
             }
             if (w3 > 0.0000001) {
@@ -229,7 +295,7 @@ void SkylineLine::add(double x, double y, double w)
             return;
         } else if ((x <= cx) && ((x + w) >= (cx + i->w))) {                 // F
             DP("    change(F) cx %f y %f\n", cx, y);
-            i->y = y;
+            setY(i, y);
         } else if (x < cx) {                                            // C
             double w1 = x + w - cx;
             i->w    -= w1;
@@ -287,6 +353,10 @@ double SkylineLine::minDistance(const SkylineLine& sl) const
 {
     double dist = MINIMUM_Y;
 
+    // no pair of segments can be further apart than the bounds of both lines,
+    // so the scan can stop as soon as that distance is reached
+    const double maxDist = m_maxY - sl.m_minY;
+
     double x1 = 0.0;
     double x2 = 0.0;
     auto k   = sl.begin();
@@ -301,6 +371,9 @@ double SkylineLine::minDistance(const SkylineLine& sl) const
         for (;;) {
             if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
                 dist = std::max(dist, i->y - k->y);
+                if (dist >= maxDist) {
+                    return dist;
+                }
             }
             if (x2 + k->w < x1 + i->w) {
                 x2 += k->w;
@@ -363,9 +436,9 @@ bool SkylineLine::valid() const
     return !seg.empty();
 }
 
-bool SkylineLine::valid(const SkylineSegment& s) const
+bool SkylineLine::valid(double y) const
 {
-    return north ? (s.y != MAXIMUM_Y) : (s.y != MINIMUM_Y);
+    return north ? (y != MAXIMUM_Y) : (y != MINIMUM_Y);
 }
 
 //---------------------------------------------------------
@@ -397,18 +470,69 @@ void SkylineLine::dump() const
 
 double SkylineLine::max() const
 {
-    double val;
     if (north) {
-        val = MAXIMUM_Y;
-        for (const SkylineSegment& s : *this) {
-            val = std::min(val, s.y);
-        }
-    } else {
-        val = MINIMUM_Y;
-        for (const SkylineSegment& s : *this) {
-            val = std::max(val, s.y);
+        return seg.empty() ? MAXIMUM_Y : m_minY;
+    }
+    return seg.empty() ? MINIMUM_Y : m_maxY;
+}
+
+//---------------------------------------------------------
+//   buildRangeTable
+//    level k holds the outermost height of the 2^k segments
+//    starting at each index. Built on the first range query
+//    after a change, so adding to the line stays as cheap
+//    as before
+//---------------------------------------------------------
+
+void SkylineLine::buildRangeTable() const
+{
+    const size_t n = seg.size();
+    size_t levels = 1;
+    while ((size_t(1) << levels) <= n) {
+        ++levels;
+    }
+
+    m_rangeTable.resize(n * levels);
+    for (size_t i = 0; i < n; ++i) {
+        m_rangeTable[i] = seg[i].y;
+    }
+    for (size_t k = 1; k < levels; ++k) {
+        const size_t half = size_t(1) << (k - 1);
+        const double* prev = m_rangeTable.data() + (k - 1) * n;
+        double* cur = m_rangeTable.data() + k * n;
+        for (size_t i = 0; i + 2 * half <= n; ++i) {
+            cur[i] = outer(prev[i], prev[i + half]);
         }
     }
-    return val;
+    m_rangeTableValid = true;
+}
+
+//---------------------------------------------------------
+//   max
+//    outermost height of the segments starting in [from, to],
+//    in O(log n) for the lookup and O(1) for the extremum.
+//    Returns the value of an empty line if there are none
+//---------------------------------------------------------
+
+double SkylineLine::max(double from, double to) const
+{
+    auto first = std::lower_bound(seg.begin(), seg.end(), from, [](const SkylineSegment& s, double x) { return s.x < x; });
+    auto last = std::upper_bound(first, seg.end(), to, [](double x, const SkylineSegment& s) { return x < s.x; });
+    if (first >= last) {
+        return north ? MAXIMUM_Y : MINIMUM_Y;
+    }
+
+    if (!m_rangeTableValid) {
+        buildRangeTable();
+    }
+
+    const size_t n = seg.size();
+    const size_t l = first - seg.begin();
+    const size_t r = last - seg.begin();
+    size_t k = 0;
+    while ((size_t(2) << k) <= r - l) {
+        ++k;
+    }
+    return outer(m_rangeTable[k * n + l], m_rangeTable[k * n + r - (size_t(1) << k)]);
 }
 } // namespace mu::engraving
@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_SKYLINE_H
 #define MU_ENGRAVING_SKYLINE_H
 
+#include <algorithm>
 #include <vector>
 
 #include "draw/types/geometry.h"
@@ -56,34 +57,46 @@ class SkylineLine
 {
     const bool north;
     std::vector<SkylineSegment> seg;
+    double m_minY = 0.0;    // bounds of all heights ever stored in seg,
+    double m_maxY = 0.0;    // see updateBounds()
+    mutable std::vector<double> m_rangeTable;   // sparse table over the heights in seg,
+    mutable bool m_rangeTableValid = false;     // see buildRangeTable()
     typedef std::vector<SkylineSegment>::iterator SegIter;
     typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
 
     SegIter insert(SegIter i, double x, double y, double w);
     void append(double x, double y, double w);
+    void setY(SegIter i, double y);
+    void updateBounds(double y);
+    void reserveFor(size_t elements);
     SegIter find(double x);
     SegConstIter find(double x) const;
+    double outer(double y1, double y2) const { return north ? std::min(y1, y2) : std::max(y1, y2); }
+    void buildRangeTable() const;
+
+    friend class Skyline;
 
 public:
-    SkylineLine(bool n)
-        : north(n) {}
+    SkylineLine(bool n);
     void add(const Shape& s);
     void add(const ShapeElement& r);
     void add(double x, double y, double w);
     void add(const RectF& r) { add(ShapeElement(r)); }
 
-    void clear() { seg.clear(); }
+    void clear();   // keeps the allocated storage
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
     double minDistance(const SkylineLine&) const;
     double max() const;
+    double max(double from, double to) const;
     bool valid() const;
-    bool valid(const SkylineSegment& s) const;
+    bool valid(double y) const;
+    bool valid(const SkylineSegment& s) const { return valid(s.y); }
     bool isNorth() const { return north; }
 
-    SegIter begin() { return seg.begin(); }
+    SegIter begin() { m_rangeTableValid = false; return seg.begin(); }
     SegConstIter begin() const { return seg.begin(); }
-    SegIter end() { return seg.end(); }
+    SegIter end() { m_rangeTableValid = false; return seg.end(); }
     SegConstIter end() const { return seg.end(); }
 };
 
@@ -1168,11 +1168,7 @@ void ChordLayout::layoutArticulations3(Chord* item, Slur* slur, LayoutContext& c
                 aa->mutldata()->moveY(minDist);
                 if (sstaff && aa->addToSkyline()) {
                     sstaff->skyline().add(aa->shape().translate(aa->pos() + item->pos() + s->pos() + m->pos()));
-                    for (ShapeElement& sh : s->staffShape(item->staffIdx()).elements()) {
-                        if (sh.item() == aa) {
-                            sh.translate(0.0, minDist);
-                        }
-                    }
+                    s->staffShape(item->staffIdx()).translateItem(aa, PointF(0.0, minDist));
                 }
             }
         }
@@ -110,6 +110,11 @@ void DebugPaint::paintElementDebug(mu::draw::Painter& painter, const EngravingIt
     painter.translate(-pos);
 }
 
+bool DebugPaint::isPageDebugEnabled()
+{
+    return configuration()->debuggingOptions().anyEnabled();
+}
+
 void DebugPaint::paintPageDebug(Painter& painter, const Page* page, const std::vector<EngravingItem*>& items)
 {
     auto options = configuration()->debuggingOptions();
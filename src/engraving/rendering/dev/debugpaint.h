@@ -42,6 +42,7 @@ class DebugPaint
 
 public:
     static void paintElementDebug(mu::draw::Painter& painter, const EngravingItem* item);
+    static bool isPageDebugEnabled();
     static void paintPageDebug(mu::draw::Painter& painter, const Page* page, const std::vector<EngravingItem*>& items);
 
     static void paintPageTree(mu::draw::Painter& painter, const Page* page);
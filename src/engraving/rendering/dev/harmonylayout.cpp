@@ -39,7 +39,7 @@
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
-void HarmonyLayout::layoutHarmonies(const std::vector<Segment*>& sl, LayoutContext& ctx)
+void HarmonyLayout::layoutHarmonies(const LayoutVector<Segment*>& sl, LayoutContext& ctx)
 {
     for (const Segment* s : sl) {
         for (EngravingItem* e : s->annotations()) {
@@ -57,7 +57,7 @@ void HarmonyLayout::layoutHarmonies(const std::vector<Segment*>& sl, LayoutConte
     }
 }
 
-void HarmonyLayout::alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool harmony, const double maxShiftAbove,
+void HarmonyLayout::alignHarmonies(const System* system, const LayoutVector<Segment*>& sl, bool harmony, const double maxShiftAbove,
                                    const double maxShiftBelow)
 {
     // Help class.
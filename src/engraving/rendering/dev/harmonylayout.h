@@ -36,8 +36,8 @@ class HarmonyLayout
 {
 public:
 
-    static void layoutHarmonies(const std::vector<Segment*>& sl, LayoutContext& ctx);
-    static void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool harmony, const double maxShiftAbove,
+    static void layoutHarmonies(const LayoutVector<Segment*>& sl, LayoutContext& ctx);
+    static void alignHarmonies(const System* system, const LayoutVector<Segment*>& sl, bool harmony, const double maxShiftAbove,
                                const double maxShiftBelow);
 };
 }
@@ -31,11 +31,173 @@
 #include "dom/score.h"
 #include "dom/stemslash.h"
 #include "dom/staff.h"
+#include "dom/system.h"
 #include "dom/tie.h"
 
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
+//---------------------------------------------------------
+//   takeSnapshot
+//---------------------------------------------------------
+
+HorizontalSpacing::SegmentsSnapshot HorizontalSpacing::takeSnapshot(const System* system)
+{
+    SegmentsSnapshot snapshot;
+
+    size_t count = 0;
+    for (const MeasureBase* mb : system->measures()) {
+        if (mb->isMeasure()) {
+            count += toMeasure(mb)->segments().size();
+        }
+    }
+    snapshot.segments.reserve(count);
+    snapshot.x.reserve(count);
+    snapshot.width.reserve(count);
+    snapshot.widthOffset.reserve(count);
+    snapshot.stretch.reserve(count);
+    snapshot.flags.reserve(count);
+
+    for (MeasureBase* mb : system->measures()) {
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        Measure* m = toMeasure(mb);
+        for (Segment& s : m->segments()) {
+            uint8_t flags = 0;
+            if (s.enabled() && s.visible() && !s.allElementsInvisible()) {
+                flags |= SegmentsSnapshot::ACTIVE;
+            }
+            if (s.isChordRestType()) {
+                flags |= SegmentsSnapshot::CHORDREST;
+                if ((flags & SegmentsSnapshot::ACTIVE) && s.ticks() > Fraction(0, 1)) {
+                    flags |= SegmentsSnapshot::SPRING;
+                }
+            }
+
+            snapshot.segments.push_back(&s);
+            snapshot.x.push_back(s.x());
+            snapshot.width.push_back(s.width(LD_ACCESS::BAD));
+            snapshot.widthOffset.push_back(s.widthOffset());
+            snapshot.stretch.push_back(s.stretch());
+            snapshot.flags.push_back(flags);
+        }
+        snapshot.measures.push_back(m);
+        snapshot.measureEnd.push_back(snapshot.segments.size());
+        snapshot.measureWidth.push_back(m->width());
+    }
+
+    return snapshot;
+}
+
+//---------------------------------------------------------
+//   applySnapshot
+//---------------------------------------------------------
+
+void HorizontalSpacing::applySnapshot(const SegmentsSnapshot& snapshot)
+{
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        Segment* s = snapshot.segments[i];
+        s->setWidth(snapshot.width[i]);
+        s->mutldata()->setPosX(snapshot.x[i]);
+    }
+    for (size_t i = 0; i < snapshot.measures.size(); ++i) {
+        snapshot.measures[i]->setWidth(snapshot.measureWidth[i]);
+    }
+}
+
+//---------------------------------------------------------
+//   stretchSegmentsToWidth
+//    spring-rod method over the SPRING segments,
+//    same as Segment::stretchSegmentsToWidth()
+//---------------------------------------------------------
+
+void HorizontalSpacing::stretchSegmentsToWidth(SegmentsSnapshot& snapshot, double width)
+{
+    if (RealIsEqualOrLess(width, 0.0)) {
+        return;
+    }
+
+    std::vector<size_t> springs;
+    std::vector<double> springConst;
+    std::vector<double> preTension;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        if (snapshot.flags[i] & SegmentsSnapshot::SPRING) {
+            springs.push_back(i);
+        }
+    }
+    if (springs.empty()) {
+        return;
+    }
+
+    springConst.resize(springs.size());
+    preTension.resize(springs.size());
+    for (size_t k = 0; k < springs.size(); ++k) {
+        size_t i = springs[k];
+        springConst[k] = 1 / snapshot.stretch[i];
+        preTension[k] = (snapshot.width[i] - snapshot.widthOffset[i]) * springConst[k];
+    }
+
+    std::vector<size_t> order(springs.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        order[k] = k;
+    }
+    std::sort(order.begin(), order.end(), [&preTension](size_t a, size_t b) { return preTension[a] < preTension[b]; });
+
+    double inverseSpringConst = 0.0;
+    double force = 0.0;
+    size_t k = 0;
+    do {
+        size_t o = order[k];
+        inverseSpringConst += 1 / springConst[o];
+        width += snapshot.width[springs[o]] - snapshot.widthOffset[springs[o]];
+        force = width / inverseSpringConst;
+        ++k;
+    } while (k < order.size() && !(force < preTension[order[k]]));
+
+    for (size_t k2 = 0; k2 < springs.size(); ++k2) {
+        if (force > preTension[k2]) {
+            size_t i = springs[k2];
+            snapshot.width[i] = force / springConst[k2] + snapshot.widthOffset[i];
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   respaceSegments
+//    puts the segments of each measure one after the other,
+//    same as Measure::respaceSegments().
+//    Returns how much wider the measures got.
+//---------------------------------------------------------
+
+double HorizontalSpacing::respaceSegments(SegmentsSnapshot& snapshot)
+{
+    double diff = 0.0;
+    size_t begin = 0;
+    for (size_t mi = 0; mi < snapshot.measures.size(); ++mi) {
+        const size_t end = snapshot.measureEnd[mi];
+
+        double x = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            if (snapshot.flags[i] & SegmentsSnapshot::ACTIVE) {
+                x = snapshot.x[i];
+                break;
+            }
+        }
+        for (size_t i = begin; i < end; ++i) {
+            snapshot.x[i] = x;
+            if (snapshot.flags[i] & SegmentsSnapshot::ACTIVE) {
+                x += snapshot.width[i];
+            }
+        }
+
+        diff += x - snapshot.measureWidth[mi];
+        snapshot.measureWidth[mi] = x;
+        begin = end;
+    }
+    return diff;
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -63,18 +225,21 @@ double HorizontalSpacing::minHorizontalDistance(const Shape& f, const Shape& s,
             double ay1 = r1.top();
             double ay2 = r1.bottom();
             bool intersection = mu::engraving::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
             KerningType kerningType = KerningType::NON_KERNING;
             if (item1 && item2) {
-                padding = computePadding(item1, item2);
-                padding *= squeezeFactor;
-                padding = std::max(padding, absoluteMinPadding);
                 kerningType = computeKerning(item1, item2);
             }
             if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
                 || (r1.width() == 0 || r2.width() == 0)  // Temporary hack: shapes of zero-width are assumed to collide with everyghin
                 || (!item1 && item2 && item2->isLyrics())  // Temporary hack: avoids collision with melisma line
                 || kerningType == KerningType::NON_KERNING) {
+                // padding is only needed for the pairs that actually limit the distance
+                double padding = 0;
+                if (item1 && item2) {
+                    padding = computePadding(item1, item2);
+                    padding *= squeezeFactor;
+                    padding = std::max(padding, absoluteMinPadding);
+                }
                 dist = std::max(dist, r1.right() - r2.left() + padding);
             }
             if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
@@ -22,6 +22,10 @@
 #ifndef MU_ENGRAVING_HORIZONTALSPACINGUTILS_DEV_H
 #define MU_ENGRAVING_HORIZONTALSPACINGUTILS_DEV_H
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace mu::engraving {
 class Chord;
 class EngravingItem;
@@ -31,6 +35,7 @@ class Shape;
 class StemSlash;
 class Segment;
 class Measure;
+class System;
 enum class ElementType;
 enum class KerningType;
 }
@@ -40,6 +45,35 @@ class HorizontalSpacing
 {
 public:
 
+    //! NOTE The spacing data of all segments of a system in contiguous arrays.
+    //! Justification and squeezing run over these instead of walking the
+    //! segment lists, the result is written back to the segments by applySnapshot()
+    struct SegmentsSnapshot {
+        enum Flags : uint8_t {
+            ACTIVE = 1 << 0,        // enabled, visible and not all elements invisible
+            CHORDREST = 1 << 1,
+            SPRING = 1 << 2,        // active chordrest segment with a duration, stretched by justification
+        };
+
+        std::vector<Segment*> segments;
+        std::vector<double> x;
+        std::vector<double> width;
+        std::vector<double> widthOffset;
+        std::vector<double> stretch;
+        std::vector<uint8_t> flags;
+
+        std::vector<Measure*> measures;
+        std::vector<size_t> measureEnd;     // index after the last segment of each measure
+        std::vector<double> measureWidth;
+
+        size_t size() const { return segments.size(); }
+    };
+
+    static SegmentsSnapshot takeSnapshot(const System* system);
+    static void applySnapshot(const SegmentsSnapshot& snapshot);
+    static void stretchSegmentsToWidth(SegmentsSnapshot& snapshot, double width);
+    static double respaceSegments(SegmentsSnapshot& snapshot);
+
     static double minHorizontalDistance(const Shape& f, const Shape& s, double spatium, double squeezeFactor = 1.0);
     //! NOTE Temporary solution
     static double shapeSpatium(const Shape& s);
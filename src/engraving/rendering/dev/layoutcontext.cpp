@@ -293,6 +293,14 @@ const ChordRest* DomAccessor::findCR(Fraction tick, track_idx_t track) const
     return score()->findCR(tick, track);
 }
 
+bool DomAccessor::isSystemStartHint(const MeasureBase* mb) const
+{
+    IF_ASSERT_FAILED(score()) {
+        return false;
+    }
+    return score()->isSystemStartHint(mb);
+}
+
 ChordRest* DomAccessor::findCR(Fraction tick, track_idx_t track)
 {
     IF_ASSERT_FAILED(score()) {
@@ -384,6 +392,14 @@ void DomAccessor::removeElement(EngravingItem* item)
     score()->removeElement(item);
 }
 
+void DomAccessor::invalidateTickIndex()
+{
+    IF_ASSERT_FAILED(score()) {
+        return;
+    }
+    score()->measures()->invalidateTickIndex();
+}
+
 void DomAccessor::addUnmanagedSpanner(Spanner* s)
 {
     IF_ASSERT_FAILED(score()) {
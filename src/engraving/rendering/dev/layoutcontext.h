@@ -25,6 +25,8 @@
 #include <vector>
 #include <set>
 
+#include "global/allocator.h"
+
 #include "types/fraction.h"
 #include "types/types.h"
 
@@ -175,6 +177,8 @@ public:
 
     const ChordRest* findCR(Fraction tick, track_idx_t track) const;
 
+    bool isSystemStartHint(const MeasureBase* mb) const;
+
     // Mutable access
     std::vector<Page*>& pages();
     std::vector<System*>& systems();
@@ -195,6 +199,7 @@ public:
     void undo(UndoCommand* cmd, EditData* ed = nullptr) const;
     void addElement(EngravingItem* item);
     void removeElement(EngravingItem* item);
+    void invalidateTickIndex();
 
     void addUnmanagedSpanner(Spanner* s);
     const std::set<Spanner*>& unmanagedSpanners() const;
@@ -240,6 +245,11 @@ public:
 
     double segmentShapeSqueezeFactor() const { return m_segmentShapeSqueezeFactor; }
 
+    // Statistics
+    size_t systemsLaidOut() const { return m_systemsLaidOut; }
+    size_t systemsReused() const { return m_systemsReused; }
+    size_t distancesReused() const { return m_distancesReused; }
+
     // Mutable
     void setFirstSystem(bool val) { m_firstSystem = val; }
     void setFirstSystemIndent(bool val) { m_firstSystemIndent = val; }
@@ -279,6 +289,10 @@ public:
 
     void setSegmentShapeSqueezeFactor(double val) { m_segmentShapeSqueezeFactor = val; }
 
+    void incSystemsLaidOut() { ++m_systemsLaidOut; }
+    void incSystemsReused() { ++m_systemsReused; }
+    void incDistancesReused() const { ++m_distancesReused; }
+
 private:
 
     bool m_firstSystem = true;
@@ -312,6 +326,11 @@ private:
 
     // cache
     double m_totalBracketsWidth = -1.0;
+
+    // statistics
+    size_t m_systemsLaidOut = 0;            // systems collected and laid out in this pass
+    size_t m_systemsReused = 0;             // systems taken unchanged from the previous layout
+    mutable size_t m_distancesReused = 0;   // system distances taken from cache
 };
 
 class LayoutDebug
@@ -372,6 +391,11 @@ private:
     std::vector<Call> m_calls;
 };
 
+//! NOTE Containers for data which is needed only during one layout pass,
+//! allocated from LayoutContext::arena()
+template<typename T>
+using LayoutVector = std::vector<T, ArenaStlAllocator<T> >;
+
 class LayoutContext : public IGetScoreInternal
 {
 public:
@@ -399,6 +423,9 @@ public:
     void setLayout(const Fraction& tick1, const Fraction& tick2, staff_idx_t staff1, staff_idx_t staff2, const EngravingItem* e);
     void addRefresh(const mu::RectF& r);
 
+    // Transient data
+    ArenaAllocator& arena() { return m_arena; }
+
     // Other
     const Selection& selection() const;
     void select(EngravingItem* item, SelectType = SelectType::SINGLE, staff_idx_t staff = 0);
@@ -413,6 +440,7 @@ private:
     LayoutConfiguration m_configuration;
     DomAccessor m_dom;
     LayoutState m_state;
+    ArenaAllocator m_arena;
 };
 }
 
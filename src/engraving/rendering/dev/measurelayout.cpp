@@ -511,8 +511,12 @@ void MeasureLayout::createMMRest(LayoutContext& ctx, Measure* firstMeasure, Meas
     }
 
     MeasureBase* nm = ctx.conf().isShowVBox() ? lastMeasure->next() : lastMeasure->nextMeasure();
-    mmrMeasure->setNext(nm);
-    mmrMeasure->setPrev(firstMeasure->prev());
+    if (mmrMeasure->next() != nm || mmrMeasure->prev() != firstMeasure->prev()) {
+        mmrMeasure->setNext(nm);
+        mmrMeasure->setPrev(firstMeasure->prev());
+        // the mmrest now covers other measures
+        ctx.mutDom().invalidateTickIndex();
+    }
 }
 
 //---------------------------------------------------------
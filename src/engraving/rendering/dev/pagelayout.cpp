@@ -212,6 +212,8 @@ void PageLayout::collectPage(LayoutContext& ctx)
         bool collected = false;
         if (ctx.state().rangeDone()) {
             // take next system unchanged
+            //! NOTE Its segment shapes and staff skylines are kept from the previous layout,
+            //! only the page position and the distance to the previous system are updated
             if (systemIdx > 0) {
                 nextSystem = mu::value(ctx.mutDom().systems(), systemIdx++);
                 if (!nextSystem) {
@@ -223,6 +225,9 @@ void PageLayout::collectPage(LayoutContext& ctx)
                     ctx.mutDom().systems().push_back(nextSystem);
                 }
             }
+            if (nextSystem) {
+                ctx.mutState().incSystemsReused();
+            }
         } else {
             nextSystem = SystemLayout::collectSystem(ctx);
             if (nextSystem) {
@@ -424,7 +429,7 @@ void PageLayout::collectPage(LayoutContext& ctx)
         }
     }
 
-    page->invalidateBspTree();
+    page->invalidateBspTreeSystems();
 }
 
 //---------------------------------------------------------
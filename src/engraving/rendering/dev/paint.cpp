@@ -28,6 +28,7 @@
 
 #include "tdraw.h"
 #include "debugpaint.h"
+#include "systemdrawcache.h"
 
 #include "log.h"
 
@@ -137,15 +138,28 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const IScoreRendere
                 disableClipping = true;
             }
 
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
-            paintItems(*painter, elements);
+            //! NOTE The cache finds the items of its systems itself,
+            //! so the page is only queried for drawing without it or for debugging
+            SystemDrawCache* drawCache = opt.isPrinting ? nullptr : dynamic_cast<SystemDrawCache*>(opt.cache.get());
+            const bool paintDebug = !opt.isPrinting && DebugPaint::isPageDebugEnabled();
+
+            std::vector<EngravingItem*> elements;
+            if (!drawCache || paintDebug) {
+                elements = page->items(drawRect.translated(-pagePos));
+            }
+
+            if (drawCache) {
+                drawCache->paintPage(*painter, page, drawRect.translated(-pagePos));
+            } else {
+                paintItems(*painter, elements);
+            }
             //DebugPaint::paintPageTree(*painter, page);
 
             if (disableClipping) {
                 painter->setClipping(false);
             }
 
-            if (!opt.isPrinting) {
+            if (paintDebug) {
                 DebugPaint::paintPageDebug(*painter, page, elements);
             }
 
@@ -5,6 +5,8 @@ set(RENDERING_DEV_SRC
     ${CMAKE_CURRENT_LIST_DIR}/scorerenderer.h
     ${CMAKE_CURRENT_LIST_DIR}/paint.cpp
     ${CMAKE_CURRENT_LIST_DIR}/paint.h
+    ${CMAKE_CURRENT_LIST_DIR}/systemdrawcache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/systemdrawcache.h
     ${CMAKE_CURRENT_LIST_DIR}/debugpaint.cpp
     ${CMAKE_CURRENT_LIST_DIR}/debugpaint.h
     ${CMAKE_CURRENT_LIST_DIR}/paintdebugger.cpp
@@ -95,5 +95,15 @@ void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction&
         break;
     }
 
+#ifdef MUE_ENABLE_ENGRAVING_RENDER_DEBUG
+    LOGD() << "layout range " << stick.ticks() << " - " << etick.ticks()
+           << (isLayoutAll ? " (all)" : "")
+           << ": systems laid out: " << ctx.state().systemsLaidOut()
+           << ", reused: " << ctx.state().systemsReused()
+           << ", system distances reused: " << ctx.state().distancesReused()
+           << ", transient allocations: " << ctx.arena().stateInfo().totalAllocatedCount
+           << " in " << ctx.arena().stateInfo().totalBlockCount << " blocks";
+#endif
+
     //LOGDA() << DumpLayoutData::dump(score);
 }
@@ -246,7 +246,7 @@ void ScorePageViewLayout::layoutFinished(Score* score, LayoutContext& ctx)
     } else {
         Page* p = state.curSystem()->page();
         if (p && (p != state.page())) {
-            p->invalidateBspTree();
+            p->invalidateBspTreeSystems();
         }
     }
 
@@ -37,6 +37,7 @@
 #include "slurtielayout.h"
 
 #include "paint.h"
+#include "systemdrawcache.h"
 
 #include "log.h"
 
@@ -58,6 +59,11 @@ SizeF ScoreRenderer::pageSizeInch(const Score* score, const PaintOptions& opt) c
     return Paint::pageSizeInch(score, opt);
 }
 
+IScoreRenderer::PaintCachePtr ScoreRenderer::createPaintCache() const
+{
+    return std::make_shared<SystemDrawCache>();
+}
+
 void ScoreRenderer::paintScore(draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt) const
 {
     Paint::paintScore(painter, score, opt);
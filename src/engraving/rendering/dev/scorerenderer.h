@@ -38,6 +38,7 @@ public:
 
     SizeF pageSizeInch(const Score* score) const override;
     SizeF pageSizeInch(const Score* score, const PaintOptions& opt) const override;
+    PaintCachePtr createPaintCache() const override;
     void paintScore(draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt) const override;
     void paintItem(draw::Painter& painter, const EngravingItem* item) const override;
 
@@ -0,0 +1,314 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "systemdrawcache.h"
+
+#include <algorithm>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
+#include "dom/measurebase.h"
+#include "dom/mscore.h"
+#include "dom/page.h"
+#include "dom/score.h"
+#include "dom/system.h"
+
+#include "paint.h"
+
+#include "log.h"
+
+using namespace mu::draw;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering::dev;
+
+//! NOTE Recordings of the systems painted longest ago are dropped from this size on
+static constexpr size_t MAX_ENTRIES = 128;
+
+//! NOTE Systems larger than this many times the painted rect are not recorded,
+//! most of the recording would be out of sight
+static constexpr double MAX_SYSTEM_TO_DRAW_RECT_RATIO = 4.0;
+
+bool SystemDrawCache::DrawState::operator==(const DrawState& other) const
+{
+    return layoutId == other.layoutId
+           && appearanceId == other.appearanceId
+           && scoreAppearanceId == other.scoreAppearanceId
+           && pos == other.pos
+           && bbox == other.bbox
+           && staffY == other.staffY
+           && scaleX == other.scaleX
+           && scaleY == other.scaleY
+           && pixelRatio == other.pixelRatio
+           && warnPitchRange == other.warnPitchRange
+           && scoreInversionEnabled == other.scoreInversionEnabled
+           && colors == other.colors;
+}
+
+//---------------------------------------------------------
+//   configurationColors
+//    colors elements are drawn with, depending on their state
+//---------------------------------------------------------
+
+std::vector<Color> SystemDrawCache::configurationColors()
+{
+    std::vector<Color> colors {
+        configuration()->defaultColor(),
+        configuration()->invisibleColor(),
+        configuration()->scoreInversionColor(),
+        configuration()->formattingMarksColor(),
+    };
+
+    for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
+        colors.push_back(configuration()->selectionColor(voice, true, false));
+        colors.push_back(configuration()->selectionColor(voice, false, false));
+        colors.push_back(configuration()->selectionColor(voice, true, true));
+        colors.push_back(configuration()->highlightSelectionColor(voice));
+    }
+
+    return colors;
+}
+
+//---------------------------------------------------------
+//   drawState
+//---------------------------------------------------------
+
+SystemDrawCache::DrawState SystemDrawCache::drawState(const System* system, const Painter& painter, const std::vector<Color>& colors)
+{
+    DrawState state;
+    state.layoutId = system->layoutId();
+    state.appearanceId = system->appearanceId();
+    state.scoreAppearanceId = system->score()->appearanceId();
+    state.pos = system->pagePos();
+    state.bbox = system->ldata()->bbox();
+    for (const SysStaff* staff : system->staves()) {
+        state.staffY.push_back(staff->show() ? staff->y() : -1.0);
+    }
+
+    //! NOTE Images and bold text are drawn depending on the zoom
+    state.scaleX = painter.worldTransform().m11();
+    state.scaleY = painter.worldTransform().m22();
+
+    state.pixelRatio = MScore::pixelRatio;
+    state.warnPitchRange = MScore::warnPitchRange;
+    state.scoreInversionEnabled = configuration()->scoreInversionEnabled();
+    state.colors = colors;
+    return state;
+}
+
+//---------------------------------------------------------
+//   systemItems
+//    same elements as Page::scanElements() visits for the system,
+//    in drawing order
+//---------------------------------------------------------
+
+static void collectItem(void* data, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+}
+
+std::vector<EngravingItem*> SystemDrawCache::systemItems(const System* system)
+{
+    System* s = const_cast<System*>(system);
+
+    std::vector<EngravingItem*> items;
+    for (MeasureBase* m : s->measures()) {
+        m->scanElements(&items, collectItem, false);
+    }
+    s->scanElements(&items, collectItem, false);
+
+    std::sort(items.begin(), items.end(), elementLessThan);
+
+    items.erase(std::remove_if(items.begin(), items.end(), [](const EngravingItem* item) {
+        return !item->isInteractionAvailable() || item->ldata()->isSkipDraw();
+    }), items.end());
+
+    return items;
+}
+
+//---------------------------------------------------------
+//   record
+//---------------------------------------------------------
+
+void SystemDrawCache::record(Entry& entry, const std::vector<EngravingItem*>& items)
+{
+    TRACEFUNC;
+
+    ++m_recordsCount;
+
+    std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+    Painter painter(provider, "system");
+    painter.setAntialiasing(true);
+
+    //! NOTE Recorded at the zoom it is replayed with, see paintPage
+    Transform scale;
+    scale.scale(entry.state.scaleX, entry.state.scaleY);
+    painter.setWorldTransform(scale);
+
+    for (const EngravingItem* item : items) {
+        // one object per item, so that replay can skip the items out of sight
+        painter.beginObject(std::string());
+        Paint::paintItem(painter, item);
+        painter.endObject();
+    }
+
+    painter.endDraw();
+    entry.data = provider->drawData();
+}
+
+//---------------------------------------------------------
+//   entry
+//---------------------------------------------------------
+
+SystemDrawCache::Entry& SystemDrawCache::entry(const System* system)
+{
+    auto it = m_entries.find(system);
+    if (it == m_entries.end()) {
+        if (m_entries.size() >= MAX_ENTRIES) {
+            auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUsed < b.second.lastUsed;
+            });
+            m_entries.erase(oldest);
+        }
+        it = m_entries.emplace(system, Entry()).first;
+    }
+
+    Entry& e = it->second;
+    e.lastUsed = ++m_tick;
+    return e;
+}
+
+//---------------------------------------------------------
+//   removeStaleEntries
+//    drops the recordings of systems that are not in the score any more
+//---------------------------------------------------------
+
+void SystemDrawCache::removeStaleEntries(const Score* score)
+{
+    std::vector<const System*> systems(score->systems().begin(), score->systems().end());
+    std::sort(systems.begin(), systems.end());
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (std::binary_search(systems.begin(), systems.end(), it->first)) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   isCacheable
+//---------------------------------------------------------
+
+bool SystemDrawCache::isCacheable(const System* system, const RectF& drawRect)
+{
+    //! NOTE Systems laid out by the stable layout don't have a layout id,
+    //! there is nothing to tell whether they changed
+    if (system->layoutId() == 0) {
+        return false;
+    }
+
+    //! NOTE In continuous view the only system is the whole score,
+    //! it would be recorded again in full on each edit
+    if (system->score()->linearMode()) {
+        return false;
+    }
+
+    const RectF& bbox = system->ldata()->bbox();
+    return bbox.width() <= MAX_SYSTEM_TO_DRAW_RECT_RATIO * drawRect.width()
+           && bbox.height() <= MAX_SYSTEM_TO_DRAW_RECT_RATIO * drawRect.height();
+}
+
+//---------------------------------------------------------
+//   paintUncached
+//---------------------------------------------------------
+
+void SystemDrawCache::paintUncached(Painter& painter, const System* system, const RectF& drawRect)
+{
+    std::vector<EngravingItem*> items;
+    for (EngravingItem* item : systemItems(system)) {
+        if (item->pageBoundingRect().intersects(drawRect)) {
+            items.push_back(item);
+        }
+    }
+    Paint::paintItems(painter, items);
+}
+
+//---------------------------------------------------------
+//   paintPage
+//---------------------------------------------------------
+
+void SystemDrawCache::paintPage(Painter& painter, const Page* page, const RectF& drawRect)
+{
+    TRACEFUNC;
+
+    Paint::paintItem(painter, page);
+
+    const std::vector<Color> colors = configurationColors();
+
+    for (const System* system : page->systems()) {
+        if (!isCacheable(system, drawRect)) {
+            m_entries.erase(system);
+            paintUncached(painter, system, drawRect);
+            continue;
+        }
+
+        DrawState state = drawState(system, painter, colors);
+        Entry& e = entry(system);
+
+        std::vector<EngravingItem*> items;
+        if (e.state != state || e.itemRects.empty()) {
+            e.state = std::move(state);
+            e.data = nullptr;
+            e.itemRects.clear();
+            e.rect = RectF();
+
+            items = systemItems(system);
+            for (const EngravingItem* item : items) {
+                RectF r = item->pageBoundingRect();
+                e.itemRects.push_back(r);
+                e.rect.unite(r);
+            }
+        }
+
+        if (!e.rect.intersects(drawRect)) {
+            continue;
+        }
+
+        // systems out of sight are only recorded when they come into view
+        if (!e.data) {
+            if (items.empty()) {
+                items = systemItems(system);
+            }
+            record(e, items);
+        }
+
+        painter.save();
+        painter.scale(1.0 / e.state.scaleX, 1.0 / e.state.scaleY);
+        DrawDataPaint::replay(&painter, e.data, [&e, &drawRect](size_t i) {
+            return i < e.itemRects.size() && e.itemRects.at(i).intersects(drawRect);
+        });
+        painter.restore();
+    }
+
+    removeStaleEntries(page->score());
+}
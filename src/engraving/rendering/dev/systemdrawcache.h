@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SYSTEMDRAWCACHE_DEV_H
+#define MU_ENGRAVING_SYSTEMDRAWCACHE_DEV_H
+
+#include <map>
+#include <vector>
+
+#include "draw/painter.h"
+#include "draw/types/drawdata.h"
+
+#include "modularity/ioc.h"
+#include "iengravingconfiguration.h"
+#include "rendering/iscorerenderer.h"
+
+namespace mu::engraving {
+class EngravingItem;
+class Page;
+class Score;
+class System;
+}
+
+namespace mu::engraving::rendering::dev {
+//! NOTE Keeps the recorded drawing commands of each system, so that
+//! repainting the screen (scrolling, playback, editing another system)
+//! replays them instead of drawing every element again.
+//! A recording is used as long as the system was not laid out again
+//! and nothing that changes how its elements look has changed.
+//! Each view has its own cache, see IScoreRenderer::createPaintCache.
+//! Each system has at most one recording, at the zoom it was last
+//! painted with. Recordings of systems that left the score are dropped.
+class SystemDrawCache : public IScoreRenderer::PaintCache
+{
+    INJECT_STATIC(IEngravingConfiguration, configuration)
+
+public:
+    //! NOTE Draws the page and its systems, in page coordinates
+    void paintPage(draw::Painter& painter, const Page* page, const RectF& drawRect);
+
+    size_t entriesCount() const { return m_entries.size(); }
+    size_t recordsCount() const { return m_recordsCount; }     // recordings made so far
+
+private:
+
+    struct DrawState {
+        uint64_t layoutId = 0;
+        uint64_t appearanceId = 0;          // System::appearanceId()
+        uint64_t scoreAppearanceId = 0;     // Score::appearanceId()
+        PointF pos;
+        RectF bbox;
+        std::vector<double> staffY;
+        double scaleX = 1.0;
+        double scaleY = 1.0;
+        double pixelRatio = 1.0;
+        bool warnPitchRange = true;
+        bool scoreInversionEnabled = false;
+        std::vector<draw::Color> colors;
+
+        bool operator==(const DrawState& other) const;
+        bool operator!=(const DrawState& other) const { return !operator==(other); }
+    };
+
+    struct Entry {
+        DrawState state;
+        draw::DrawDataPtr data;
+        std::vector<RectF> itemRects;       // page bounding rect of each recorded item
+        RectF rect;                         // all of them
+        uint64_t lastUsed = 0;
+    };
+
+    static DrawState drawState(const System* system, const draw::Painter& painter, const std::vector<draw::Color>& colors);
+    static std::vector<draw::Color> configurationColors();
+    static std::vector<EngravingItem*> systemItems(const System* system);
+    static bool isCacheable(const System* system, const RectF& drawRect);
+    static void paintUncached(draw::Painter& painter, const System* system, const RectF& drawRect);
+
+    Entry& entry(const System* system);
+    void record(Entry& entry, const std::vector<EngravingItem*>& items);
+    void removeStaleEntries(const Score* score);
+
+    //! NOTE The keys are only compared, never dereferenced:
+    //! a new system at the address of a deleted one has another layout id
+    std::map<const System*, Entry> m_entries;
+    uint64_t m_tick = 0;
+    size_t m_recordsCount = 0;
+};
+}
+
+#endif // MU_ENGRAVING_SYSTEMDRAWCACHE_DEV_H
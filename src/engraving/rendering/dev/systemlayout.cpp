@@ -19,6 +19,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <atomic>
 #include <cfloat>
 
 #include "systemlayout.h"
@@ -75,6 +76,18 @@
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
+//---------------------------------------------------------
+//   invalidateSystemLayout
+//    gives the system a new layout id, so that anything
+//    cached from its previous layout is not reused
+//---------------------------------------------------------
+
+static void invalidateSystemLayout(System* system)
+{
+    static std::atomic<uint64_t> lastLayoutId { 0 };
+    system->setLayoutId(++lastLayoutId);
+}
+
 //---------------------------------------------------------
 //   collectSystem
 //---------------------------------------------------------
@@ -358,7 +371,9 @@ System* SystemLayout::collectSystem(LayoutContext& ctx)
         // ElementType nt = lc.curMeasure ? lc.curMeasure->type() : ElementType::INVALID;
         mb = ctx.state().curMeasure();
         bool tooWide = false;     // curSysWidth + minMeasureWidth > systemWidth;  // TODO: noBreak
-        if (lineBreak || !mb || mb->isVBox() || mb->isTBox() || mb->isFBox() || tooWide) {
+        // the system ended here when the score was saved, no need to try if the next measure fits
+        bool cachedBreak = mb && ctx.conf().isMode(LayoutMode::PAGE) && ctx.dom().isSystemStartHint(mb);
+        if (lineBreak || !mb || mb->isVBox() || mb->isTBox() || mb->isFBox() || tooWide || cachedBreak) {
             break;
         }
     }
@@ -540,31 +555,10 @@ void SystemLayout::justifySystem(System* system, double curSysWidth, double targ
         return;
     }
 
-    std::vector<Spring> springs;
-
-    for (MeasureBase* mb : system->measures()) {
-        if (!mb->isMeasure()) {
-            continue;
-        }
-        for (Segment& s : toMeasure(mb)->segments()) {
-            if (s.isChordRestType() && s.ticks() > Fraction(0, 1) && s.visible() && s.enabled() && !s.allElementsInvisible()) {
-                double springConst = 1 / s.stretch();
-                double width = s.width() - s.widthOffset();
-                double preTension = width * springConst;
-                springs.push_back(Spring(springConst, width, preTension, &s));
-            }
-        }
-    }
-
-    Segment::stretchSegmentsToWidth(springs, rest);
-
-    for (MeasureBase* mb : system->measures()) {
-        if (!mb->isMeasure()) {
-            continue;
-        }
-        Measure* m = toMeasure(mb);
-        m->respaceSegments();
-    }
+    HorizontalSpacing::SegmentsSnapshot snapshot = HorizontalSpacing::takeSnapshot(system);
+    HorizontalSpacing::stretchSegmentsToWidth(snapshot, rest);
+    HorizontalSpacing::respaceSegments(snapshot);
+    HorizontalSpacing::applySnapshot(snapshot);
 }
 
 //---------------------------------------------------------
@@ -584,6 +578,8 @@ System* SystemLayout::getNextSystem(LayoutContext& ctx)
         system->clear();       // remove measures from system
     }
     ctx.mutDom().systems().push_back(system);
+    ctx.mutState().incSystemsLaidOut();
+    invalidateSystemLayout(system);
     if (!isVBox) {
         size_t nstaves = ctx.dom().nstaves();
         system->adjustStavesNumber(nstaves);
@@ -717,15 +713,20 @@ void SystemLayout::hideEmptyStaves(System* system, LayoutContext& ctx, bool isFi
 
 void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
 {
+    invalidateSystemLayout(system);
+
     if (ctx.dom().nstaves() == 0) {
         return;
     }
 
+    // transient lists of this system are given back at the end
+    ArenaAllocator::Scope arenaScope(ctx.arena());
+
     //-------------------------------------------------------------
     //    create cr segment list to speed up computations
     //-------------------------------------------------------------
 
-    std::vector<Segment*> sl;
+    LayoutVector<Segment*> sl(ctx.arena());
     for (MeasureBase* mb : system->measures()) {
         if (!mb->isMeasure()) {
             continue;
@@ -975,7 +976,7 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     //-------------------------------------------------------------
 
     // slurs
-    std::vector<Spanner*> spanner;
+    LayoutVector<Spanner*> spanner(ctx.arena());
     for (auto interval : spanners) {
         Spanner* sp = interval.value;
         if (sp->staff() && !sp->staff()->show()) {
@@ -1021,7 +1022,7 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     // Dynamics and figured bass
     //-------------------------------------------------------------
 
-    std::vector<EngravingItem*> dynamicsAndFigBass;
+    LayoutVector<EngravingItem*> dynamicsAndFigBass(ctx.arena());
     for (Segment* s : sl) {
         for (EngravingItem* e : s->annotations()) {
             if (e->isDynamic() || e->isFiguredBass()) {
@@ -1075,11 +1076,11 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     //-------------------------------------------------------------
 
     spanner.clear();
-    std::vector<Spanner*> hairpins;
-    std::vector<Spanner*> ottavas;
-    std::vector<Spanner*> pedal;
-    std::vector<Spanner*> voltas;
-    std::vector<Spanner*> tempoChangeLines;
+    LayoutVector<Spanner*> hairpins(ctx.arena());
+    LayoutVector<Spanner*> ottavas(ctx.arena());
+    LayoutVector<Spanner*> pedal(ctx.arena());
+    LayoutVector<Spanner*> voltas(ctx.arena());
+    LayoutVector<Spanner*> tempoChangeLines(ctx.arena());
 
     for (auto interval : spanners) {
         Spanner* sp = interval.value;
@@ -1332,7 +1333,8 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     }
 }
 
-void SystemLayout::doLayoutTies(System* system, std::vector<Segment*> sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx)
+void SystemLayout::doLayoutTies(System* system, const LayoutVector<Segment*>& sl, const Fraction& stick, const Fraction& etick,
+                                LayoutContext& ctx)
 {
     UNUSED(etick);
 
@@ -1372,7 +1374,7 @@ void SystemLayout::doLayoutTiesLinear(System* system, LayoutContext& ctx)
     }
 }
 
-void SystemLayout::layoutGuitarBends(const std::vector<Segment*>& sl, LayoutContext& ctx)
+void SystemLayout::layoutGuitarBends(const LayoutVector<Segment*>& sl, LayoutContext& ctx)
 {
     auto doLayoutGuitarBends = [&] (Chord* chord) {
         for (Note* note : chord->notes()) {
@@ -1416,9 +1418,9 @@ void SystemLayout::layoutGuitarBends(const std::vector<Segment*>& sl, LayoutCont
     }
 }
 
-void SystemLayout::processLines(System* system, LayoutContext& ctx, std::vector<Spanner*> lines, bool align)
+void SystemLayout::processLines(System* system, LayoutContext& ctx, const LayoutVector<Spanner*>& lines, bool align)
 {
-    std::vector<SpannerSegment*> segments;
+    LayoutVector<SpannerSegment*> segments(ctx.arena());
     for (Spanner* sp : lines) {
         SpannerSegment* ss = TLayout::layoutSystem(sp, system, ctx);        // create/layout spanner segment for this system
         if (ss->autoplace()) {
@@ -1666,7 +1668,11 @@ void SystemLayout::updateCrossBeams(System* system, LayoutContext& ctx)
 
 void SystemLayout::restoreTiesAndBends(System* system, LayoutContext& ctx)
 {
-    std::vector<Segment*> segList;
+    invalidateSystemLayout(system);
+
+    ArenaAllocator::Scope arenaScope(ctx.arena());
+
+    LayoutVector<Segment*> segList(ctx.arena());
     for (MeasureBase* mb : system->measures()) {
         if (!mb->isMeasure()) {
             continue;
@@ -1765,28 +1771,19 @@ void SystemLayout::manageNarrowSpacing(System* system, LayoutContext& ctx, doubl
     }
 
     // Things don't fit without collisions, so give up and allow collisions
+    HorizontalSpacing::SegmentsSnapshot snapshot = HorizontalSpacing::takeSnapshot(system);
     double smallerStep = 0.25 * step;
     double widthReduction = 1 - smallerStep;
     while (curSysWidth > targetSysWidth && RealIsEqualOrMore(widthReduction, 0.0)) {
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            if (snapshot.flags[i] & HorizontalSpacing::SegmentsSnapshot::CHORDREST) {
+                snapshot.width[i] *= widthReduction;
             }
-
-            Measure* m = toMeasure(mb);
-            double prevWidth = m->width();
-            for (Segment& segment : m->segments()) {
-                if (!segment.isChordRestType()) {
-                    continue;
-                }
-                double curSegmentWidth = segment.width();
-                segment.setWidth(curSegmentWidth * widthReduction);
-            }
-            m->respaceSegments();
-            curSysWidth += m->width() - prevWidth;
         }
+        curSysWidth += HorizontalSpacing::respaceSegments(snapshot);
         widthReduction -= smallerStep;
     }
+    HorizontalSpacing::applySnapshot(snapshot);
 }
 
 void SystemLayout::layoutSystem(System* system, LayoutContext& ctx, double xo1, const bool isFirstSystem, bool firstSystemIndent)
@@ -2177,6 +2174,8 @@ void SystemLayout::layout2(System* system, LayoutContext& ctx)
     TRACEFUNC;
     LAYOUT_CALL() << LAYOUT_ITEM_INFO(system);
 
+    invalidateSystemLayout(system);
+
     Box* vb = system->vbox();
     if (vb) {
         TLayout::layoutBox(vb, vb->mutldata(), ctx);
@@ -2551,6 +2550,67 @@ void SystemLayout::setInstrumentNames(System* system, LayoutContext& ctx, bool l
 //---------------------------------------------------------
 
 double SystemLayout::minDistance(const System* top, const System* bottom, const LayoutContext& ctx)
+{
+    if (top->vbox() || bottom->vbox() || top->staves().empty() || bottom->staves().empty()) {
+        return computeMinDistance(top, bottom, ctx);
+    }
+
+    // Systems outside of the relayout range keep their layout id,
+    // so the distance between two of them can be taken from the previous layout,
+    // unless the style or the staves it depends on have changed since
+    const LayoutConfiguration& conf = ctx.conf();
+    System::MinDistanceCache key;
+    key.topLayoutId = top->layoutId();
+    key.layoutId = bottom->layoutId();
+    visibleStaffRange(top, bottom, ctx, key.firstStaff, key.lastStaff);
+    key.minVerticalDistance = conf.styleMM(Sid::minVerticalDistance);
+    key.minSystemDistance = conf.isVerticalSpreadEnabled() ? conf.styleMM(Sid::minSystemSpread) : conf.styleMM(Sid::minSystemDistance);
+    if (const Staff* staff = ctx.dom().staff(key.firstStaff)) {
+        key.minSystemDistance = std::max(key.minSystemDistance, staff->userDist().val());
+    }
+
+    const System::MinDistanceCache& cache = bottom->minDistanceCache();
+    if (top->layoutId() != 0
+        && cache.topLayoutId == key.topLayoutId && cache.layoutId == key.layoutId
+        && cache.firstStaff == key.firstStaff && cache.lastStaff == key.lastStaff
+        && RealIsEqual(cache.minVerticalDistance, key.minVerticalDistance)
+        && RealIsEqual(cache.minSystemDistance, key.minSystemDistance)) {
+        top->setFixedDownDistance(cache.topFixedDownDistance);
+        ctx.state().incDistancesReused();
+        return cache.distance;
+    }
+
+    key.distance = computeMinDistance(top, bottom, ctx);
+    key.topFixedDownDistance = top->hasFixedDownDistance();
+    bottom->setMinDistanceCache(key);
+
+    return key.distance;
+}
+
+//---------------------------------------------------------
+//   visibleStaffRange
+//    the first and last staves shown in both systems,
+//    the distance is measured between their skylines
+//---------------------------------------------------------
+
+void SystemLayout::visibleStaffRange(const System* top, const System* bottom, const LayoutContext& ctx,
+                                     staff_idx_t& firstStaff, staff_idx_t& lastStaff)
+{
+    const DomAccessor& dom = ctx.dom();
+
+    for (firstStaff = 0; firstStaff < top->staves().size() - 1; ++firstStaff) {
+        if (dom.staff(firstStaff)->show() && bottom->staff(firstStaff)->show()) {
+            break;
+        }
+    }
+    for (lastStaff = top->staves().size() - 1; lastStaff > 0; --lastStaff) {
+        if (dom.staff(lastStaff)->show() && top->staff(lastStaff)->show()) {
+            break;
+        }
+    }
+}
+
+double SystemLayout::computeMinDistance(const System* top, const System* bottom, const LayoutContext& ctx)
 {
     TRACEFUNC;
 
@@ -2571,19 +2631,9 @@ double SystemLayout::minDistance(const System* top, const System* bottom, const
 
     double minVerticalDistance = conf.styleMM(Sid::minVerticalDistance);
     double dist = conf.isVerticalSpreadEnabled() ? conf.styleMM(Sid::minSystemSpread) : conf.styleMM(Sid::minSystemDistance);
-    size_t firstStaff = 0;
-    size_t lastStaff = 0;
-
-    for (firstStaff = 0; firstStaff < top->staves().size() - 1; ++firstStaff) {
-        if (dom.staff(firstStaff)->show() && bottom->staff(firstStaff)->show()) {
-            break;
-        }
-    }
-    for (lastStaff = top->staves().size() - 1; lastStaff > 0; --lastStaff) {
-        if (dom.staff(lastStaff)->show() && top->staff(lastStaff)->show()) {
-            break;
-        }
-    }
+    staff_idx_t firstStaff = 0;
+    staff_idx_t lastStaff = 0;
+    visibleStaffRange(top, bottom, ctx, firstStaff, lastStaff);
 
     const Staff* staff = dom.staff(firstStaff);
     double userDist = staff ? staff->userDist() : 0.0;
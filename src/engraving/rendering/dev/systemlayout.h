@@ -61,11 +61,15 @@ public:
 
 private:
     static System* getNextSystem(LayoutContext& lc);
-    static void processLines(System* system, LayoutContext& ctx, std::vector<Spanner*> lines, bool align);
+    static double computeMinDistance(const System* top, const System* bottom, const LayoutContext& ctx);
+    static void visibleStaffRange(const System* top, const System* bottom, const LayoutContext& ctx, staff_idx_t& firstStaff,
+                                  staff_idx_t& lastStaff);
+    static void processLines(System* system, LayoutContext& ctx, const LayoutVector<Spanner*>& lines, bool align);
     static void layoutTies(Chord* ch, System* system, const Fraction& stick, LayoutContext& ctx);
-    static void doLayoutTies(System* system, std::vector<Segment*> sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx);
+    static void doLayoutTies(System* system, const LayoutVector<Segment*>& sl, const Fraction& stick, const Fraction& etick,
+                             LayoutContext& ctx);
     static void doLayoutTiesLinear(System* system, LayoutContext& ctx);
-    static void layoutGuitarBends(const std::vector<Segment*>& sl, LayoutContext& ctx);
+    static void layoutGuitarBends(const LayoutVector<Segment*>& sl, LayoutContext& ctx);
     static void justifySystem(System* system, double curSysWidth, double targetSystemWidth);
     static void updateCrossBeams(System* system, LayoutContext& ctx);
     static void restoreTiesAndBends(System* system, LayoutContext& ctx);
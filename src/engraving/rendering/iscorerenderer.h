@@ -22,6 +22,7 @@
 #ifndef MU_ENGRAVING_ISCORERENDERER_H
 #define MU_ENGRAVING_ISCORERENDERER_H
 
+#include <memory>
 #include <variant>
 
 #include "modularity/imoduleinterface.h"
@@ -98,6 +99,15 @@ public:
 
     virtual void layoutScore(Score* score, const Fraction& st, const Fraction& et) const = 0;
 
+    //! NOTE What the renderer keeps between the paints of one view,
+    //! e.g. the recorded drawing of its systems. Owned by the view.
+    class PaintCache
+    {
+    public:
+        virtual ~PaintCache() = default;
+    };
+    using PaintCachePtr = std::shared_ptr<PaintCache>;
+
     struct PaintOptions
     {
         bool isSetViewport = true;
@@ -110,6 +120,7 @@ public:
         int copyCount = 1;
         int trimMarginPixelSize = -1;
         int deviceDpi = -1;
+        PaintCachePtr cache; // of the view, to replay the recorded drawing of unchanged systems (screen only)
 
         std::function<void(draw::Painter* painter, const Page* page, const RectF& pageRect)> onPaintPageSheet;
         std::function<void()> onNewPage;
@@ -117,6 +128,7 @@ public:
 
     virtual SizeF pageSizeInch(const Score* score) const = 0;
     virtual SizeF pageSizeInch(const Score* score, const PaintOptions& opt) const = 0;
+    virtual PaintCachePtr createPaintCache() const = 0;
     virtual void paintScore(draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt) const = 0;
     virtual void paintItem(draw::Painter& painter, const EngravingItem* item) const = 0;
 
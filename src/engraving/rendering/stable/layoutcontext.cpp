@@ -376,6 +376,14 @@ void DomAccessor::removeElement(EngravingItem* item)
     score()->removeElement(item);
 }
 
+void DomAccessor::invalidateTickIndex()
+{
+    IF_ASSERT_FAILED(score()) {
+        return;
+    }
+    score()->measures()->invalidateTickIndex();
+}
+
 void DomAccessor::addUnmanagedSpanner(Spanner* s)
 {
     IF_ASSERT_FAILED(score()) {
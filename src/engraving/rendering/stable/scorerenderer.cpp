@@ -58,6 +58,12 @@ SizeF ScoreRenderer::pageSizeInch(const Score* score, const PaintOptions& opt) c
     return Paint::pageSizeInch(score, opt);
 }
 
+IScoreRenderer::PaintCachePtr ScoreRenderer::createPaintCache() const
+{
+    //! NOTE The stable layout doesn't tell which systems have changed
+    return nullptr;
+}
+
 void ScoreRenderer::paintScore(draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt) const
 {
     Paint::paintScore(painter, score, opt);
@@ -38,23 +38,25 @@ using namespace mu;
 using namespace mu::engraving::compat;
 using namespace mu::engraving;
 
-static int readStyleDefaultsVersion(MasterScore* score, const ByteArray& scoreData, const String& completeBaseName)
+static int readStyleDefaultsVersion(MasterScore* score, io::IODevice* scoreDevice, const String& completeBaseName)
 {
-    XmlReader e(scoreData);
-    e.setDocName(completeBaseName);
-
-    while (!e.atEnd()) {
-        e.readNext();
-        if (e.name() == "defaultsVersion") {
-            return e.readInt();
+    if (scoreDevice) {
+        XmlReader e(scoreDevice);
+        e.setDocName(completeBaseName);
+
+        while (!e.atEnd()) {
+            e.readNext();
+            if (e.name() == "defaultsVersion") {
+                return e.readInt();
+            }
         }
     }
 
     return ReadStyleHook::styleDefaultByMscVersion(score->mscVersion());
 }
 
-ReadStyleHook::ReadStyleHook(Score* score, const ByteArray& scoreData, const String& completeBaseName)
-    : m_score(score), m_scoreData(scoreData), m_completeBaseName(completeBaseName)
+ReadStyleHook::ReadStyleHook(Score* score, io::IODevice* scoreDevice, const String& completeBaseName)
+    : m_score(score), m_scoreDevice(scoreDevice), m_completeBaseName(completeBaseName)
 {
 }
 
@@ -92,7 +94,7 @@ void ReadStyleHook::setupDefaultStyle()
 
     int defaultsVersion = -1;
     if (m_score->isMaster()) {
-        defaultsVersion = readStyleDefaultsVersion(m_score->masterScore(), m_scoreData, m_completeBaseName);
+        defaultsVersion = readStyleDefaultsVersion(m_score->masterScore(), m_scoreDevice, m_completeBaseName);
     } else {
         defaultsVersion = m_score->masterScore()->style().defaultStyleVersion();
     }
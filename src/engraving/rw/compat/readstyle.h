@@ -23,7 +23,7 @@
 #ifndef MU_ENGRAVING_READSTYLE_H
 #define MU_ENGRAVING_READSTYLE_H
 
-#include "types/bytearray.h"
+#include "io/iodevice.h"
 #include "types/string.h"
 
 namespace mu::engraving {
@@ -36,7 +36,9 @@ namespace mu::engraving::compat {
 class ReadStyleHook
 {
 public:
-    ReadStyleHook(Score* score, const ByteArray& scoreData, const String& completeBaseName);
+    //! NOTE The score is read again from its own device (if the default style is needed),
+    //! the device should be at the beginning
+    ReadStyleHook(Score* score, io::IODevice* scoreDevice, const String& completeBaseName);
 
     void setupDefaultStyle();
 
@@ -49,7 +51,7 @@ public:
 
 private:
     Score* m_score = nullptr;
-    const ByteArray& m_scoreData;
+    io::IODevice* m_scoreDevice = nullptr;
     const String& m_completeBaseName;
 };
 }
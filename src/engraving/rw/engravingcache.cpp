@@ -0,0 +1,233 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "engravingcache.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dom/measure.h"
+#include "dom/page.h"
+#include "dom/score.h"
+#include "dom/system.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const char MAGIC[4] = { 'M', 'S', 'E', 'C' };
+
+//---------------------------------------------------------
+//   little endian, whatever the platform is
+//---------------------------------------------------------
+
+static void putU32(ByteArray& out, uint32_t v)
+{
+    const uint8_t b[4] = { uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24) };
+    out.push_back(b, sizeof(b));
+}
+
+static void putU64(ByteArray& out, uint64_t v)
+{
+    putU32(out, uint32_t(v));
+    putU32(out, uint32_t(v >> 32));
+}
+
+struct BinaryInput {
+    const uint8_t* pos = nullptr;
+    const uint8_t* end = nullptr;
+    bool ok = true;
+
+    bool has(size_t size)
+    {
+        ok = ok && size_t(end - pos) >= size;
+        return ok;
+    }
+
+    uint32_t u32()
+    {
+        if (!has(4)) {
+            return 0;
+        }
+        uint32_t v = uint32_t(pos[0]) | uint32_t(pos[1]) << 8 | uint32_t(pos[2]) << 16 | uint32_t(pos[3]) << 24;
+        pos += 4;
+        return v;
+    }
+
+    uint64_t u64()
+    {
+        uint64_t lo = u32();
+        uint64_t hi = u32();
+        return lo | hi << 32;
+    }
+};
+
+//---------------------------------------------------------
+//   hash
+//---------------------------------------------------------
+
+uint64_t EngravingCache::hash(const uint8_t* data, size_t size, uint64_t h)
+{
+    for (size_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+uint64_t EngravingCache::contentHash(const ByteArray& styleData, const ByteArray& scoreData, const ByteArray& chordListData)
+{
+    return hash(chordListData, hash(scoreData, hash(styleData)));
+}
+
+//---------------------------------------------------------
+//   fromScore
+//---------------------------------------------------------
+
+EngravingCache EngravingCache::fromScore(const Score* score, uint64_t contentHash)
+{
+    EngravingCache cache;
+    cache.m_contentHash = contentHash;
+    cache.m_revision = MUSESCORE_REVISION;
+
+    std::unordered_map<const MeasureBase*, uint32_t> indexes;
+    uint32_t index = 0;
+    for (const MeasureBase* mb = score->first(); mb; mb = mb->next()) {
+        indexes[mb] = index++;
+    }
+
+    for (const Page* page : score->pages()) {
+        for (const engraving::System* system : page->systems()) {
+            if (system->measures().empty()) {
+                continue;
+            }
+
+            const MeasureBase* first = system->measures().front();
+
+            if (first->isMeasure() && toMeasure(first)->isMMRest()) {
+                first = toMeasure(first)->mmRestFirst();
+            }
+
+            auto it = indexes.find(first);
+            if (it == indexes.end()) {
+                continue;
+            }
+
+            cache.m_systems.push_back({ it->second });
+        }
+    }
+
+    return cache;
+}
+
+//---------------------------------------------------------
+//   toBinary
+//---------------------------------------------------------
+
+ByteArray EngravingCache::toBinary() const
+{
+    ByteArray out;
+    out.reserve(32 + m_revision.size() + m_systems.size() * 4);
+
+    out.push_back(reinterpret_cast<const uint8_t*>(MAGIC), sizeof(MAGIC));
+    putU32(out, FORMAT_VERSION);
+    putU64(out, m_contentHash);
+    putU32(out, uint32_t(m_revision.size()));
+    out.push_back(reinterpret_cast<const uint8_t*>(m_revision.data()), m_revision.size());
+
+    putU32(out, uint32_t(m_systems.size()));
+    for (const System& s : m_systems) {
+        putU32(out, s.firstMeasure);
+    }
+
+    return out;
+}
+
+//---------------------------------------------------------
+//   fromBinary
+//---------------------------------------------------------
+
+bool EngravingCache::fromBinary(const ByteArray& data, EngravingCache& cache)
+{
+    BinaryInput in { data.constData(), data.constData() + data.size() };
+
+    if (!in.has(sizeof(MAGIC)) || std::memcmp(in.pos, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    in.pos += sizeof(MAGIC);
+
+    if (in.u32() != FORMAT_VERSION) {
+        // written by another version of the format, not an error
+        return false;
+    }
+
+    cache.m_contentHash = in.u64();
+
+    const uint32_t revisionSize = in.u32();
+    if (!in.has(revisionSize)) {
+        return false;
+    }
+    cache.m_revision.assign(reinterpret_cast<const char*>(in.pos), revisionSize);
+    in.pos += revisionSize;
+
+    const uint32_t count = in.u32();
+    if (!in.has(size_t(count) * 4)) {
+        LOGW() << "engraving cache is truncated";
+        return false;
+    }
+
+    cache.m_systems.resize(count);
+    for (System& s : cache.m_systems) {
+        s.firstMeasure = in.u32();
+    }
+
+    return in.ok;
+}
+
+bool EngravingCache::isCurrentRevision() const
+{
+    return m_revision == MUSESCORE_REVISION;
+}
+
+//---------------------------------------------------------
+//   applyTo
+//---------------------------------------------------------
+
+void EngravingCache::applyTo(Score* score) const
+{
+    std::unordered_set<const MeasureBase*> starts;
+    starts.reserve(m_systems.size());
+
+    auto system = m_systems.cbegin();
+    uint32_t index = 0;
+    for (const MeasureBase* mb = score->first(); mb && system != m_systems.cend(); mb = mb->next(), ++index) {
+        while (system != m_systems.cend() && system->firstMeasure < index) {
+            ++system;
+        }
+        if (system != m_systems.cend() && system->firstMeasure == index) {
+            starts.insert(mb);
+        }
+    }
+
+    score->setSystemStartHints(std::move(starts));
+}
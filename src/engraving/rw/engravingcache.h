@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ENGRAVINGCACHE_H
+#define MU_ENGRAVING_ENGRAVINGCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "types/bytearray.h"
+#include "types/string.h"
+
+namespace mu::engraving {
+class Score;
+
+//! NOTE The layout of the score as it was when the .mscz was saved, stored next to the score file.
+//! When the same score is opened again with the same version of the program,
+//! the layout knows where the systems ended and doesn't try one more measure for each of them.
+//!
+//! Binary, little endian, no pointers, all the data is in the order:
+//!     "MSEC", format version (u32), content hash (u64), program revision (u32 size, bytes),
+//!     systems count (u32), for each system: first measure (u32, index in the list of measures and frames)
+class EngravingCache
+{
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    struct System {
+        uint32_t firstMeasure = 0;
+    };
+
+    //! NOTE FNV-1a, continues from the given hash
+    static uint64_t hash(const uint8_t* data, size_t size, uint64_t h = HASH_SEED);
+    static uint64_t hash(const ByteArray& data, uint64_t h = HASH_SEED) { return hash(data.constData(), data.size(), h); }
+
+    //! NOTE The files the layout after reading depends on: style, score and chord list, in this order
+    static uint64_t contentHash(const ByteArray& styleData, const ByteArray& scoreData, const ByteArray& chordListData);
+
+    static EngravingCache fromScore(const Score* score, uint64_t contentHash);
+
+    ByteArray toBinary() const;
+    static bool fromBinary(const ByteArray& data, EngravingCache& cache);
+
+    //! NOTE Written by this version of the program
+    bool isCurrentRevision() const;
+
+    uint64_t contentHash() const { return m_contentHash; }
+    const std::vector<System>& systems() const { return m_systems; }
+
+    //! NOTE Gives the score the measures which started a system
+    void applyTo(Score* score) const;
+
+private:
+    static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+
+    uint64_t m_contentHash = 0;
+    std::string m_revision;
+    std::vector<System> m_systems;
+};
+}
+
+#endif // MU_ENGRAVING_ENGRAVINGCACHE_H
@@ -33,10 +33,12 @@
 #include "../dom/audio.h"
 #include "../dom/excerpt.h"
 #include "../dom/imageStore.h"
+#include "../dom/staff.h"
 
 #include "compat/compatutils.h"
 #include "compat/readstyle.h"
 
+#include "engravingcache.h"
 #include "rwregister.h"
 #include "xmlreader.h"
 #include "inoutdata.h"
@@ -71,8 +73,47 @@ static RetVal<IReaderPtr> makeReader(int version, bool ignoreVersionError)
     return RetVal<IReaderPtr>::make_ok(RWRegister::reader(version));
 }
 
+//---------------------------------------------------------
+//   HashingDevice
+//    reads through another device, hashing what is read
+//---------------------------------------------------------
+
+class HashingDevice : public IODevice
+{
+public:
+    HashingDevice(IODevice* device, uint64_t hash)
+        : m_device(device), m_hash(hash) {}
+
+    uint64_t hash() const { return m_hash; }
+
+    void readToEnd()
+    {
+        uint8_t buf[16 * 1024];
+        while (read(buf, sizeof(buf)) > 0) {
+        }
+    }
+
+protected:
+    bool doOpen(OpenMode m) override { return m == ReadOnly && (m_device->isOpen() || m_device->open(m)); }
+    size_t dataSize() const override { return m_device->size(); }
+    const uint8_t* rawData() const override { return nullptr; }
+    bool resizeData(size_t) override { return false; }
+    size_t writeData(const uint8_t*, size_t) override { return 0; }
+
+    size_t fetchData(uint8_t* data, size_t len) override
+    {
+        const size_t n = m_device->read(data, len);
+        m_hash = EngravingCache::hash(data, n, m_hash);
+        return n;
+    }
+
+private:
+    IODevice* m_device = nullptr;
+    uint64_t m_hash = 0;
+};
+
 mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, SettingsCompat& settingsCompat,
-                            bool ignoreVersionError)
+                            bool ignoreVersionError, bool lazyExcerpts)
 {
     TRACEFUNC;
 
@@ -84,9 +125,12 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
 
     ScoreLoad sl;
 
+    ByteArray styleData;
+    ByteArray chordListData;
+
     // Read style
     {
-        ByteArray styleData = mscReader.readStyleFile();
+        styleData = mscReader.readStyleFile();
         if (!styleData.empty()) {
             Buffer buf(&styleData);
             buf.open(IODevice::ReadOnly);
@@ -96,7 +140,7 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
 
     // Read ChordList
     {
-        ByteArray chordListData = mscReader.readChordListFile();
+        chordListData = mscReader.readChordListFile();
         if (!chordListData.empty()) {
             Buffer buf(&chordListData);
             buf.open(IODevice::ReadOnly);
@@ -120,85 +164,262 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
 
     // Read score
     {
-        ByteArray scoreData = mscReader.readScoreFile();
+        //! NOTE The score is parsed as it is decompressed, the style hook reads it again (if needed) from its own device
+        std::unique_ptr<IODevice> scoreDevice = mscReader.openScoreFile();
+        std::unique_ptr<IODevice> styleHookDevice = mscReader.openScoreFile();
         String docName = masterScore->fileInfo()->fileName().toString();
 
-        compat::ReadStyleHook styleHook(masterScore, scoreData, docName);
+        compat::ReadStyleHook styleHook(masterScore, styleHookDevice.get(), docName);
+
+        //! NOTE The engraving cache is valid if the files it was made of are the same,
+        //! the score file is hashed as it's read
+        EngravingCache cache;
+        std::unique_ptr<HashingDevice> hashingDevice;
+        if (scoreDevice && EngravingCache::fromBinary(mscReader.readEngravingCacheFile(), cache) && cache.isCurrentRevision()) {
+            hashingDevice = std::make_unique<HashingDevice>(scoreDevice.get(), EngravingCache::hash(styleData));
+            hashingDevice->open(IODevice::ReadOnly);
+        }
 
-        XmlReader xml(scoreData);
+        XmlReader xml(hashingDevice ? hashingDevice.get() : scoreDevice.get());
         xml.setDocName(docName);
 
         ret = readMasterScore(masterScore, xml, ignoreVersionError, &masterReadOutData, &styleHook);
+
+        if (ret && hashingDevice) {
+            hashingDevice->readToEnd();
+            if (EngravingCache::hash(chordListData, hashingDevice->hash()) == cache.contentHash()) {
+                cache.applyTo(masterScore);
+            } else {
+                LOGD() << "engraving cache is outdated";
+            }
+        }
     }
 
     // Read excerpts
     if (ret && masterScore->mscVersion() >= 400) {
-        std::vector<String> excerptFileNames = mscReader.excerptFileNames();
-        for (const String& excerptFileName : excerptFileNames) {
-            Score* partScore = masterScore->createScore();
+        ret = readExcerpts(masterScore, mscReader, masterReadOutData.links, ignoreVersionError, lazyExcerpts);
+    }
 
-            compat::ReadStyleHook::setupDefaultStyle(partScore);
+    // Compatibility conversions
+    // NOTE: must be done after all score and parts have been read
+    compat::CompatUtils::doCompatibilityConversions(masterScore);
 
-            Excerpt* ex = new Excerpt(masterScore);
-            ex->setExcerptScore(partScore);
-            ex->setFileName(excerptFileName);
+    //  Read audio
+    {
+        if (masterScore->audio()) {
+            ByteArray dbuf1 = mscReader.readAudioFile();
+            masterScore->audio()->setData(dbuf1);
+        }
+    }
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptFileName);
-            Buffer excerptStyleBuf(&excerptStyleData);
-            excerptStyleBuf.open(IODevice::ReadOnly);
-            partScore->style().read(&excerptStyleBuf);
+    settingsCompat = std::move(masterReadOutData.settingsCompat);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptFileName);
+    return ret;
+}
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptFileName);
+//---------------------------------------------------------
+//   ExcerptHeader
+//    what is known of an excerpt before its score is read
+//---------------------------------------------------------
+
+struct ExcerptHeader {
+    String name;
+    String partName;        // "partName" meta tag, used when there is no name
+    ID initialPartId;
+    bool open = false;
+    std::vector<int> linkedStaves; // master staves the staves of the excerpt are linked to
+};
+
+//---------------------------------------------------------
+//   readExcerptHeader
+//    the tags before the first measure, that's where the parts are
+//---------------------------------------------------------
+
+static ExcerptHeader readExcerptHeader(const ByteArray& data)
+{
+    ExcerptHeader header;
 
-            ReadInOutData partReadInData;
-            partReadInData.links = masterReadOutData.links;
+    XmlReader e(data);
+    while (e.readNextStartElement()) {
+        const AsciiStringView tag(e.name());
+        if (tag == "museScore") {
+            continue;
+        } else if (tag != "Score") {
+            e.skipCurrentElement();
+            continue;
+        }
 
-            RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
-            if (!reader.ret) {
-                ret = reader.ret;
-                break;
+        while (e.readNextStartElement()) {
+            const AsciiStringView stag(e.name());
+            if (stag == "name") {
+                header.name = e.readText();
+            } else if (stag == "metaTag" && e.attribute("name") == u"partName") {
+                header.partName = e.readText();
+            } else if (stag == "initialPartId") {
+                header.initialPartId = ID(e.readInt());
+            } else if (stag == "open") {
+                header.open = e.readBool();
+            } else if (stag == "Part") {
+                while (e.readNextStartElement()) {
+                    if (e.name() != "Staff") {
+                        e.skipCurrentElement();
+                        continue;
+                    }
+                    while (e.readNextStartElement()) {
+                        if (e.name() == "linkedTo") {
+                            header.linkedStaves.push_back(e.readInt() - 1);
+                        } else {
+                            e.skipCurrentElement();
+                        }
+                    }
+                }
+            } else if (stag == "Staff") {
+                // measures follow, nothing more is needed
+                return header;
+            } else {
+                e.skipCurrentElement();
             }
+        }
+        break;
+    }
 
-            Err err = reader.val->readScore(partScore, xml, &partReadInData);
-            ret =  make_ret(err);
-            if (!ret) {
-                break;
-            }
+    return header;
+}
+
+//---------------------------------------------------------
+//   readExcerptScore
+//---------------------------------------------------------
+
+static Ret readExcerptScore(MasterScore* masterScore, Excerpt* ex, ByteArray styleData, const ByteArray& scoreData,
+                            const ReadLinks& masterLinks, bool ignoreVersionError)
+{
+    Score* partScore = ex->excerptScore();
+
+    Buffer excerptStyleBuf(&styleData);
+    excerptStyleBuf.open(IODevice::ReadOnly);
+    partScore->style().read(&excerptStyleBuf);
 
-            partScore->linkMeasures(masterScore);
+    XmlReader xml(scoreData);
+    xml.setDocName(ex->fileName());
 
-            if (ex->name().empty()) {
-                // If no excerpt name tag was found while reading, try the "partName" meta tag
-                const String nameFromMeta = partScore->metaTag(u"partName");
+    ReadInOutData partReadInData;
+    partReadInData.links = masterLinks;
 
-                if (nameFromMeta.empty()) {
-                    // If that's also empty, fall back to the filename
-                    ex->setName(excerptFileName, /*saveAndNotify=*/ false);
-                } else {
-                    ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
+    RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
+    if (!reader.ret) {
+        return reader.ret;
+    }
+
+    return make_ret(reader.val->readScore(partScore, xml, &partReadInData));
+}
+
+//---------------------------------------------------------
+//   readExcerpts
+//    excerpts are read one by one, in the order of the file:
+//    reading a score changes objects shared with the master
+//    score (links, midi mapping, EIDs) and global state.
+//    With lazyExcerpts, the excerpts that were not open are
+//    kept as file data, they are read on first access
+//---------------------------------------------------------
+
+mu::Ret MscLoader::readExcerpts(MasterScore* masterScore, const MscReader& mscReader, const rw::ReadLinks& masterLinks,
+                                bool ignoreVersionError, bool lazyExcerpts)
+{
+    TRACEFUNC;
+
+    //! NOTE: the links of the master score are only valid for the current format,
+    //! older files may be converted after reading (see CompatUtils)
+    lazyExcerpts = lazyExcerpts && masterScore->mscVersion() == Constants::MSC_VERSION;
+
+    bool hasLazy = false;
+    for (const String& excerptFileName : mscReader.excerptFileNames()) {
+        Excerpt* ex = new Excerpt(masterScore);
+        ex->setFileName(excerptFileName);
+
+        ByteArray styleData = mscReader.readExcerptStyleFile(excerptFileName);
+        ByteArray scoreData = mscReader.readExcerptFile(excerptFileName);
+
+        if (lazyExcerpts) {
+            ExcerptHeader header = readExcerptHeader(scoreData);
+            if (!header.open) {
+                ex->setName(!header.name.empty() ? header.name
+                            : !header.partName.empty() ? header.partName : excerptFileName, /*saveAndNotify=*/ false);
+                ex->setInitialPartId(header.initialPartId);
+
+                for (int staffIdx : header.linkedStaves) {
+                    const Staff* staff = staffIdx >= 0 ? masterScore->staff(staffIdx) : nullptr;
+                    if (staff && !ex->containsPart(staff->part())) {
+                        ex->parts().push_back(staff->part());
+                    }
                 }
+
+                ex->setLazyData(styleData, scoreData, ignoreVersionError);
+                masterScore->addExcerpt(ex);
+                hasLazy = true;
+                continue;
             }
+        }
 
-            masterScore->addExcerpt(ex);
+        Score* partScore = masterScore->createScore();
+        compat::ReadStyleHook::setupDefaultStyle(partScore);
+        ex->setExcerptScore(partScore);
+
+        Ret ret = readExcerptScore(masterScore, ex, styleData, scoreData, masterLinks, ignoreVersionError);
+        if (!ret) {
+            delete ex;
+            return ret;
         }
-    }
 
-    // Compatibility conversions
-    // NOTE: must be done after all score and parts have been read
-    compat::CompatUtils::doCompatibilityConversions(masterScore);
+        partScore->linkMeasures(masterScore);
 
-    //  Read audio
-    {
-        if (masterScore->audio()) {
-            ByteArray dbuf1 = mscReader.readAudioFile();
-            masterScore->audio()->setData(dbuf1);
+        if (ex->name().empty()) {
+            // If no excerpt name tag was found while reading, try the "partName" meta tag
+            const String nameFromMeta = partScore->metaTag(u"partName");
+
+            if (nameFromMeta.empty()) {
+                // If that's also empty, fall back to the filename
+                ex->setName(excerptFileName, /*saveAndNotify=*/ false);
+            } else {
+                ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
+            }
         }
+
+        masterScore->addExcerpt(ex);
     }
 
-    settingsCompat = std::move(masterReadOutData.settingsCompat);
+    if (hasLazy) {
+        masterScore->m_lazyExcerptsLinks = std::make_shared<ReadLinks>(masterLinks);
+    }
+
+    return make_ok();
+}
+
+//---------------------------------------------------------
+//   readLazyExcerpt
+//---------------------------------------------------------
+
+mu::Ret MscLoader::readLazyExcerpt(MasterScore* masterScore, Excerpt* ex, const rw::ReadLinks& masterLinks)
+{
+    TRACEFUNC;
+
+    Score* partScore = masterScore->createScore();
+    compat::ReadStyleHook::setupDefaultStyle(partScore);
+    ex->setExcerptScore(partScore);
+
+    Ret ret = readExcerptScore(masterScore, ex, ex->lazyStyleData(), ex->lazyScoreData(), masterLinks, ex->lazyIgnoreVersionError());
+    if (!ret) {
+        //! NOTE: the half read score is dropped, the excerpt is left with an empty one,
+        //! so that it can still be shown and removed
+        delete partScore;
+
+        Score* emptyScore = masterScore->createScore();
+        compat::ReadStyleHook::setupDefaultStyle(emptyScore);
+        ex->setExcerptScore(emptyScore);
+
+        return ret;
+    }
+
+    partScore->linkMeasures(masterScore);
 
     return ret;
 }
@@ -33,9 +33,11 @@ class ReadStyleHook;
 
 namespace mu::engraving::rw {
 struct ReadInOutData;
+struct ReadLinks;
 }
 
 namespace mu::engraving {
+class Excerpt;
 class MasterScore;
 class XmlReader;
 class MscLoader
@@ -43,12 +45,18 @@ class MscLoader
 public:
     MscLoader() = default;
 
-    Ret loadMscz(MasterScore* score, const MscReader& mscReader, SettingsCompat& settingsCompat, bool ignoreVersionError);
+    //! NOTE With lazyExcerpts, excerpts that were not open are only scanned for their name and parts,
+    //! their scores are read on first access (see MasterScore::loadLazyExcerpt)
+    Ret loadMscz(MasterScore* score, const MscReader& mscReader, SettingsCompat& settingsCompat, bool ignoreVersionError,
+                 bool lazyExcerpts = false);
 
 private:
     friend class MasterScore;
     Ret readMasterScore(MasterScore* score, XmlReader&, bool ignoreVersionError, rw::ReadInOutData* out = nullptr,
                         compat::ReadStyleHook* styleHook = nullptr);
+    Ret readExcerpts(MasterScore* score, const MscReader& mscReader, const rw::ReadLinks& masterLinks, bool ignoreVersionError,
+                     bool lazyExcerpts);
+    Ret readLazyExcerpt(MasterScore* score, Excerpt* excerpt, const rw::ReadLinks& masterLinks);
 };
 }
 
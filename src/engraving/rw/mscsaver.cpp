@@ -28,6 +28,7 @@
 #include "dom/imageStore.h"
 #include "dom/audio.h"
 
+#include "engravingcache.h"
 #include "rwregister.h"
 #include "inoutdata.h"
 
@@ -46,11 +47,14 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
         return false;
     }
 
+    ByteArray styleData;
+    ByteArray scoreData;
+    ByteArray chordListData;
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
         //! At the moment, the style for the parts is still writing to the score file.
-        ByteArray styleData;
         Buffer styleBuf(&styleData);
         styleBuf.open(IODevice::WriteOnly);
         score->style().write(&styleBuf);
@@ -61,7 +65,6 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
 
     // Write MasterScore
     {
-        ByteArray scoreData;
         Buffer scoreBuf(&scoreData);
         scoreBuf.open(IODevice::ReadWrite);
 
@@ -73,6 +76,8 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
     // Write Excerpts
     {
         if (!onlySelection) {
+            score->loadLazyExcerpts();
+
             const std::vector<Excerpt*>& excerpts = score->excerpts();
 
             for (size_t excerptIndex = 0; excerptIndex < excerpts.size(); ++excerptIndex) {
@@ -113,11 +118,20 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
     {
         ChordList* chordList = score->chordList();
         if (chordList->customChordList() && !chordList->empty()) {
-            ByteArray chlData;
-            Buffer chlBuf(&chlData);
+            Buffer chlBuf(&chordListData);
             chlBuf.open(IODevice::WriteOnly);
             chordList->write(&chlBuf);
-            mscWriter.writeChordListFile(chlData);
+            mscWriter.writeChordListFile(chordListData);
+        }
+    }
+
+    // Write engraving cache
+    {
+        //! NOTE Only the page layout of the whole score, as it's laid out when opened
+        if (!onlySelection && mscWriter.params().mode == MscIoMode::Zip
+            && score->layoutMode() == LayoutMode::PAGE && !score->pages().empty()) {
+            uint64_t contentHash = EngravingCache::contentHash(styleData, scoreData, chordListData);
+            mscWriter.writeEngravingCacheFile(EngravingCache::fromScore(score, contentHash).toBinary());
         }
     }
 
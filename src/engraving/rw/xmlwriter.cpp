@@ -22,6 +22,8 @@
 
 #include "xmlwriter.h"
 
+#include <charconv>
+
 #include "types/typesconv.h"
 
 #include "dom/engravingitem.h"
@@ -115,25 +117,29 @@ void XmlWriter::tagProperty(Pid id, const PropertyValue& val, const PropertyValu
         LOGD() << "property value type mismatch, prop: " << name;
     }
 
-    const String writableVal(propertyToString(id, val, /* mscx */ true));
-    if (writableVal.isEmpty()) {
-        //! NOTE The data type is MILLIMETRE, but we write SPATIUM
-        //! (the conversion from Millimetre to Spatium occurred higher up the stack)
-        if (propType == P_TYPE::MILLIMETRE) {
-            propType = P_TYPE::SPATIUM;
+    //! NOTE Only a few properties have a special string, don't format the others twice
+    if (propertyWrittenAsString(id)) {
+        const String writableVal(propertyToString(id, val, /* mscx */ true));
+        if (!writableVal.isEmpty()) {
+            tagProperty(name, P_TYPE::STRING, PropertyValue(writableVal));
+            return;
         }
+    }
 
-        //! HACK Temporary hack. We have some kind of property with property type BOOL,
-        //! but the used value type is INT (not just 1 and 0)
-        //! see STAFF_BARLINE_SPAN
-        if (propType == P_TYPE::BOOL && valType == P_TYPE::INT) {
-            propType = P_TYPE::INT;
-        }
+    //! NOTE The data type is MILLIMETRE, but we write SPATIUM
+    //! (the conversion from Millimetre to Spatium occurred higher up the stack)
+    if (propType == P_TYPE::MILLIMETRE) {
+        propType = P_TYPE::SPATIUM;
+    }
 
-        tagProperty(name, propType, val);
-    } else {
-        tagProperty(name, P_TYPE::STRING, PropertyValue(writableVal));
+    //! HACK Temporary hack. We have some kind of property with property type BOOL,
+    //! but the used value type is INT (not just 1 and 0)
+    //! see STAFF_BARLINE_SPAN
+    if (propType == P_TYPE::BOOL && valType == P_TYPE::INT) {
+        propType = P_TYPE::INT;
     }
+
+    tagProperty(name, propType, val);
 }
 
 void XmlWriter::tagProperty(const AsciiStringView& name, const PropertyValue& val, const PropertyValue& def)
@@ -312,7 +318,13 @@ void XmlWriter::tagFraction(const AsciiStringView& name, const Fraction& v, cons
         return;
     }
 
-    element(name, v.toString());
+    //! NOTE Same as v.toString(), without a String in between
+    char buf[32];
+    char* end = std::to_chars(buf, buf + sizeof(buf), v.numerator()).ptr;
+    *end++ = '/';
+    end = std::to_chars(end, buf + sizeof(buf), v.denominator()).ptr;
+
+    element(name, AsciiStringView(buf, end - buf));
 }
 
 void XmlWriter::writeXml(const String& name, String s)
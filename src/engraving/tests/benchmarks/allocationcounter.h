@@ -0,0 +1,44 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ALLOCATIONCOUNTER_H
+#define MU_ENGRAVING_ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+namespace mu::engraving::benchmarks {
+//! NOTE Counts heap allocations made through the global operator new
+//! (replaced in allocationcounter.cpp for the benchmark binary only)
+class AllocationCounter
+{
+public:
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+
+        Snapshot operator-(const Snapshot& other) const { return { count - other.count, bytes - other.bytes }; }
+    };
+
+    static Snapshot snapshot();
+};
+}
+
+#endif // MU_ENGRAVING_ALLOCATIONCOUNTER_H
@@ -0,0 +1,404 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "engravingbenchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <numeric>
+
+#include "io/buffer.h"
+#include "io/dir.h"
+#include "io/file.h"
+#include "io/fileinfo.h"
+#include "profiler.h"
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/infrastructure/mscwriter.h"
+#include "engraving/rw/mscsaver.h"
+#include "engraving/rw/rwregister.h"
+
+#include "dom/excerpt.h"
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/part.h"
+
+#include "utils/scorerw.h"
+#include "allocationcounter.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::io;
+using namespace mu::engraving;
+using namespace mu::engraving::benchmarks;
+
+//! NOTE Base of generated scores: six parts, extended with measures and notes
+static const String GENERATED_BASE(u"concertpitch_data/concertpitchbenchmark.mscx");
+
+EngravingBenchmarks::EngravingBenchmarks(const Options& opt)
+    : m_opt(opt)
+{
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+JsonObject EngravingBenchmarks::run()
+{
+    JsonArray scores;
+    for (const Source& source : sources()) {
+        LOGI() << "benchmark: " << source.name;
+        scores.append(benchmarkScore(source));
+    }
+
+    JsonObject result;
+    result["version"] = std::string(MUSESCORE_VERSION);
+    result["revision"] = std::string(MUSESCORE_REVISION);
+    result["iterations"] = m_opt.iterations;
+    result["scores"] = scores;
+    return result;
+}
+
+//---------------------------------------------------------
+//   sources
+//---------------------------------------------------------
+
+std::vector<EngravingBenchmarks::Source> EngravingBenchmarks::sources() const
+{
+    std::vector<Source> result;
+
+    if (!m_opt.scoresDir.isEmpty()) {
+        RetVal<paths_t> files = Dir::scanFiles(m_opt.scoresDir, { "*.mscx", "*.mscz" }, ScanMode::FilesInCurrentDir);
+        if (!files.ret) {
+            LOGE() << "failed scan: " << m_opt.scoresDir << ", err: " << files.ret.toString();
+        }
+
+        std::sort(files.val.begin(), files.val.end());
+        for (const path_t& path : files.val) {
+            String name = FileInfo(path).fileName();
+            if (!m_opt.filter.isEmpty() && !name.contains(m_opt.filter)) {
+                continue;
+            }
+            result.push_back({ name, path.toString(), 0 });
+        }
+    }
+
+    for (int measures : m_opt.generatedMeasures) {
+        String name = String(u"generated-%1").arg(measures);
+        if (!m_opt.filter.isEmpty() && !name.contains(m_opt.filter)) {
+            continue;
+        }
+        result.push_back({ name, String(), measures });
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   loadScore
+//    reads the score without laying it out
+//---------------------------------------------------------
+
+MasterScore* EngravingBenchmarks::loadScore(const Source& source) const
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    Ret ret = compat::loadMsczOrMscx(score, source.path, true);
+    if (!ret) {
+        LOGE() << "failed load score: " << source.path << ", err: " << ret.toString();
+        delete score;
+        return nullptr;
+    }
+    return score;
+}
+
+//---------------------------------------------------------
+//   generateScore
+//---------------------------------------------------------
+
+MasterScore* EngravingBenchmarks::generateScore(int measures) const
+{
+    MasterScore* score = ScoreRW::readScore(GENERATED_BASE);
+    if (!score) {
+        return nullptr;
+    }
+
+    const int existing = static_cast<int>(score->nmeasures());
+    if (measures <= existing) {
+        return score;
+    }
+
+    score->startCmd();
+    score->appendMeasures(measures - existing);
+    score->endCmd();
+
+    // quarter notes in the first staff of the new measures
+    Measure* first = score->firstMeasure();
+    for (int i = 0; i < existing && first; ++i) {
+        first = first->nextMeasure();
+    }
+    IF_ASSERT_FAILED(first) {
+        return score;
+    }
+
+    const Fraction quarter(1, 4);
+    const int notes = (score->lastMeasure()->endTick() - first->tick()).ticks() / quarter.ticks();
+
+    InputState& is = score->inputState();
+    is.setTrack(0);
+    is.setSegment(first->first(SegmentType::ChordRest));
+    is.setDuration(DurationType::V_QUARTER);
+    is.setNoteEntryMode(true);
+
+    score->startCmd();
+    for (int i = 0; i < notes; ++i) {
+        score->cmdAddPitch(35 + i % 8, false, false);
+    }
+    score->endCmd();
+
+    is.setNoteEntryMode(false);
+    score->doLayout();
+
+    return score;
+}
+
+//---------------------------------------------------------
+//   benchmarkScore
+//---------------------------------------------------------
+
+JsonObject EngravingBenchmarks::benchmarkScore(const Source& source)
+{
+    JsonObject result;
+    result["name"] = source.name;
+
+    Source src = source;
+    MasterScore* score = nullptr;
+    if (source.generatedMeasures > 0) {
+        score = generateScore(source.generatedMeasures);
+
+        // saved, so that reading can be measured as for the other scores
+        src.path = source.name + u".mscx";
+        if (score && !ScoreRW::saveScore(score, src.path)) {
+            src.path.clear();
+        }
+    } else {
+        score = loadScore(source);
+    }
+
+    if (!score) {
+        result["error"] = "failed load score";
+        return result;
+    }
+
+    JsonObject cases;
+
+    cases["layout"] = measure([score]() {
+        score->doLayout();
+    });
+
+    result["measures"] = static_cast<int>(score->nmeasures());
+    result["staves"] = static_cast<int>(score->nstaves());
+    result["pages"] = static_cast<int>(score->npages());
+
+    // an edit in the middle of the score and its undo, both laid out incrementally
+    Measure* middle = score->firstMeasure();
+    for (size_t i = 0; i < score->nmeasures() / 2 && middle && middle->nextMeasure(); ++i) {
+        middle = middle->nextMeasure();
+    }
+    if (middle) {
+        cases["incrementalLayout"] = measure([score, middle]() {
+            score->startCmd();
+            middle->undoChangeProperty(Pid::USER_STRETCH, middle->userStretch() * 1.5);
+            score->endCmd();
+            score->undoRedo(true, nullptr);
+        });
+    }
+
+    if (score->parts().size() > 1 && score->excerpts().empty()) {
+        for (Excerpt* excerpt : Excerpt::createExcerptsFromParts(score->parts(), score)) {
+            score->initExcerpt(excerpt);
+            score->excerpts().push_back(excerpt);
+        }
+        score->setExcerptsChanged(true);
+    }
+    if (!score->excerpts().empty()) {
+        result["parts"] = static_cast<int>(score->excerpts().size());
+        cases["partsLayout"] = measure([score]() {
+            for (Excerpt* excerpt : score->excerpts()) {
+                if (excerpt->excerptScore()) {
+                    excerpt->excerptScore()->doLayout();
+                }
+            }
+        });
+    }
+
+    cases["paint"] = measure([score]() {
+        std::shared_ptr<draw::BufferedPaintProvider> provider = std::make_shared<draw::BufferedPaintProvider>();
+        draw::Painter painter(provider, "benchmark");
+
+        rendering::IScoreRenderer::PaintOptions opt;
+        opt.isMultiPage = true;
+        opt.isPrinting = true;
+        opt.printPageBackground = true;
+        opt.isSetViewport = true;
+
+        score->renderer()->paintScore(&painter, score, opt);
+    });
+
+    cases["write"] = measure([score]() {
+        Buffer buffer;
+        buffer.open(IODevice::WriteOnly);
+        rw::RWRegister::writer()->writeScore(score, &buffer, false);
+    });
+
+    // the whole .mscz: score, parts, style and settings, compressed
+    cases["save"] = measure([score]() {
+        ByteArray data;
+        Buffer buffer(&data);
+        MscWriter::Params params;
+        params.device = &buffer;
+        params.filePath = u"benchmark.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+        MscSaver().writeMscz(score, writer, false, false);
+        writer.close();
+    });
+
+    delete score;
+
+    if (!src.path.isEmpty()) {
+        MasterScore* readScore = nullptr;
+        cases["read"] = measure([this, &src, &readScore]() {
+            readScore = loadScore(src);
+        }, [&readScore]() {
+            delete readScore;
+            readScore = nullptr;
+        });
+
+        if (source.generatedMeasures > 0) {
+            File::remove(src.path);
+        }
+    }
+
+    result["cases"] = cases;
+    return result;
+}
+
+//---------------------------------------------------------
+//   measure
+//    runs func the given number of iterations,
+//    cleanup (not measured) after each of them
+//---------------------------------------------------------
+
+JsonObject EngravingBenchmarks::measure(const std::function<void()>& func, const std::function<void()>& cleanup)
+{
+    std::vector<double> times;
+    AllocationCounter::Snapshot allocations;
+
+    PROFILER_CLEAR;
+
+    for (int i = 0; i < m_opt.iterations; ++i) {
+        const AllocationCounter::Snapshot before = AllocationCounter::snapshot();
+        const auto start = std::chrono::steady_clock::now();
+
+        func();
+
+        const auto end = std::chrono::steady_clock::now();
+        const AllocationCounter::Snapshot used = AllocationCounter::snapshot() - before;
+
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        allocations.count += used.count;
+        allocations.bytes += used.bytes;
+
+        if (cleanup) {
+            cleanup();
+        }
+    }
+
+    JsonObject result;
+    if (times.empty()) {
+        return result;
+    }
+
+    const int iterations = static_cast<int>(times.size());
+    std::sort(times.begin(), times.end());
+    result["minMs"] = times.front();
+    result["medianMs"] = times.at(times.size() / 2);
+    result["meanMs"] = std::accumulate(times.begin(), times.end(), 0.0) / iterations;
+    result["allocations"] = static_cast<double>(allocations.count / iterations);
+    result["allocatedBytes"] = static_cast<double>(allocations.bytes / iterations);
+    result["profile"] = profile();
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   profile
+//    TRACEFUNC data of the last measure(), summed over
+//    all iterations and threads, most expensive first
+//---------------------------------------------------------
+
+JsonArray EngravingBenchmarks::profile() const
+{
+    using Data = profiler::Profiler::Data;
+
+    std::map<std::string, Data::Func> funcs;
+    const Data data = profiler::Profiler::instance()->threadsData(Data::All);
+    for (const auto& thread : data.threads) {
+        for (const auto& p : thread.second.funcs) {
+            Data::Func& f = funcs[p.first];
+            f.func = p.second.func;
+            f.callcount += p.second.callcount;
+            f.sumtimeMs += p.second.sumtimeMs;
+        }
+    }
+
+    std::vector<Data::Func> sorted;
+    sorted.reserve(funcs.size());
+    for (const auto& p : funcs) {
+        sorted.push_back(p.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Data::Func& a, const Data::Func& b) {
+        return a.sumtimeMs > b.sumtimeMs;
+    });
+    if (sorted.size() > static_cast<size_t>(m_opt.profileTopCount)) {
+        sorted.resize(m_opt.profileTopCount);
+    }
+
+    JsonArray result;
+    for (const Data::Func& f : sorted) {
+        JsonObject obj;
+        obj["func"] = f.func;
+        obj["calls"] = static_cast<double>(f.callcount);
+        obj["ms"] = f.sumtimeMs;
+        result.append(obj);
+    }
+    return result;
+}
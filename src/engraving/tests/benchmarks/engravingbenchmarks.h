@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ENGRAVINGBENCHMARKS_H
+#define MU_ENGRAVING_ENGRAVINGBENCHMARKS_H
+
+#include <functional>
+#include <vector>
+
+#include "types/string.h"
+#include "serialization/json.h"
+
+namespace mu::engraving {
+class MasterScore;
+}
+
+namespace mu::engraving::benchmarks {
+//! NOTE Times full layout, incremental layout after an edit, layout of parts,
+//! painting, reading, writing and saving as .mscz for every score of the corpus,
+//! the result is a JSON document, so that runs of different versions can be compared:
+//! {
+//!     "iterations": 3,
+//!     "scores": [ {
+//!         "name": "...", "measures": 216, "staves": 6, "pages": 12,
+//!         "cases": {
+//!             "layout": {
+//!                 "minMs": 1.2, "medianMs": 1.3, "meanMs": 1.3,
+//!                 "allocations": 1234, "allocatedBytes": 56789,     // per iteration
+//!                 "profile": [ { "func": "...", "calls": 10, "ms": 0.5 } ]
+//!             },
+//!             ...
+//!         }
+//!     } ]
+//! }
+class EngravingBenchmarks
+{
+public:
+    struct Options {
+        String scoresDir;                       // all .mscx / .mscz of this directory
+        String filter;                          // only scores whose file name contains this
+        std::vector<int> generatedMeasures;     // generated scores with this number of measures
+        int iterations = 3;
+        int profileTopCount = 20;
+    };
+
+    explicit EngravingBenchmarks(const Options& opt);
+
+    JsonObject run();
+
+private:
+    struct Source {
+        String name;
+        String path;            // empty for generated scores
+        int generatedMeasures = 0;
+    };
+
+    std::vector<Source> sources() const;
+    MasterScore* loadScore(const Source& source) const;
+    MasterScore* generateScore(int measures) const;
+
+    JsonObject benchmarkScore(const Source& source);
+    JsonObject measure(const std::function<void()>& func, const std::function<void()>& cleanup = nullptr);
+    JsonArray profile() const;
+
+    Options m_opt;
+};
+}
+
+#endif // MU_ENGRAVING_ENGRAVINGBENCHMARKS_H
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QGuiApplication>
+
+#include <iostream>
+
+#include "global/runtime.h"
+#include "global/io/file.h"
+#include "testing/environment.h"
+
+#include "engravingbenchmarks.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving::benchmarks;
+
+static void printUsage()
+{
+    std::cout << "Usage: engraving_benchmarks [options]\n"
+              << "  --scores <dir>           directory with the scores to benchmark (default: vtest/scores, empty: none)\n"
+              << "  --filter <text>          only scores whose file name contains text\n"
+              << "  --generated <n,n,...>    also generated scores with this number of measures (default: 1000)\n"
+              << "  --iterations <n>         iterations of every case (default: 3)\n"
+              << "  --profile-top <n>        number of functions in the profile of every case (default: 20)\n"
+              << "  --output <file>          write the JSON result to file (default: stdout)\n";
+}
+
+int main(int argc, char** argv)
+{
+    QGuiApplication app(argc, argv);
+
+    EngravingBenchmarks::Options opt;
+    opt.scoresDir = String::fromUtf8(ENGRAVING_BENCHMARKS_VTEST_SCORES);
+    opt.generatedMeasures = { 1000 };
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else if (arg == "--scores" && hasValue) {
+            opt.scoresDir = String::fromUtf8(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            opt.filter = String::fromUtf8(argv[++i]);
+        } else if (arg == "--generated" && hasValue) {
+            opt.generatedMeasures.clear();
+            for (const String& n : String::fromUtf8(argv[++i]).split(u',')) {
+                bool ok = false;
+                int measures = n.toInt(&ok);
+                if (ok && measures > 0) {
+                    opt.generatedMeasures.push_back(measures);
+                }
+            }
+        } else if (arg == "--iterations" && hasValue) {
+            opt.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--profile-top" && hasValue) {
+            opt.profileTopCount = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "unknown argument: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    mu::runtime::mainThreadId(); //! NOTE Needs only call
+    mu::runtime::setThreadName("main");
+
+    mu::testing::Environment::setup();
+
+    EngravingBenchmarks benchmarks(opt);
+    ByteArray json = JsonDocument(benchmarks.run()).toJson();
+
+    if (outputPath.empty()) {
+        std::cout << json.constChar() << std::endl;
+        return 0;
+    }
+
+    Ret ret = io::File::writeFile(outputPath, json);
+    if (!ret) {
+        LOGE() << "failed write: " << outputPath << ", err: " << ret.toString();
+        return 1;
+    }
+
+    return 0;
+}
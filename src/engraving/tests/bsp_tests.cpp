@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/page.h"
+#include "dom/system.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_BspTests : public ::testing::Test
+{
+public:
+    //! NOTE Items found in a grid of rects covering the page
+    static std::vector<std::vector<EngravingItem*> > probe(Page* page)
+    {
+        std::vector<std::vector<EngravingItem*> > result;
+        const RectF r = page->ldata()->bbox();
+        const double w = r.width() / 8;
+        const double h = r.height() / 16;
+        for (int x = 0; x < 8; ++x) {
+            for (int y = 0; y < 16; ++y) {
+                std::vector<EngravingItem*> items = page->items(RectF(r.x() + x * w, r.y() + y * h, w, h));
+                std::sort(items.begin(), items.end());
+                result.push_back(items);
+            }
+        }
+        return result;
+    }
+
+    //! NOTE Where each system of the page is and which layout it has
+    using SystemStates = std::map<const System*, std::pair<uint64_t, PointF> >;
+
+    static SystemStates systemStates(const Page* page)
+    {
+        SystemStates states;
+        for (const System* system : page->systems()) {
+            states[system] = { system->layoutId(), system->pagePos() };
+        }
+        return states;
+    }
+
+    //! NOTE The systems that were laid out again or moved, or are new on the page
+    static std::vector<const System*> changedSystems(const Page* page, const SystemStates& before)
+    {
+        std::vector<const System*> changed;
+        for (const System* system : page->systems()) {
+            auto it = before.find(system);
+            if (it == before.end() || it->second != std::make_pair(system->layoutId(), system->pagePos())) {
+                changed.push_back(system);
+            }
+        }
+        std::sort(changed.begin(), changed.end());
+        return changed;
+    }
+
+    static std::vector<const System*> updatedSystems(const Page* page)
+    {
+        std::vector<const System*> updated = page->bspTreeUpdatedSystems();
+        std::sort(updated.begin(), updated.end());
+        return updated;
+    }
+
+    static void changeStretch(MasterScore* score, Measure* m, double stretch)
+    {
+        score->startCmd();
+        m->undoChangeProperty(Pid::USER_STRETCH, stretch);
+        score->endCmd();
+    }
+};
+
+TEST_F(Engraving_BspTests, partialUpdateMatchesRebuild)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+    Page* page = score->pages().front();
+    probe(page);
+    ASSERT_GT(page->systems().size(), 1u);
+
+    // [WHEN] A measure in the middle of the page is stretched, only its system is laid out again
+    Measure* m = score->firstMeasure();
+    for (int i = 0; i < 6 && m->nextMeasure(); ++i) {
+        m = m->nextMeasure();
+    }
+
+    SystemStates before = systemStates(page);
+    changeStretch(score, m, 1.5);
+    std::vector<EngravingItem*> measureItems = page->items(m->pageBoundingRect());
+
+    // [THEN] Only the systems that changed are put into the tree again, the others are kept
+    std::vector<const System*> changed = changedSystems(page, before);
+    EXPECT_EQ(updatedSystems(page), changed);
+    EXPECT_TRUE(std::binary_search(changed.begin(), changed.end(), m->system()));
+    EXPECT_LT(changed.size(), page->systems().size());
+    EXPECT_NE(std::find(measureItems.begin(), measureItems.end(), m), measureItems.end());
+
+    // [THEN] The tree finds the same items as a tree built from scratch
+    std::vector<std::vector<EngravingItem*> > updated = probe(page);
+    page->invalidateBspTree();
+    EXPECT_EQ(updated, probe(page));
+
+    // [WHEN] The change is undone
+    before = systemStates(page);
+    score->undoRedo(true, nullptr);
+    page->items(m->pageBoundingRect());
+
+    // [THEN] Again only the systems that changed are updated
+    changed = changedSystems(page, before);
+    EXPECT_EQ(updatedSystems(page), changed);
+    EXPECT_LT(changed.size(), page->systems().size());
+
+    updated = probe(page);
+    page->invalidateBspTree();
+    EXPECT_EQ(updated, probe(page));
+
+    delete score;
+}
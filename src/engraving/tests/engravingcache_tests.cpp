@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/page.h"
+#include "dom/system.h"
+
+#include "rw/engravingcache.h"
+
+#include "io/buffer.h"
+#include "serialization/zipreader.h"
+#include "serialization/zipwriter.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_EngravingCacheTests : public ::testing::Test
+{
+public:
+    //! NOTE Indexes (in the list of measures and frames) of the first measures of the systems
+    static std::vector<int> systemStarts(const Score* score)
+    {
+        std::vector<int> result;
+        for (const Page* page : score->pages()) {
+            for (const System* system : page->systems()) {
+                if (!system->measures().empty()) {
+                    result.push_back(system->measures().front()->index());
+                }
+            }
+        }
+        return result;
+    }
+
+    static std::vector<int> hintedStarts(const Score* score)
+    {
+        std::vector<int> result;
+        int index = 0;
+        for (const MeasureBase* mb = score->first(); mb; mb = mb->next(), ++index) {
+            if (score->isSystemStartHint(mb)) {
+                result.push_back(index);
+            }
+        }
+        return result;
+    }
+
+    //! NOTE The same archive, with the engraving cache of another one
+    static ByteArray replaceEngravingCache(const ByteArray& msczData, const ByteArray& cacheMsczData)
+    {
+        ByteArray cacheData = cacheMsczData;
+        io::Buffer cacheBuf(&cacheData);
+        ZipReader cacheReader(&cacheBuf);
+        const ByteArray cache = cacheReader.fileData("engravingcache.bin");
+
+        ByteArray data = msczData;
+        io::Buffer buf(&data);
+        ZipReader reader(&buf);
+
+        ByteArray result;
+        io::Buffer resultBuf(&result);
+        ZipWriter writer(&resultBuf);
+        for (const ZipReader::FileInfo& fi : reader.fileInfoList()) {
+            if (fi.isFile) {
+                writer.addFile(fi.filePath.toStdString(),
+                               fi.filePath == "engravingcache.bin" ? cache : reader.fileData(fi.filePath.toStdString()));
+            }
+        }
+        writer.close();
+
+        return result;
+    }
+
+    static void changeStretch(MasterScore* score, Measure* m, double stretch)
+    {
+        score->startCmd();
+        m->undoChangeProperty(Pid::USER_STRETCH, stretch);
+        score->endCmd();
+    }
+};
+
+TEST_F(Engraving_EngravingCacheTests, systemsOfSavedScore)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    const std::vector<int> saved = systemStarts(score);
+    ASSERT_GT(saved.size(), 1u);
+
+    ByteArray msczData = ScoreRW::writeMscz(score);
+    delete score;
+
+    // [WHEN] The saved score is read again
+    score = ScoreRW::readMscz(msczData);
+    ASSERT_TRUE(score);
+
+    // [THEN] The layout knows where the systems started
+    EXPECT_EQ(hintedStarts(score), saved);
+
+    // [THEN] And lays them out the same, the hints are for the first layout only
+    score->doLayout();
+    EXPECT_EQ(systemStarts(score), saved);
+    EXPECT_TRUE(hintedStarts(score).empty());
+
+    delete score;
+}
+
+TEST_F(Engraving_EngravingCacheTests, binaryFormat)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    const EngravingCache cache = EngravingCache::fromScore(score, 42);
+    delete score;
+
+    const ByteArray data = cache.toBinary();
+
+    EngravingCache read;
+    ASSERT_TRUE(EngravingCache::fromBinary(data, read));
+    EXPECT_TRUE(read.isCurrentRevision());
+    EXPECT_EQ(read.contentHash(), 42u);
+    ASSERT_EQ(read.systems().size(), cache.systems().size());
+    for (size_t i = 0; i < cache.systems().size(); ++i) {
+        EXPECT_EQ(read.systems().at(i).firstMeasure, cache.systems().at(i).firstMeasure);
+    }
+
+    // [THEN] Truncated or unknown data is not used
+    EXPECT_FALSE(EngravingCache::fromBinary(ByteArray(data.constData(), data.size() - 1), read));
+    EXPECT_FALSE(EngravingCache::fromBinary(ByteArray("not a cache"), read));
+    EXPECT_FALSE(EngravingCache::fromBinary(ByteArray(), read));
+}
+
+TEST_F(Engraving_EngravingCacheTests, hintedLayoutMatchesUnhinted)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ByteArray msczData = ScoreRW::writeMscz(score);
+    delete score;
+
+    // [GIVEN] The same saved score, read once with the system start hints and once without them
+    MasterScore* hinted = ScoreRW::readMscz(msczData);
+    MasterScore* unhinted = ScoreRW::readMscz(msczData);
+    ASSERT_TRUE(hinted);
+    ASSERT_TRUE(unhinted);
+    ASSERT_FALSE(hintedStarts(hinted).empty());
+    unhinted->setSystemStartHints({});
+
+    // [WHEN] Both are laid out
+    hinted->doLayout();
+    unhinted->doLayout();
+
+    // [THEN] The systems break at the same measures
+    EXPECT_EQ(systemStarts(hinted), systemStarts(unhinted));
+
+    delete hinted;
+    delete unhinted;
+}
+
+TEST_F(Engraving_EngravingCacheTests, staleHintsAreIgnored)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    const std::vector<int> saved = systemStarts(score);
+    ByteArray oldMsczData = ScoreRW::writeMscz(score);
+
+    // [GIVEN] The score is edited, so that fewer measures fit on the first system
+    changeStretch(score, score->firstMeasure(), 4.0);
+    const std::vector<int> edited = systemStarts(score);
+    ASSERT_NE(edited, saved);
+    ByteArray newMsczData = ScoreRW::writeMscz(score);
+    delete score;
+
+    // [GIVEN] The edited score is saved with the engraving cache of the score before the edit
+    ByteArray staleMsczData = replaceEngravingCache(newMsczData, oldMsczData);
+
+    // [WHEN] It's read
+    score = ScoreRW::readMscz(staleMsczData);
+    ASSERT_TRUE(score);
+
+    // [THEN] The cache doesn't match the content, so there are no hints
+    EXPECT_TRUE(hintedStarts(score).empty());
+
+    // [THEN] The systems break where the edited score needs them, not earlier at the old breaks
+    score->doLayout();
+    EXPECT_EQ(systemStarts(score), edited);
+
+    delete score;
+}
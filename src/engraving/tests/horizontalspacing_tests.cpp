@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+#include "dom/system.h"
+#include "rendering/dev/horizontalspacing.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering::dev;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_HorizontalSpacingTests : public ::testing::Test
+{
+public:
+    //! NOTE Reference implementation: springs built from the segments, like justification used to do
+    static std::vector<double> referenceStretch(System* system, double width)
+    {
+        std::vector<Spring> springs;
+        std::vector<double> widths;
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            for (Segment& s : toMeasure(mb)->segments()) {
+                if (s.isChordRestType() && s.ticks() > Fraction(0, 1) && s.visible() && s.enabled() && !s.allElementsInvisible()) {
+                    double springConst = 1 / s.stretch();
+                    double w = s.width() - s.widthOffset();
+                    springs.push_back(Spring(springConst, w, w * springConst, &s));
+                }
+            }
+        }
+
+        Segment::stretchSegmentsToWidth(springs, width);
+
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            Measure* m = toMeasure(mb);
+            m->respaceSegments();
+            for (Segment& s : m->segments()) {
+                widths.push_back(s.width());
+                widths.push_back(s.x());
+            }
+            widths.push_back(m->width());
+        }
+        return widths;
+    }
+
+    static std::vector<double> snapshotValues(const HorizontalSpacing::SegmentsSnapshot& snapshot)
+    {
+        std::vector<double> values;
+        size_t begin = 0;
+        for (size_t mi = 0; mi < snapshot.measures.size(); ++mi) {
+            for (size_t i = begin; i < snapshot.measureEnd[mi]; ++i) {
+                values.push_back(snapshot.width[i]);
+                values.push_back(snapshot.x[i]);
+            }
+            values.push_back(snapshot.measureWidth[mi]);
+            begin = snapshot.measureEnd[mi];
+        }
+        return values;
+    }
+};
+
+TEST_F(Engraving_HorizontalSpacingTests, snapshotJustificationMatchesSegments)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->systems().empty());
+
+    for (System* system : score->systems()) {
+        const HorizontalSpacing::SegmentsSnapshot original = HorizontalSpacing::takeSnapshot(system);
+
+        for (double width : { 0.0, 5.0, 40.0 }) {
+            // [WHEN] The system is stretched on the snapshot
+            HorizontalSpacing::SegmentsSnapshot snapshot = HorizontalSpacing::takeSnapshot(system);
+            HorizontalSpacing::stretchSegmentsToWidth(snapshot, width);
+            HorizontalSpacing::respaceSegments(snapshot);
+
+            // [THEN] The result is the same as stretching the segments themselves
+            std::vector<double> reference = referenceStretch(system, width);
+
+            // springs with equal pre-tension may be summed in another order
+            std::vector<double> values = snapshotValues(snapshot);
+            ASSERT_EQ(values.size(), reference.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                EXPECT_NEAR(values[i], reference[i], 1e-9);
+            }
+
+            HorizontalSpacing::applySnapshot(original);
+        }
+    }
+
+    delete score;
+}
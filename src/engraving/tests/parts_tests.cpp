@@ -39,6 +39,9 @@
 #include "dom/segment.h"
 #include "dom/spanner.h"
 
+#include "io/buffer.h"
+#include "rw/rwregister.h"
+
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
@@ -66,6 +69,25 @@ public:
     MasterScore* doRemoveMeasureRepeat();
     MasterScore* doAddImage();
     MasterScore* doRemoveImage();
+
+    static ByteArray writeScore(Score* score)
+    {
+        ByteArray data;
+        io::Buffer buf(&data);
+        buf.open(io::IODevice::WriteOnly);
+        rw::RWRegister::writer()->writeScore(score, &buf, false);
+        return data;
+    }
+
+    static void checkSameExcerpt(const Excerpt* lazy, const Excerpt* eager)
+    {
+        EXPECT_EQ(lazy->name(), eager->name());
+        EXPECT_EQ(lazy->initialPartId(), eager->initialPartId());
+        ASSERT_EQ(lazy->parts().size(), eager->parts().size());
+        for (size_t i = 0; i < lazy->parts().size(); ++i) {
+            EXPECT_EQ(lazy->parts().at(i)->id(), eager->parts().at(i)->id());
+        }
+    }
 };
 
 Score* Engraving_PartsTests::createPart(MasterScore* masterScore)
@@ -1289,3 +1311,103 @@ TEST_F(Engraving_PartsTests, staffStyles)
 }
 
 #endif
+
+//---------------------------------------------------------
+//   lazyExcerpts
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, lazyExcerpts)
+{
+    bool useRead302 = MScore::useRead302InTestMode;
+    MScore::useRead302InTestMode = false;
+
+    // [GIVEN] A score with two parts, saved in the current format
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all-parts.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->excerpts().size(), 2);
+    ByteArray msczData = ScoreRW::writeMscz(score);
+    delete score;
+
+    // [WHEN] It is read with and without lazy excerpts
+    MasterScore* eager = ScoreRW::readMscz(msczData, false);
+    MasterScore* lazy = ScoreRW::readMscz(msczData, true);
+    ASSERT_TRUE(eager && lazy);
+    ASSERT_EQ(eager->excerpts().size(), 2);
+    ASSERT_EQ(lazy->excerpts().size(), 2);
+
+    // [THEN] The closed parts are known by their name and parts only
+    EXPECT_TRUE(lazy->hasLazyExcerpts());
+    for (size_t i = 0; i < lazy->excerpts().size(); ++i) {
+        EXPECT_TRUE(lazy->excerpts().at(i)->isLazy());
+        EXPECT_FALSE(lazy->excerpts().at(i)->excerptScore());
+        checkSameExcerpt(lazy->excerpts().at(i), eager->excerpts().at(i));
+    }
+
+    // [WHEN] One part is accessed, it is read like it would have been on load
+    Excerpt* first = lazy->excerpts().front();
+    EXPECT_TRUE(lazy->loadLazyExcerpt(first));
+    ASSERT_TRUE(first->excerptScore());
+    EXPECT_FALSE(first->isLazy());
+    checkSameExcerpt(first, eager->excerpts().front());
+    EXPECT_EQ(writeScore(first->excerptScore()), writeScore(eager->excerpts().front()->excerptScore()));
+    EXPECT_TRUE(lazy->excerpts().at(1)->isLazy());
+
+    // [WHEN] The master score is edited, the remaining parts are read first
+    lazy->startCmd();
+    EXPECT_FALSE(lazy->hasLazyExcerpts());
+    Excerpt* second = lazy->excerpts().at(1);
+    ASSERT_TRUE(second->excerptScore());
+    EXPECT_EQ(writeScore(second->excerptScore()), writeScore(eager->excerpts().at(1)->excerptScore()));
+    lazy->endCmd();
+
+    delete eager;
+    delete lazy;
+
+    MScore::useRead302InTestMode = useRead302;
+}
+
+//---------------------------------------------------------
+//   lazyExcerptsOneByOne
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, lazyExcerptsOneByOne)
+{
+    bool useRead302 = MScore::useRead302InTestMode;
+    MScore::useRead302InTestMode = false;
+
+    // [GIVEN] A score with two closed parts, read with lazy excerpts
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all-parts.mscx");
+    ASSERT_TRUE(score);
+    ByteArray msczData = ScoreRW::writeMscz(score);
+    delete score;
+
+    MasterScore* eager = ScoreRW::readMscz(msczData, false);
+    MasterScore* lazy = ScoreRW::readMscz(msczData, true);
+    ASSERT_TRUE(eager && lazy);
+    ASSERT_EQ(lazy->excerpts().size(), 2);
+
+    // [WHEN] The next part is read
+    // [THEN] Only the first one is read
+    EXPECT_TRUE(lazy->loadNextLazyExcerpt());
+    EXPECT_FALSE(lazy->excerpts().at(0)->isLazy());
+    EXPECT_TRUE(lazy->excerpts().at(1)->isLazy());
+    EXPECT_TRUE(lazy->hasLazyExcerpts());
+
+    // [WHEN] The next part is read
+    // [THEN] The second one is read too
+    EXPECT_TRUE(lazy->loadNextLazyExcerpt());
+    EXPECT_FALSE(lazy->excerpts().at(1)->isLazy());
+
+    // [THEN] None is left, the parts are the same as when read on load
+    EXPECT_FALSE(lazy->loadNextLazyExcerpt());
+    EXPECT_FALSE(lazy->hasLazyExcerpts());
+    for (size_t i = 0; i < lazy->excerpts().size(); ++i) {
+        ASSERT_TRUE(lazy->excerpts().at(i)->excerptScore());
+        EXPECT_EQ(writeScore(lazy->excerpts().at(i)->excerptScore()), writeScore(eager->excerpts().at(i)->excerptScore()));
+    }
+
+    delete eager;
+    delete lazy;
+
+    MScore::useRead302InTestMode = useRead302;
+}
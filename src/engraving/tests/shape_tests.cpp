@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+#include "dom/system.h"
+#include "infrastructure/shape.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String SHAPE_DATA_DIR(u"shape_data/");
+
+static constexpr size_t MAX_SCORE_PROBES = 64;
+
+class Engraving_ShapeTests : public ::testing::Test
+{
+public:
+    //! NOTE Reference implementations: plain walks over all elements
+    static double referenceRightMostEdgeAtHeight(const Shape& s, double yAbove, double yBelow)
+    {
+        double edge = -DBL_MAX;
+        for (const ShapeElement& sh : s.elements()) {
+            if (sh.bottom() > yAbove && sh.top() < yBelow) {
+                edge = std::max(edge, sh.right());
+            }
+        }
+        return edge;
+    }
+
+    static bool referenceIntersects(const Shape& s, const RectF& rr)
+    {
+        for (const ShapeElement& r : s.elements()) {
+            if (r.intersects(rr)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool referenceIntersects(const Shape& s, const Shape& other)
+    {
+        for (const ShapeElement& r : other.elements()) {
+            if (referenceIntersects(s, r)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool referenceContains(const Shape& s, const PointF& p)
+    {
+        for (const ShapeElement& r : s.elements()) {
+            if (r.contains(p)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static double referenceMinVerticalDistance(const Shape& s, const Shape& a)
+    {
+        if (s.empty() || a.empty()) {
+            return 0.0;
+        }
+        double dist = -DBL_MAX;
+        for (const ShapeElement& r2 : a.elements()) {
+            for (const ShapeElement& r1 : s.elements()) {
+                if (r1.height() > 0.0 && r2.height() > 0.0 && intersects(r1.left(), r1.right(), r2.left(), r2.right(), 0.0)) {
+                    dist = std::max(dist, r1.bottom() - r2.top());
+                }
+            }
+        }
+        return dist;
+    }
+
+    static Shape randomShape(std::mt19937& gen, size_t size)
+    {
+        std::uniform_real_distribution<double> pos(-200.0, 200.0);
+        std::uniform_real_distribution<double> extent(0.0, 30.0);
+
+        Shape s;
+        for (size_t i = 0; i < size; ++i) {
+            s.add(RectF(pos(gen), pos(gen), extent(gen), extent(gen)));
+        }
+        return s;
+    }
+
+    //! NOTE One shape per staff and system, made of the shapes of all its segments
+    static std::vector<Shape> staffShapes(const Score* score)
+    {
+        std::vector<Shape> shapes;
+        for (const System* system : score->systems()) {
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                Shape shape;
+                for (const MeasureBase* mb : system->measures()) {
+                    if (!mb->isMeasure()) {
+                        continue;
+                    }
+                    for (const Segment* s = toMeasure(mb)->first(); s; s = s->next()) {
+                        shape.add(s->staffShape(staffIdx).translated(s->pos() + mb->pos()));
+                    }
+                }
+                shapes.push_back(shape);
+            }
+        }
+        return shapes;
+    }
+};
+
+TEST_F(Engraving_ShapeTests, queriesMatchReference)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> pos(-220.0, 220.0);
+
+    for (size_t size : { 1, 4, 15, 16, 17, 64, 256 }) {
+        Shape shape = randomShape(gen, size);
+        for (int i = 0; i < 200; ++i) {
+            double y1 = pos(gen);
+            double y2 = y1 + std::abs(pos(gen)) / 4;
+            EXPECT_EQ(shape.rightMostEdgeAtHeight(y1, y2), referenceRightMostEdgeAtHeight(shape, y1, y2));
+
+            RectF r(pos(gen), pos(gen), 10.0, 10.0);
+            EXPECT_EQ(shape.intersects(r), referenceIntersects(shape, r));
+
+            PointF p(pos(gen), pos(gen));
+            EXPECT_EQ(shape.contains(p), referenceContains(shape, p));
+        }
+
+        Shape other = randomShape(gen, size);
+        EXPECT_EQ(shape.intersects(other), referenceIntersects(shape, other));
+        EXPECT_EQ(shape.minVerticalDistance(other), referenceMinVerticalDistance(shape, other));
+
+        // [WHEN] The shape is moved, the index must follow
+        shape.translate(PointF(3.0, -11.0));
+        EXPECT_EQ(shape.rightMostEdgeAtHeight(0.0, 40.0), referenceRightMostEdgeAtHeight(shape, 0.0, 40.0));
+        shape.add(RectF(0.0, 0.0, 500.0, 500.0));
+        EXPECT_EQ(shape.rightMostEdgeAtHeight(0.0, 40.0), referenceRightMostEdgeAtHeight(shape, 0.0, 40.0));
+    }
+}
+
+TEST_F(Engraving_ShapeTests, bboxIsKeptAcrossAdd)
+{
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> pos(-100.0, 100.0);
+
+    Shape shape;
+    RectF expected;
+    for (int i = 0; i < 100; ++i) {
+        RectF r(pos(gen), pos(gen), 5.0, 7.0);
+        shape.add(r);
+        expected.unite(r);
+        EXPECT_EQ(shape.bbox(), expected);
+    }
+
+    shape.clear();
+    EXPECT_TRUE(shape.bbox().isNull());
+}
+
+TEST_F(Engraving_ShapeTests, translateItemUpdatesIndex)
+{
+    MasterScore* score = ScoreRW::readScore(SHAPE_DATA_DIR + u"shapes.mscx");
+    ASSERT_TRUE(score);
+
+    std::mt19937 gen(13);
+    Shape shape = randomShape(gen, 64);
+
+    // [GIVEN] Some elements of an item in a shape with a built index
+    const EngravingItem* item = score->firstMeasure();
+    shape.add(RectF(0.0, 0.0, 10.0, 10.0), item);
+    shape.add(RectF(20.0, 5.0, 10.0, 10.0), item);
+    EXPECT_EQ(shape.rightMostEdgeAtHeight(300.0, 320.0), referenceRightMostEdgeAtHeight(shape, 300.0, 320.0));
+
+    // [WHEN] Only the elements of the item are moved
+    shape.translateItem(item, PointF(0.0, 305.0));
+
+    // [THEN] The queries see the new positions
+    EXPECT_EQ(shape.rightMostEdgeAtHeight(300.0, 320.0), 30.0);
+    EXPECT_EQ(shape.rightMostEdgeAtHeight(300.0, 320.0), referenceRightMostEdgeAtHeight(shape, 300.0, 320.0));
+    EXPECT_EQ(shape.bbox().bottom(), 320.0);
+
+    delete score;
+}
+
+TEST_F(Engraving_ShapeTests, scoreShapesMatchReference)
+{
+    // A few staves with chords, beams, slurs and articulations
+    MasterScore* score = ScoreRW::readScore(SHAPE_DATA_DIR + u"shapes.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<Shape> shapes = staffShapes(score);
+    ASSERT_FALSE(shapes.empty());
+
+    std::vector<RectF> elements;
+    for (const Shape& shape : shapes) {
+        for (const ShapeElement& e : shape.elements()) {
+            elements.push_back(e.adjusted(-2.0, -2.0, 2.0, 2.0));
+        }
+    }
+    ASSERT_FALSE(elements.empty());
+
+    //! NOTE Probes spread over the elements of all staves, so their number doesn't grow with the score
+    std::vector<RectF> probes;
+    const size_t step = std::max(elements.size() / MAX_SCORE_PROBES, size_t(1));
+    for (size_t i = 0; i < elements.size() && probes.size() < MAX_SCORE_PROBES; i += step) {
+        probes.push_back(elements.at(i));
+    }
+
+    for (const Shape& shape : shapes) {
+        for (const RectF& probe : probes) {
+            EXPECT_EQ(shape.intersects(probe), referenceIntersects(shape, probe));
+            EXPECT_EQ(shape.rightMostEdgeAtHeight(probe.top(), probe.bottom()),
+                      referenceRightMostEdgeAtHeight(shape, probe.top(), probe.bottom()));
+        }
+    }
+
+    delete score;
+}
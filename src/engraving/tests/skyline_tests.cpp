@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "dom/masterscore.h"
+#include "dom/system.h"
+#include "infrastructure/skyline.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+public:
+    struct RecordedLine {
+        bool north = true;
+        std::vector<SkylineSegment> segments;
+    };
+
+    //! NOTE Reference implementation: the merge over both lines, without early exit
+    static double referenceMinDistance(const SkylineLine& a, const SkylineLine& b)
+    {
+        double dist = -1000000.0;
+
+        double x1 = 0.0;
+        double x2 = 0.0;
+        auto k = b.begin();
+        for (auto i = a.begin(); i != a.end(); ++i) {
+            while (k != b.end() && (x2 + k->w) < x1) {
+                x2 += k->w;
+                ++k;
+            }
+            if (k == b.end()) {
+                break;
+            }
+            for (;;) {
+                if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
+                    dist = std::max(dist, i->y - k->y);
+                }
+                if (x2 + k->w < x1 + i->w) {
+                    x2 += k->w;
+                    ++k;
+                    if (k == b.end()) {
+                        break;
+                    }
+                } else {
+                    break;
+                }
+            }
+            if (k == b.end()) {
+                break;
+            }
+            x1 += i->w;
+        }
+        return dist;
+    }
+
+    static double referenceMax(const SkylineLine& l)
+    {
+        double val = l.isNorth() ? 1000000.0 : -1000000.0;
+        for (const SkylineSegment& s : l) {
+            val = l.isNorth() ? std::min(val, s.y) : std::max(val, s.y);
+        }
+        return val;
+    }
+
+    static double referenceMax(const SkylineLine& l, double from, double to)
+    {
+        double val = l.isNorth() ? 1000000.0 : -1000000.0;
+        for (const SkylineSegment& s : l) {
+            if (from <= s.x && s.x <= to) {
+                val = l.isNorth() ? std::min(val, s.y) : std::max(val, s.y);
+            }
+        }
+        return val;
+    }
+
+    static void replay(const RecordedLine& recorded, SkylineLine& line)
+    {
+        line.clear();
+        for (const SkylineSegment& s : recorded.segments) {
+            line.add(s.x, s.y, s.w);
+        }
+    }
+};
+
+TEST_F(Engraving_SkylineTests, matchesReferenceOnRandomLines)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> xDist(-5.0, 200.0);
+    std::uniform_real_distribution<double> wDist(0.0, 20.0);
+    std::uniform_real_distribution<double> yDist(-30.0, 30.0);
+
+    SkylineLine south(false);
+    SkylineLine north(true);
+
+    for (int round = 0; round < 200; ++round) {
+        south.clear();
+        north.clear();
+        EXPECT_EQ(south.max(), referenceMax(south));
+        EXPECT_EQ(north.max(), referenceMax(north));
+
+        for (int i = 0; i < 50; ++i) {
+            south.add(xDist(gen), yDist(gen), wDist(gen));
+            north.add(xDist(gen), yDist(gen) + 40.0, wDist(gen));
+
+            EXPECT_EQ(south.max(), referenceMax(south));
+            EXPECT_EQ(north.max(), referenceMax(north));
+            EXPECT_EQ(south.max(0.0, 100.0), referenceMax(south, 0.0, 100.0));
+        }
+
+        EXPECT_DOUBLE_EQ(south.minDistance(north), referenceMinDistance(south, north));
+        EXPECT_DOUBLE_EQ(north.minDistance(south), referenceMinDistance(north, south));
+
+        for (int i = 0; i < 20; ++i) {
+            double from = xDist(gen);
+            double to = from + wDist(gen) * i;
+            EXPECT_EQ(south.max(from, to), referenceMax(south, from, to));
+            EXPECT_EQ(north.max(from, to), referenceMax(north, from, to));
+        }
+        EXPECT_EQ(south.max(10.0, 5.0), referenceMax(south, 10.0, 5.0));
+    }
+}
+
+TEST_F(Engraving_SkylineTests, replayRecordedSkylines)
+{
+    // [GIVEN] Skylines of all staves of a laid out real score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<RecordedLine> recorded;
+    for (const System* system : score->systems()) {
+        for (const SysStaff* staff : system->staves()) {
+            const SkylineLine& north = staff->skyline().north();
+            const SkylineLine& south = staff->skyline().south();
+            recorded.push_back({ true, std::vector<SkylineSegment>(north.begin(), north.end()) });
+            recorded.push_back({ false, std::vector<SkylineSegment>(south.begin(), south.end()) });
+        }
+    }
+    delete score;
+
+    ASSERT_FALSE(recorded.empty());
+
+    // [WHEN] They are rebuilt and compared pairwise, like vertical spacing does
+    std::vector<SkylineLine> lines;
+    lines.reserve(recorded.size());
+    for (const RecordedLine& r : recorded) {
+        lines.emplace_back(r.north);
+    }
+
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        replay(recorded[i], lines[i]);
+    }
+
+    // [THEN] The results match the reference implementation
+    for (size_t i = 1; i < lines.size(); i += 2) {
+        EXPECT_EQ(lines[i].max(), referenceMax(lines[i]));
+        for (const SkylineSegment& s : recorded[i].segments) {
+            EXPECT_EQ(lines[i].max(s.x, s.x + 20.0), referenceMax(lines[i], s.x, s.x + 20.0));
+        }
+        for (size_t k = i + 1; k < lines.size(); k += 2) {
+            EXPECT_DOUBLE_EQ(lines[i].minDistance(lines[k]), referenceMinDistance(lines[i], lines[k]));
+        }
+    }
+}
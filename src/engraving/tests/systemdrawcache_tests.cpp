@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/page.h"
+#include "dom/system.h"
+#include "rendering/dev/systemdrawcache.h"
+
+#include "mocks/engravingconfigurationmock.h"
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering::dev;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_SystemDrawCacheTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        SystemDrawCache::setconfiguration(std::make_shared<::testing::NiceMock<EngravingConfigurationMock> >());
+    }
+
+    void TearDown() override
+    {
+        SystemDrawCache::setconfiguration(nullptr);
+    }
+
+    static void paint(SystemDrawCache& cache, const Page* page, double scale = 1.0)
+    {
+        Painter painter(std::make_shared<BufferedPaintProvider>(), "test");
+        painter.scale(scale, scale);
+        cache.paintPage(painter, page, page->ldata()->bbox());
+        painter.endDraw();
+    }
+
+    //! NOTE Where each system of the page is and which layout it has
+    using SystemStates = std::vector<std::pair<uint64_t, PointF> >;
+
+    static SystemStates systemStates(const Page* page)
+    {
+        SystemStates states;
+        for (const System* system : page->systems()) {
+            states.push_back({ system->layoutId(), system->pagePos() });
+        }
+        std::sort(states.begin(), states.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        return states;
+    }
+
+    //! NOTE The number of systems that were laid out again or moved
+    static size_t changedSystemsCount(const Page* page, const SystemStates& before)
+    {
+        size_t count = 0;
+        for (const System* system : page->systems()) {
+            auto it = std::find(before.begin(), before.end(), std::make_pair(system->layoutId(), system->pagePos()));
+            if (it == before.end()) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    static void changeStretch(MasterScore* score, Measure* m, double stretch)
+    {
+        score->startCmd();
+        m->undoChangeProperty(Pid::USER_STRETCH, stretch);
+        score->endCmd();
+    }
+
+    static Measure* middleMeasure(MasterScore* score)
+    {
+        Measure* m = score->firstMeasure();
+        for (int i = 0; i < 6 && m->nextMeasure(); ++i) {
+            m = m->nextMeasure();
+        }
+        return m;
+    }
+};
+
+TEST_F(Engraving_SystemDrawCacheTests, reuseAtSameLayoutAndScale)
+{
+    // [GIVEN] A laid out score with several systems on its first page
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+    const Page* page = score->pages().front();
+    const size_t systemsCount = page->systems().size();
+    ASSERT_GT(systemsCount, 1u);
+
+    SystemDrawCache cache;
+
+    // [WHEN] The page is painted
+    paint(cache, page);
+
+    // [THEN] Each system is recorded once
+    EXPECT_EQ(cache.recordsCount(), systemsCount);
+    EXPECT_EQ(cache.entriesCount(), systemsCount);
+
+    // [WHEN] It is painted again with the same layout and zoom
+    paint(cache, page);
+
+    // [THEN] The recordings are replayed
+    EXPECT_EQ(cache.recordsCount(), systemsCount);
+
+    // [WHEN] It is painted at another zoom, twice
+    paint(cache, page, 2.0);
+    paint(cache, page, 2.0);
+
+    // [THEN] The systems are recorded once more, replacing the recordings of the other zoom
+    EXPECT_EQ(cache.recordsCount(), 2 * systemsCount);
+    EXPECT_EQ(cache.entriesCount(), systemsCount);
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDrawCacheTests, invalidatedAfterRelayout)
+{
+    // [GIVEN] A painted page
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    const Page* page = score->pages().front();
+
+    SystemDrawCache cache;
+    paint(cache, page);
+    const size_t recordsCount = cache.recordsCount();
+
+    // [WHEN] A measure in the middle of the page is stretched and the page is painted
+    SystemStates before = systemStates(page);
+    changeStretch(score, middleMeasure(score), 1.5);
+    const size_t changedCount = changedSystemsCount(page, before);
+    ASSERT_GT(changedCount, 0u);
+    paint(cache, page);
+
+    // [THEN] Only the systems that were laid out again or moved are recorded again
+    EXPECT_EQ(cache.recordsCount(), recordsCount + changedCount);
+    EXPECT_EQ(cache.entriesCount(), page->systems().size());
+
+    // [WHEN] The whole score is laid out again
+    score->doLayout();
+    paint(cache, page);
+
+    // [THEN] All systems are recorded again
+    EXPECT_EQ(cache.recordsCount(), recordsCount + changedCount + page->systems().size());
+    EXPECT_EQ(cache.entriesCount(), page->systems().size());
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDrawCacheTests, boundedAcrossRelayouts)
+{
+    // [GIVEN] A painted page
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    SystemDrawCache cache;
+    paint(cache, score->pages().front());
+
+    // [WHEN] The score is edited and laid out again many times, painting after each edit
+    Measure* m = middleMeasure(score);
+    for (int i = 0; i < 20; ++i) {
+        changeStretch(score, m, (i % 2) ? 1.0 : 1.5);
+        if (i % 5 == 0) {
+            score->doLayout();
+        }
+        paint(cache, score->pages().front());
+
+        // [THEN] There is never more than one recording per system of the score
+        EXPECT_LE(cache.entriesCount(), score->systems().size());
+    }
+
+    // [WHEN] The score is shown in continuous view
+    score->setLayoutMode(LayoutMode::LINE);
+    score->doLayout();
+    paint(cache, score->pages().front());
+
+    // [THEN] Its only system is painted without being recorded
+    EXPECT_EQ(cache.entriesCount(), 0u);
+
+    delete score;
+}
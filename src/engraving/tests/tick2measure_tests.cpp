@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String MEASURE_DATA_DIR(u"measure_data/");
+
+class Engraving_Tick2MeasureTests : public ::testing::Test
+{
+public:
+    //! NOTE Reference implementation: a linear walk over the measure chain
+    static Measure* linearTick2measure(const Score* score, const Fraction& tick, bool mm)
+    {
+        Measure* lm = nullptr;
+        for (Measure* m = mm ? score->firstMeasureMM() : score->firstMeasure(); m; m = mm ? m->nextMeasureMM() : m->nextMeasure()) {
+            if (tick < m->tick()) {
+                return lm;
+            }
+            lm = m;
+        }
+        if (lm && tick <= lm->endTick()) {
+            return lm;
+        }
+        return nullptr;
+    }
+
+    static MasterScore* createScore(int measures)
+    {
+        MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+        EXPECT_TRUE(score);
+
+        score->startCmd();
+        score->appendMeasures(measures - static_cast<int>(score->nmeasures()));
+        score->endCmd();
+
+        return score;
+    }
+
+    static void checkAllTicks(const Score* score)
+    {
+        for (const Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            for (const Fraction& tick : { m->tick(), m->tick() + m->ticks() / 2, m->endTick() }) {
+                EXPECT_EQ(score->tick2measure(tick), linearTick2measure(score, tick, false));
+                EXPECT_EQ(score->tick2measureMM(tick), linearTick2measure(score, tick, true));
+                EXPECT_EQ(score->tick2measureBase(tick), tick < score->lastMeasure()->endTick()
+                          ? linearTick2measure(score, tick, false) : nullptr);
+            }
+        }
+    }
+};
+
+TEST_F(Engraving_Tick2MeasureTests, lookupMatchesLinearWalk)
+{
+    MasterScore* score = createScore(64);
+    checkAllTicks(score);
+
+    // [WHEN] Measures are removed, the index must be rebuilt
+    score->startCmd();
+    Measure* m = score->firstMeasure()->nextMeasure();
+    score->deleteMeasures(m, m->nextMeasure()->nextMeasure());
+    score->endCmd();
+    checkAllTicks(score);
+
+    // [WHEN] The removal is undone, ticks shift back
+    score->undoRedo(true, nullptr);
+    checkAllTicks(score);
+
+    delete score;
+}
+
+TEST_F(Engraving_Tick2MeasureTests, lookupWithMMRests)
+{
+    MasterScore* score = createScore(64);
+
+    // [WHEN] Multimeasure rests replace the empty measures
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::createMultiMeasureRests, true);
+    score->endCmd();
+    checkAllTicks(score);
+
+    // [WHEN] They are switched off again
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::createMultiMeasureRests, false);
+    score->endCmd();
+    checkAllTicks(score);
+
+    delete score;
+}
+
+TEST_F(Engraving_Tick2MeasureTests, lookupAfterChangeMMRest)
+{
+    MasterScore* score = createScore(64);
+
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::createMultiMeasureRests, true);
+    score->endCmd();
+
+    // [GIVEN] A multimeasure rest covering several measures
+    Measure* first = nullptr;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (m->hasMMRest() && m->mmRest()->mmRestCount() >= 3) {
+            first = m;
+            break;
+        }
+    }
+    ASSERT_TRUE(first);
+    Measure* mmRest = first->mmRest();
+    const Fraction insideTick = first->nextMeasure()->nextMeasure()->tick();
+
+    // [WHEN] It is removed without a layout, and the index is built without it
+    ChangeMMRest remove(first, nullptr);
+    remove.redo(nullptr);
+    checkAllTicks(score);
+    EXPECT_EQ(score->tick2measureMM(insideTick), first->nextMeasure()->nextMeasure());
+
+    // [WHEN] It is set again, its neighbours in the index still match the measure list
+    ChangeMMRest add(first, mmRest);
+    add.redo(nullptr);
+
+    // [THEN] The lookup finds the multimeasure rest, not the measure it replaces
+    EXPECT_EQ(score->tick2measureMM(insideTick), mmRest);
+    checkAllTicks(score);
+
+    // [WHEN] The change is undone
+    add.undo(nullptr);
+
+    // [THEN] The measure is found again
+    EXPECT_EQ(score->tick2measureMM(insideTick), first->nextMeasure()->nextMeasure());
+    checkAllTicks(score);
+
+    add.redo(nullptr);
+    delete score;
+}
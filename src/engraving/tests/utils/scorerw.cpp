@@ -28,6 +28,10 @@
 #include "engraving/compat/scoreaccess.h"
 #include "engraving/compat/mscxcompat.h"
 #include "engraving/infrastructure/localfileinfoprovider.h"
+#include "engraving/infrastructure/mscreader.h"
+#include "engraving/infrastructure/mscwriter.h"
+#include "engraving/rw/mscloader.h"
+#include "engraving/rw/mscsaver.h"
 #include "engraving/rw/read400/tread.h"
 #include "engraving/rw/write/twrite.h"
 #include "engraving/rw/rwregister.h"
@@ -161,3 +165,49 @@ bool ScoreRW::saveMimeData(ByteArray mimeData, const String& saveName)
     size_t size = f.write(mimeData);
     return size == mimeData.size();
 }
+
+ByteArray ScoreRW::writeMscz(MasterScore* score)
+{
+    ByteArray msczData;
+    Buffer buf(&msczData);
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = u"test.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscWriter writer(params);
+    writer.open();
+    MscSaver().writeMscz(score, writer, false, false);
+    writer.close();
+
+    return msczData;
+}
+
+MasterScore* ScoreRW::readMscz(const ByteArray& msczData, bool lazyExcerpts, bool ignoreVersionError)
+{
+    ByteArray data = msczData;
+    Buffer buf(&data);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = u"test.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    if (!reader.open()) {
+        LOGE() << "can't open mscz";
+        return nullptr;
+    }
+
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(params.filePath));
+
+    SettingsCompat settingsCompat;
+    Ret ret = MscLoader().loadMscz(score, reader, settingsCompat, ignoreVersionError, lazyExcerpts);
+    if (!ret) {
+        LOGE() << "can't load mscz: " << ret.toString();
+        delete score;
+        return nullptr;
+    }
+
+    return score;
+}
@@ -48,6 +48,10 @@ public:
     static EngravingItem* writeReadElement(EngravingItem* element);
     static bool saveMimeData(ByteArray mimeData, const String& saveName);
 
+    //! NOTE Saves to and loads from a .mscz in memory, the loaded score isn't laid out
+    static ByteArray writeMscz(MasterScore* score);
+    static MasterScore* readMscz(const ByteArray& msczData, bool lazyExcerpts = false, bool ignoreVersionError = false);
+
 private:
     static String m_rootPath;
 };
@@ -268,6 +268,11 @@ void AudioModule::setupAudioDriver(const framework::IApplication::RunMode& mode)
         m_audioBuffer->pop(reinterpret_cast<float*>(stream), samplesPerChannel);
     };
 
+    //! NOTE Set before the driver is opened, it's called on the driver thread
+    m_audioBuffer->setOnLowWaterMark([this]() {
+        m_audioWorker->wakeUp();
+    });
+
     if (mode == framework::IApplication::RunMode::GuiApp) {
         m_audioDriver->init();
 
@@ -283,6 +288,15 @@ void AudioModule::setupAudioDriver(const framework::IApplication::RunMode& mode)
     setupAudioWorker(requiredSpec);
 }
 
+void AudioModule::setAudioWorkerInterval(unsigned int bufferSize, unsigned int sampleRate)
+{
+    if (bufferSize == 0 || sampleRate == 0) {
+        return;
+    }
+
+    m_audioWorker->setInterval(std::chrono::microseconds(uint64_t(bufferSize) * 1000000 / sampleRate));
+}
+
 void AudioModule::setupAudioWorker(const IAudioDriver::Spec& activeSpec)
 {
     auto workerSetup = [this, activeSpec]() {
@@ -308,5 +322,13 @@ void AudioModule::setupAudioWorker(const IAudioDriver::Spec& activeSpec)
         m_audioBuffer->forward();
     };
 
+    //! NOTE The worker is woken up by the calls queued for it, by the driver (see setupAudioDriver),
+    //! and at the latest once per driver buffer period
+    setAudioWorkerInterval(activeSpec.samples, activeSpec.sampleRate);
+
+    m_configuration->driverBufferSizeChanged().onNotify(this, [this]() {
+        setAudioWorkerInterval(m_configuration->driverBufferSize(), m_configuration->sampleRate());
+    });
+
     m_audioWorker->run(workerSetup, workerLoopBody);
 }
@@ -64,6 +64,7 @@ public:
 
 private:
     void setupAudioDriver(const framework::IApplication::RunMode& mode);
+    void setAudioWorkerInterval(unsigned int bufferSize, unsigned int sampleRate);
     void setupAudioWorker(const IAudioDriver::Spec& activeSpec);
 
     std::shared_ptr<AudioConfiguration> m_configuration;
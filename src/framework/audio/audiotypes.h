@@ -24,6 +24,8 @@
 #define MU_AUDIO_AUDIOTYPES_H
 
 #include <variant>
+#include <array>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -92,6 +94,17 @@ struct SoundTrackFormat {
     }
 };
 
+//! NOTE A sound track mixed from the outputs of some of the tracks, e.g. the audio of one part.
+//! The tracks that aren't listed are left out.
+//! The master stem is the master output instead, with the aux channels and the master fx
+struct SoundTrackStem {
+    io::path_t destination;
+    std::map<TrackId, gain_t> trackGains;
+    bool isMaster = false;
+};
+
+using SoundTrackStemList = std::vector<SoundTrackStem>;
+
 using AudioSourceName = std::string;
 using AudioResourceId = std::string;
 using AudioResourceIdList = std::vector<AudioResourceId>;
@@ -336,7 +349,7 @@ using AudioSignalChanges = async::Channel<audioch_t, AudioSignalVal>;
 struct AudioSignalsNotifier {
     void updateSignalValues(const audioch_t audioChNumber, const float newAmplitude, const volume_dbfs_t newPressure)
     {
-        AudioSignalVal& signalVal = m_signalValuesMap[audioChNumber];
+        AudioSignalVal& signalVal = m_signalValues[audioChNumber];
 
         volume_dbfs_t validatedPressure = std::max(newPressure, MINIMUM_OPERABLE_DBFS_LEVEL);
 
@@ -351,7 +364,10 @@ struct AudioSignalsNotifier {
         signalVal.amplitude = newAmplitude;
         signalVal.pressure = validatedPressure;
 
-        audioSignalChanges.send(audioChNumber, signalVal);
+        //! NOTE Sending allocates, which is avoided on the audio thread when nobody listens
+        if (audioSignalChanges.isConnected()) {
+            audioSignalChanges.send(audioChNumber, signalVal);
+        }
     }
 
     AudioSignalChanges audioSignalChanges;
@@ -360,7 +376,7 @@ private:
     static constexpr volume_dbfs_t PRESSURE_MINIMAL_VALUABLE_DIFF = 2.5f;
     static constexpr volume_dbfs_t MINIMUM_OPERABLE_DBFS_LEVEL = -100.f;
 
-    std::map<audioch_t, AudioSignalVal> m_signalValuesMap;
+    std::array<AudioSignalVal, std::numeric_limits<audioch_t>::max() + 1> m_signalValues;
 };
 
 enum class PlaybackStatus {
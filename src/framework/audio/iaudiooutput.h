@@ -53,6 +53,10 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+
+    //! NOTE Renders the tracks once and writes each stem to its own file
+    virtual async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackStemList& stems,
+                                                     const SoundTrackFormat& format) = 0;
     virtual void abortSavingAllSoundTracks() = 0;
 
     virtual framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
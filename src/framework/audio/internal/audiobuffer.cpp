@@ -28,6 +28,7 @@ using namespace mu::audio;
 
 static constexpr size_t DEFAULT_SIZE_PER_CHANNEL = 1024 * 8;
 static constexpr size_t DEFAULT_SIZE = DEFAULT_SIZE_PER_CHANNEL * 2;
+static constexpr size_t MIN_LOW_WATER_MARK = DEFAULT_SIZE / 4;
 
 static const std::vector<float> SILENT_FRAMES(DEFAULT_SIZE, 0.f);
 
@@ -114,6 +115,8 @@ void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t rende
     m_renderStep = renderStep;
 
     m_data.resize(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+
+    setMinSamplesToReserve(m_minSamplesToReserve);
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
@@ -156,6 +159,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
     if (currentReadIdx == currentWriteIdx) { // empty queue
         std::memcpy(dest, SILENT_FRAMES.data(), sampleCount * sizeof(float) * m_audioChannelsCount);
+
+        if (m_onLowWaterMark) {
+            m_onLowWaterMark();
+        }
         return;
     }
 
@@ -189,6 +196,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     }
 
     m_readIndex.store(newReadIdx, std::memory_order_release);
+
+    if (m_onLowWaterMark && reservedFrames(currentWriteIdx, newReadIdx) < m_lowWaterMark.load(std::memory_order_relaxed)) {
+        m_onLowWaterMark();
+    }
 }
 
 void AudioBuffer::setMinSamplesToReserve(size_t lag)
@@ -197,6 +208,15 @@ void AudioBuffer::setMinSamplesToReserve(size_t lag)
         lag = DEFAULT_SIZE;
     }
     m_minSamplesToReserve = lag;
+
+    //! NOTE Enough for two reads of the driver, but below what forward() fills up to
+    size_t lowWaterMark = std::max(MIN_LOW_WATER_MARK, 2 * lag * m_audioChannelsCount);
+    m_lowWaterMark.store(std::min(lowWaterMark, DEFAULT_SIZE / 2), std::memory_order_relaxed);
+}
+
+void AudioBuffer::setOnLowWaterMark(const std::function<void()>& f)
+{
+    m_onLowWaterMark = f;
 }
 
 void AudioBuffer::reset()
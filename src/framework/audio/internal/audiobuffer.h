@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
@@ -56,6 +57,9 @@ public:
     void pop(float* dest, size_t sampleCount);
     void setMinSamplesToReserve(size_t lag);
 
+    //! NOTE Called by pop, on the driver thread, when less than the low-water mark is left to read
+    void setOnLowWaterMark(const std::function<void()>& f);
+
     void reset();
 
 private:
@@ -63,6 +67,8 @@ private:
     size_t incrementWriteIndex(const size_t writeIdx, const samples_t samplesPerChannel);
 
     size_t m_minSamplesToReserve = 0;
+    std::atomic<size_t> m_lowWaterMark = 0;
+    std::function<void()> m_onLowWaterMark;
 
     alignas(cache_line_size) std::atomic<size_t> m_writeIndex = 0;
     alignas(cache_line_size) std::atomic<size_t> m_readIndex = 0;
@@ -29,6 +29,7 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isWorkerPoolThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -59,5 +60,10 @@ bool AudioSanitizer::isWorkerThread()
 {
     std::thread::id id = std::this_thread::get_id();
 
-    return TaskScheduler::instance()->containsThread(id) || id == s_as_workerThreadID;
+    return TaskScheduler::instance()->containsThread(id) || id == s_as_workerThreadID || s_as_isWorkerPoolThread;
+}
+
+void AudioSanitizer::setupWorkerPoolThread()
+{
+    s_as_isWorkerPoolThread = true;
 }
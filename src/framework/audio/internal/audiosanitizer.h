@@ -39,6 +39,9 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE The threads that process the tracks for the worker thread
+    static void setupWorkerPoolThread();
 };
 }
 
@@ -31,6 +31,13 @@
 
 using namespace mu::audio;
 
+using Clock = std::chrono::steady_clock;
+
+static int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
 std::thread::id AudioThread::ID;
 
 AudioThread::~AudioThread()
@@ -61,7 +68,12 @@ void AudioThread::run(const Runnable& onStart, const Runnable& loopBody)
 void AudioThread::stop(const Runnable& onFinished)
 {
     m_onFinished = onFinished;
-    m_running = false;
+    {
+        std::lock_guard lock(m_wakeUpMutex);
+        m_running = false;
+    }
+    m_wakeUpCv.notify_one();
+
     if (m_thread) {
         m_thread->join();
     }
@@ -72,26 +84,114 @@ bool AudioThread::isRunning() const
     return m_running;
 }
 
+void AudioThread::setInterval(std::chrono::microseconds interval)
+{
+    m_intervalUs = std::max(interval.count(), int64_t(1));
+}
+
+void AudioThread::setMetricsPeriod(std::chrono::milliseconds period)
+{
+    m_metricsPeriodMs = std::max(period.count(), int64_t(1));
+}
+
+void AudioThread::wakeUp()
+{
+    //! NOTE A pending request has already notified the thread, the driver calls this on every
+    //! callback below the low water mark, so the repeated calls mustn't notify again
+    if (m_wakeUpRequestTimeNs.load() != 0) {
+        return;
+    }
+
+    int64_t noRequest = 0;
+    if (!m_wakeUpRequestTimeNs.compare_exchange_strong(noRequest, nowNs())) {
+        return;
+    }
+
+    //! NOTE Without the lock a notification can come between the check and the wait,
+    //! then the thread wakes up at the end of the interval, as if it had no request
+    {
+        std::lock_guard lock(m_wakeUpMutex);
+    }
+    m_wakeUpCv.notify_one();
+}
+
+AudioThread::Metrics AudioThread::metrics() const
+{
+    std::lock_guard lock(m_metricsMutex);
+    return m_metrics;
+}
+
 void AudioThread::main()
 {
     mu::runtime::setThreadName("audio_worker");
 
     AudioThread::ID = std::this_thread::get_id();
 
+    mu::async::onThreadInvoke([this]() {
+        wakeUp();
+    });
+
     if (m_onStart) {
         m_onStart();
     }
 
+    Clock::time_point metricsStart = Clock::now();
+    uint64_t wakeUpsCount = 0;
+    uint64_t latencyCount = 0;
+    int64_t latencySumNs = 0;
+    int64_t latencyMaxNs = 0;
+
     while (m_running) {
+        //! NOTE Taken before the body, so that a request made while it runs (a call queued for
+        //! the thread, the driver asking for the next block) wakes the thread up right after it
+        int64_t requestTimeNs = m_wakeUpRequestTimeNs.exchange(0);
+
         mu::async::processEvents();
 
         if (m_mainLoopBody) {
             m_mainLoopBody();
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (requestTimeNs != 0) {
+            int64_t latencyNs = nowNs() - requestTimeNs;
+            latencySumNs += latencyNs;
+            latencyMaxNs = std::max(latencyMaxNs, latencyNs);
+            ++latencyCount;
+        }
+
+        Clock::duration elapsed = Clock::now() - metricsStart;
+        if (elapsed >= std::chrono::milliseconds(m_metricsPeriodMs.load())) {
+            Metrics metrics;
+            metrics.wakeUpsPerSecond = wakeUpsCount / std::chrono::duration<double>(elapsed).count();
+            metrics.blockReadyLatencyAvgUs = latencyCount ? latencySumNs / 1000.0 / latencyCount : 0.0;
+            metrics.blockReadyLatencyMaxUs = latencyMaxNs / 1000.0;
+
+            LOGD() << "wake ups per second: " << metrics.wakeUpsPerSecond
+                   << ", block ready latency avg: " << metrics.blockReadyLatencyAvgUs << " us"
+                   << ", max: " << metrics.blockReadyLatencyMaxUs << " us";
+
+            {
+                std::lock_guard lock(m_metricsMutex);
+                m_metrics = metrics;
+            }
+
+            metricsStart = Clock::now();
+            wakeUpsCount = 0;
+            latencyCount = 0;
+            latencySumNs = 0;
+            latencyMaxNs = 0;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+        m_wakeUpCv.wait_for(lock, std::chrono::microseconds(m_intervalUs.load()), [this]() {
+            return m_wakeUpRequestTimeNs.load() != 0 || !m_running;
+        });
+
+        ++wakeUpsCount;
     }
 
+    mu::async::onThreadInvoke(nullptr);
+
     if (m_onFinished) {
         m_onFinished();
     }
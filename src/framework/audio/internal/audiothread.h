@@ -26,7 +26,10 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 
 namespace mu::audio {
 class AudioThread
@@ -43,6 +46,24 @@ public:
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    //! NOTE The loop body runs when the thread is woken up, and at the latest after the interval
+    void setInterval(std::chrono::microseconds interval);
+
+    //! NOTE Can be called from any thread, the driver one too. Only the first call of a request
+    //! takes the lock, briefly, so that its notification can't be lost. The calls queued for the thread wake it up too
+    void wakeUp();
+
+    struct Metrics {
+        double wakeUpsPerSecond = 0.0;
+        //! NOTE From the first wake up request to the end of the loop body
+        double blockReadyLatencyAvgUs = 0.0;
+        double blockReadyLatencyMaxUs = 0.0;
+    };
+
+    //! NOTE Of the last complete metrics period
+    Metrics metrics() const;
+    void setMetricsPeriod(std::chrono::milliseconds period);
+
 private:
     void main();
 
@@ -52,6 +73,17 @@ private:
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    std::atomic<int64_t> m_intervalUs = 2000;
+
+    //! NOTE Time of the first request since the loop body last started, 0 if none
+    std::atomic<int64_t> m_wakeUpRequestTimeNs = 0;
+    std::mutex m_wakeUpMutex;
+    std::condition_variable m_wakeUpCv;
+
+    std::atomic<int64_t> m_metricsPeriodMs = 10000;
+    mutable std::mutex m_metricsMutex;
+    Metrics m_metrics;
 };
 using AudioThreadPtr = std::shared_ptr<AudioThread>;
 }
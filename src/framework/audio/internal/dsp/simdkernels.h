@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_SIMDKERNELS_H
+#define MU_AUDIO_SIMDKERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "audiotypes.h"
+
+#include "internal/fx/reverb/simdtypes.h"
+
+//
+// Vectorized kernels for the per-sample loops of the mixer and the dsp processors.
+// The buffers don't need to be aligned, the remainder of a block that doesn't fill
+// a vector is processed sample by sample.
+//
+
+namespace mu::audio::dsp {
+namespace simd = mu::audio::fx::simd;
+
+static constexpr size_t SIMD_WIDTH = 4;
+
+//! NOTE Enough for any audioch_t, lets the callers keep the per-channel values on the stack
+static constexpr size_t MAX_AUDIO_CHANNELS_COUNT = std::numeric_limits<audioch_t>::max() + 1;
+
+inline float horizontalMax(const simd::float_x4& v)
+{
+    return std::max(std::max(v[0], v[1]), std::max(v[2], v[3]));
+}
+
+/// returns the peak absolute value of the samples
+inline float peak(const float* buffer, size_t count)
+{
+    size_t vectorCount = count - count % SIMD_WIDTH;
+    simd::float_x4 peakValues(0.f);
+
+    for (size_t i = 0; i < vectorCount; i += SIMD_WIDTH) {
+        peakValues = simd::max(peakValues, simd::abs(simd::load(buffer + i)));
+    }
+
+    float result = horizontalMax(peakValues);
+    for (size_t i = vectorCount; i < count; ++i) {
+        result = std::max(result, std::abs(buffer[i]));
+    }
+
+    return result;
+}
+
+/// adds the samples of src to dest, returns the peak absolute value of src
+inline float mixAdd(float* dest, const float* src, size_t count)
+{
+    size_t vectorCount = count - count % SIMD_WIDTH;
+    simd::float_x4 peakValues(0.f);
+
+    for (size_t i = 0; i < vectorCount; i += SIMD_WIDTH) {
+        simd::float_x4 sample = simd::load(src + i);
+        simd::store(dest + i, simd::load(dest + i) + sample);
+        peakValues = simd::max(peakValues, simd::abs(sample));
+    }
+
+    float result = horizontalMax(peakValues);
+    for (size_t i = vectorCount; i < count; ++i) {
+        dest[i] += src[i];
+        result = std::max(result, std::abs(src[i]));
+    }
+
+    return result;
+}
+
+/// adds the samples of src multiplied by gain to dest
+inline void mixAddScaled(float* dest, const float* src, float gain, size_t count)
+{
+    size_t vectorCount = count - count % SIMD_WIDTH;
+    simd::float_x4 gains(gain);
+
+    for (size_t i = 0; i < vectorCount; i += SIMD_WIDTH) {
+        simd::store(dest + i, simd::load(dest + i) + simd::load(src + i) * gains);
+    }
+
+    for (size_t i = vectorCount; i < count; ++i) {
+        dest[i] += src[i] * gain;
+    }
+}
+
+/// multiplies all the samples by gain
+inline void applyGain(float* buffer, float gain, size_t count)
+{
+    size_t vectorCount = count - count % SIMD_WIDTH;
+    simd::float_x4 gains(gain);
+
+    for (size_t i = 0; i < vectorCount; i += SIMD_WIDTH) {
+        simd::store(buffer + i, simd::load(buffer + i) * gains);
+    }
+
+    for (size_t i = vectorCount; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+/// multiplies the interleaved samples by the gain of their channel (volume and balance),
+/// adds the squares of the results to squaredSums (one per channel) for the RMS metering
+/// and returns the peak absolute value of the results
+inline float applyChannelGains(float* buffer, audioch_t channelsCount, samples_t samplesPerChannel,
+                               const float* gains, float* squaredSums)
+{
+    size_t count = static_cast<size_t>(samplesPerChannel) * channelsCount;
+    size_t vectorCount = 0;
+    float result = 0.f;
+
+    //! NOTE Mono, stereo and quad frames fill the vectors evenly,
+    //! so every lane always holds the same channel
+    if (channelsCount != 0 && SIMD_WIDTH % channelsCount == 0) {
+        vectorCount = count - count % SIMD_WIDTH;
+
+        simd::float_x4 laneGains(gains[0 % channelsCount], gains[1 % channelsCount],
+                                 gains[2 % channelsCount], gains[3 % channelsCount]);
+        simd::float_x4 laneSquaredSums(0.f);
+        simd::float_x4 peakValues(0.f);
+
+        for (size_t i = 0; i < vectorCount; i += SIMD_WIDTH) {
+            simd::float_x4 sample = simd::load(buffer + i) * laneGains;
+            simd::store(buffer + i, sample);
+            laneSquaredSums = laneSquaredSums + sample * sample;
+            peakValues = simd::max(peakValues, simd::abs(sample));
+        }
+
+        for (size_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+            squaredSums[lane % channelsCount] += laneSquaredSums[static_cast<int>(lane)];
+        }
+
+        result = horizontalMax(peakValues);
+    }
+
+    for (size_t i = vectorCount; i < count; ++i) {
+        audioch_t audioChNum = static_cast<audioch_t>(i % channelsCount);
+        float sample = buffer[i] * gains[audioChNum];
+        buffer[i] = sample;
+        squaredSums[audioChNum] += sample * sample;
+        result = std::max(result, std::abs(sample));
+    }
+
+    return result;
+}
+}
+
+#endif // MU_AUDIO_SIMDKERNELS_H
@@ -44,7 +44,9 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    //! NOTE blockSamplesPerChannel is the most samples per channel given to encode() at once
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                      const samples_t blockSamplesPerChannel)
     {
         if (!format.isValid()) {
             return false;
@@ -56,7 +58,7 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
+        prepareOutputBuffer(blockSamplesPerChannel);
 
         return true;
     }
@@ -66,6 +68,8 @@ public:
         return m_format;
     }
 
+    //! NOTE Can be called several times with the consecutive blocks of the sound track,
+    //! flush() completes the file after the last one
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
@@ -75,7 +79,7 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t blockSamplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -106,15 +110,16 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t blockSamplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        m_outputBuffer.resize(requiredOutputBufferSize(blockSamplesPerChannel));
     }
 
     virtual void closeDestination()
     {
         if (m_fileStream) {
             std::fclose(m_fileStream);
+            m_fileStream = nullptr;
         }
 
         completeWriting();
@@ -55,7 +55,14 @@ struct FlacHandler : public FLAC::Encoder::File
     ProgressCallBack m_callBack;
 };
 
-bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+FlacEncoder::~FlacEncoder()
+{
+    //! NOTE The base destructor only closes its own destination
+    closeDestination();
+}
+
+bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                       const samples_t blockSamplesPerChannel)
 {
     if (!format.isValid()) {
         return false;
@@ -92,7 +99,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         return false;
     }
 
-    prepareOutputBuffer(totalSamplesNumber);
+    prepareOutputBuffer(blockSamplesPerChannel);
 
     return true;
 }
@@ -103,30 +110,20 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
     size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
 
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
+    std::vector<FLAC__int32> buff(totalSamplesNumber);
 
     for (size_t i = 0; i < buff.size(); ++i) {
         buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
-
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    //! NOTE The encoder collects the samples into frames itself
+    if (!m_flac->process_interleaved(buff.data(), static_cast<uint32_t>(samplesPerChannel))) {
+        return 0;
     }
 
-    return result;
+    return totalSamplesNumber;
 }
 
 size_t FlacEncoder::flush()
@@ -135,9 +132,10 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t /*blockSamplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    //! NOTE The encoder writes the file itself
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -156,4 +154,5 @@ bool FlacEncoder::openDestination(const io::path_t& path)
 void FlacEncoder::closeDestination()
 {
     delete m_flac;
+    m_flac = nullptr;
 }
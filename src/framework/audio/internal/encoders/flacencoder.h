@@ -31,13 +31,16 @@ namespace mu::audio::encode {
 class FlacEncoder : public AbstractAudioEncoder
 {
 public:
-    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber) override;
+    ~FlacEncoder() override;
+
+    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+              const samples_t blockSamplesPerChannel) override;
 
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
 protected:
-    size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const override;
+    size_t requiredOutputBufferSize(samples_t blockSamplesPerChannel) const override;
     bool openDestination(const io::path_t& path) override;
     void closeDestination() override;
 
@@ -64,11 +64,18 @@ struct LameHandler
     lame_global_flags* flags = nullptr;
 };
 
-bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+Mp3Encoder::~Mp3Encoder()
+{
+    //! NOTE The base destructor only closes its own destination
+    closeDestination();
+}
+
+bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                      const samples_t blockSamplesPerChannel)
 {
     m_handler = new LameHandler();
 
-    if (!AbstractAudioEncoder::init(path, format, totalSamplesNumber)) {
+    if (!AbstractAudioEncoder::init(path, format, totalSamplesNumber, blockSamplesPerChannel)) {
         return false;
     }
 
@@ -79,11 +86,12 @@ bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, co
     return true;
 }
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t blockSamplesPerChannel) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, the worst case for one call of lame_encode_buffer,
+    //!     it's also enough for lame_encode_flush
 
-    return totalSamplesNumber;
+    return 1.25 * blockSamplesPerChannel + 7200;
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
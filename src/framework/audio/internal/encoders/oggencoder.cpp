@@ -29,10 +29,16 @@
 using namespace mu::audio;
 using namespace mu::audio::encode;
 
+OggEncoder::~OggEncoder()
+{
+    //! NOTE The base destructor only closes its own destination
+    closeDestination();
+}
+
 size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
     m_progress.progressChanged.send(0, 100, "");
-    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
+    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel);
     m_progress.progressChanged.send(100, 100, "");
 
     return code == OPE_OK ? samplesPerChannel : 0;
@@ -40,10 +46,11 @@ size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 
 size_t OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    //! NOTE Writes the samples still buffered by the encoder and the end of the stream
+    return ope_encoder_drain(m_opusEncoder);
 }
 
-size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
+size_t OggEncoder::requiredOutputBufferSize(samples_t /*blockSamplesPerChannel*/) const
 {
     return 0;
 }
@@ -56,8 +63,8 @@ bool OggEncoder::openDestination(const io::path_t& path)
     m_opusEncoder = ope_encoder_create_file(path.c_str(), comments, m_format.sampleRate,
                                             m_format.audioChannelsNumber, 0, &error);
 
-    if (error != OPE_OK && m_opusEncoder) {
-        ope_encoder_destroy(m_opusEncoder);
+    if (error != OPE_OK || !m_opusEncoder) {
+        closeDestination();
         return false;
     }
 
@@ -68,5 +75,8 @@ bool OggEncoder::openDestination(const io::path_t& path)
 
 void OggEncoder::closeDestination()
 {
-    ope_encoder_destroy(m_opusEncoder);
+    if (m_opusEncoder) {
+        ope_encoder_destroy(m_opusEncoder);
+        m_opusEncoder = nullptr;
+    }
 }
@@ -139,6 +139,28 @@ __finl float_x4 __vecc operator*(float_x4 a, float_x4 b)
 {
     return vmulq_f32(a.s, b.s);
 }
+
+/// loads 4 floats, the pointer doesn't need to be aligned
+__finl float_x4 __vecc load(const float* p)
+{
+    return vld1q_f32(p);
+}
+
+/// stores 4 floats, the pointer doesn't need to be aligned
+__finl void __vecc store(float* p, float_x4 a)
+{
+    vst1q_f32(p, a.s);
+}
+
+__finl float_x4 __vecc abs(float_x4 a)
+{
+    return vabsq_f32(a.s);
+}
+
+__finl float_x4 __vecc max(float_x4 a, float_x4 b)
+{
+    return vmaxq_f32(a.s, b.s);
+}
 } // namespace mu::audio::fx
 
 #endif // MU_AUDIO_SIMDTYPES_NEON_H
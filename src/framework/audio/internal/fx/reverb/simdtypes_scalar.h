@@ -83,6 +83,31 @@ __finl float_x4 __vecc operator*(float_x4 a, float_x4 b)
 {
     return { a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3] };
 }
+
+/// loads 4 floats, the pointer doesn't need to be aligned
+__finl float_x4 __vecc load(const float* p)
+{
+    return { p[0], p[1], p[2], p[3] };
+}
+
+/// stores 4 floats, the pointer doesn't need to be aligned
+__finl void __vecc store(float* p, float_x4 a)
+{
+    p[0] = a[0];
+    p[1] = a[1];
+    p[2] = a[2];
+    p[3] = a[3];
+}
+
+__finl float_x4 __vecc abs(float_x4 a)
+{
+    return { std::abs(a[0]), std::abs(a[1]), std::abs(a[2]), std::abs(a[3]) };
+}
+
+__finl float_x4 __vecc max(float_x4 a, float_x4 b)
+{
+    return { std::max(a[0], b[0]), std::max(a[1], b[1]), std::max(a[2], b[2]), std::max(a[3], b[3]) };
+}
 } // namespace mu::audio::fx
 
 #endif // MU_AUDIO_SIMDTYPES_SCALAR_H
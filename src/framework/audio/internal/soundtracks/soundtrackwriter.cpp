@@ -22,22 +22,32 @@
 
 #include "soundtrackwriter.h"
 
+#include <limits>
+#include <thread>
+
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
 #include "internal/encoders/flacencoder.h"
 #include "internal/encoders/wavencoder.h"
+#include "internal/dsp/simdkernels.h"
 
 #include "audioerrors.h"
 
+#include "concurrency/taskscheduler.h"
 #include "defer.h"
+#include "runtime.h"
 
 using namespace mu;
 using namespace mu::audio;
 using namespace mu::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE Offline, the sound track is rendered in chunks of several render steps,
+//! which are encoded on their own thread while the next ones are rendered
+static constexpr samples_t CHUNK_RENDER_STEPS = 64;
+static constexpr samples_t MIN_CHUNK_RENDER_STEPS = 8;
+static constexpr size_t CHUNKS_COUNT = 4;
+static constexpr size_t NO_CHUNK = std::numeric_limits<size_t>::max();
 
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
                                    IAudioSourcePtr source)
@@ -47,37 +57,96 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+    m_format = format;
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
+    m_chunkSamplesPerChannel = chunkSamplesPerChannel(1);
 
-    m_encoderPtr = createEncoder(format.type);
+    if (!addOutput(destination, format, {}, true)) {
+        return;
+    }
+
+    allocateChunks();
+}
 
-    if (!m_encoderPtr) {
+SoundTrackWriter::SoundTrackWriter(const SoundTrackStemList& stems, const SoundTrackFormat& format, const msecs_t totalDuration,
+                                   MixerPtr mixer)
+    : m_source(mixer), m_mixer(mixer)
+{
+    if (!m_mixer || stems.empty()) {
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_format = format;
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
+    m_chunkSamplesPerChannel = chunkSamplesPerChannel(stems.size());
+
+    for (const SoundTrackStem& stem : stems) {
+        if (!addOutput(stem.destination, format, stem.trackGains, stem.isMaster)) {
+            m_outputs.clear();
+            return;
+        }
+    }
+
+    m_mixBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+
+    allocateChunks();
+}
+
+samples_t SoundTrackWriter::chunkSamplesPerChannel(size_t outputsCount) const
+{
+    //! NOTE Shorter chunks for many stems, so the memory held by the chunks stays about the same
+    samples_t chunkRenderSteps = std::max(CHUNK_RENDER_STEPS / static_cast<samples_t>(outputsCount), MIN_CHUNK_RENDER_STEPS);
+    return chunkRenderSteps * config()->renderStep();
+}
+
+void SoundTrackWriter::allocateChunks()
+{
+    size_t chunkSize = m_chunkSamplesPerChannel * config()->audioChannelsCount();
+
+    m_chunks.resize(CHUNKS_COUNT);
+    for (Chunk& chunk : m_chunks) {
+        chunk.outputsData.resize(m_outputs.size());
+        for (std::vector<float>& data : chunk.outputsData) {
+            data.resize(chunkSize);
+        }
+    }
+}
+
+bool SoundTrackWriter::addOutput(const io::path_t& destination, const SoundTrackFormat& format,
+                                 const std::map<TrackId, gain_t>& trackGains, bool isMaster)
+{
+    Output output;
+    output.encoder = createEncoder(format.type);
+    output.trackGains = trackGains;
+    output.isMaster = isMaster;
+
+    if (!output.encoder) {
+        return false;
+    }
+
+    output.encoder->init(destination, format, m_totalSamplesPerChannel, m_chunkSamplesPerChannel);
+    m_outputs.push_back(std::move(output));
+
+    return true;
 }
 
 Ret SoundTrackWriter::write()
 {
     TRACEFUNC;
 
-    if (!m_source || !m_encoderPtr) {
+    if (!m_source || m_outputs.empty()) {
         return false;
     }
 
     AudioEngine::instance()->setMode(RenderMode::OfflineMode);
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
+    m_source->setSampleRate(m_format.sampleRate);
     m_source->setIsActive(true);
 
     DEFER {
-        m_encoderPtr->flush();
+        for (Output& output : m_outputs) {
+            output.encoder->flush();
+        }
 
         AudioEngine::instance()->setMode(RenderMode::IdleMode);
 
@@ -92,14 +161,10 @@ Ret SoundTrackWriter::write()
         return ret;
     }
 
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
-
-    if (m_isAborted) {
-        return make_ret(Ret::Code::Cancel);
-    }
-
-    if (bytes == 0) {
-        return make_ret(Err::ErrorEncode);
+    for (const Output& output : m_outputs) {
+        if (output.encodedTotal == 0) {
+            return make_ret(Err::ErrorEncode);
+        }
     }
 
     return make_ok();
@@ -133,42 +198,162 @@ Ret SoundTrackWriter::generateAudioData()
 {
     TRACEFUNC;
 
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return make_ret(Err::NoAudioToExport);
+    }
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    {
+        std::lock_guard lock(m_chunksMutex);
+        m_freeChunks = {};
+        m_renderedChunks = {};
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            m_freeChunks.push(i);
+        }
+    }
+
+    for (Output& output : m_outputs) {
+        output.encodedTotal = 0;
+    }
+
+    std::thread encoderThread(&SoundTrackWriter::encodeChunks, this);
 
     samples_t renderStep = config()->renderStep();
+    audioch_t audioChannelsCount = config()->audioChannelsCount();
+    samples_t renderedSamplesPerChannel = 0;
+
+    sendProgress(renderedSamplesPerChannel);
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), renderStep);
+    while (renderedSamplesPerChannel < m_totalSamplesPerChannel && !m_isAborted) {
+        size_t chunkIdx = takeChunk(m_freeChunks);
+        Chunk& chunk = m_chunks.at(chunkIdx);
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        samples_t chunkCapacity = chunk.outputsData.front().size() / audioChannelsCount;
+        chunk.samplesPerChannel = std::min(chunkCapacity, m_totalSamplesPerChannel - renderedSamplesPerChannel);
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        //! NOTE The source is always processed by render steps: the synthesizers handle the events
+        //! at the start of a block, larger blocks would shift them
+        for (samples_t offset = 0; offset < chunk.samplesPerChannel; offset += renderStep) {
+            if (m_mixer) {
+                m_source->process(m_mixBuffer.data(), renderStep);
+                mixStems(chunk, offset, renderStep);
+            } else {
+                m_source->process(chunk.outputsData.front().data() + offset * audioChannelsCount, renderStep);
+            }
+        }
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        renderedSamplesPerChannel += chunk.samplesPerChannel;
+        putChunk(m_renderedChunks, chunkIdx);
+
+        sendProgress(renderedSamplesPerChannel);
     }
 
+    putChunk(m_renderedChunks, NO_CHUNK);
+    encoderThread.join();
+
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return make_ret(Err::NoAudioToExport);
+    return make_ok();
+}
+
+void SoundTrackWriter::mixStems(Chunk& chunk, samples_t offset, samples_t samplesPerChannel)
+{
+    audioch_t audioChannelsCount = config()->audioChannelsCount();
+    size_t samplesNumber = samplesPerChannel * audioChannelsCount;
+
+    for (size_t outputIdx = 0; outputIdx < m_outputs.size(); ++outputIdx) {
+        float* stemBuffer = chunk.outputsData[outputIdx].data() + offset * audioChannelsCount;
+
+        if (m_outputs[outputIdx].isMaster) {
+            std::copy(m_mixBuffer.cbegin(), m_mixBuffer.cbegin() + samplesNumber, stemBuffer);
+            continue;
+        }
+
+        std::fill(stemBuffer, stemBuffer + samplesNumber, 0.f);
+
+        for (const auto& pair : m_outputs[outputIdx].trackGains) {
+            if (const float* trackOutput = m_mixer->trackOutput(pair.first)) {
+                dsp::mixAddScaled(stemBuffer, trackOutput, pair.second, samplesNumber);
+            }
+        }
     }
+}
 
-    return make_ok();
+void SoundTrackWriter::encodeChunks()
+{
+    runtime::setThreadName("audio_encoder");
+
+    //! NOTE Each encoder gets the chunks in order, but the stems are encoded in parallel
+    std::unique_ptr<TaskScheduler> scheduler;
+    if (m_outputs.size() > 1) {
+        scheduler = std::make_unique<TaskScheduler>();
+    }
+
+    std::vector<std::future<void> > encoded;
+
+    while (true) {
+        size_t chunkIdx = takeChunk(m_renderedChunks);
+        if (chunkIdx == NO_CHUNK) {
+            break;
+        }
+
+        const Chunk& chunk = m_chunks.at(chunkIdx);
+
+        if (!m_isAborted) {
+            if (scheduler) {
+                for (size_t outputIdx = 0; outputIdx < m_outputs.size(); ++outputIdx) {
+                    encoded.push_back(scheduler->submit([this, &chunk, outputIdx]() {
+                        encodeChunk(chunk, outputIdx);
+                    }));
+                }
+
+                for (std::future<void>& future : encoded) {
+                    future.get();
+                }
+
+                encoded.clear();
+            } else {
+                encodeChunk(chunk, 0);
+            }
+        }
+
+        putChunk(m_freeChunks, chunkIdx);
+    }
+}
+
+void SoundTrackWriter::encodeChunk(const Chunk& chunk, size_t outputIdx)
+{
+    Output& output = m_outputs.at(outputIdx);
+    output.encodedTotal += output.encoder->encode(chunk.samplesPerChannel, chunk.outputsData.at(outputIdx).data());
+}
+
+size_t SoundTrackWriter::takeChunk(std::queue<size_t>& queue)
+{
+    std::unique_lock lock(m_chunksMutex);
+    m_chunksChanged.wait(lock, [&queue]() {
+        return !queue.empty();
+    });
+
+    size_t chunkIdx = queue.front();
+    queue.pop();
+
+    return chunkIdx;
+}
+
+void SoundTrackWriter::putChunk(std::queue<size_t>& queue, size_t chunkIdx)
+{
+    {
+        std::lock_guard lock(m_chunksMutex);
+        queue.push(chunkIdx);
+    }
+
+    m_chunksChanged.notify_all();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::sendProgress(samples_t renderedSamplesPerChannel)
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    int64_t current = renderedSamplesPerChannel * 100 / m_totalSamplesPerChannel;
+    m_progress.progressChanged.send(current, 100, "");
 }
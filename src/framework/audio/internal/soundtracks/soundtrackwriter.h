@@ -25,6 +25,10 @@
 
 #include <vector>
 #include <cstdio>
+#include <map>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
 
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
@@ -33,6 +37,7 @@
 #include "audiotypes.h"
 #include "iaudiosource.h"
 #include "internal/encoders/abstractaudioencoder.h"
+#include "internal/worker/mixer.h"
 
 namespace mu::audio::soundtrack {
 class SoundTrackWriter : public async::Asyncable
@@ -41,23 +46,59 @@ class SoundTrackWriter : public async::Asyncable
 public:
     SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source);
 
+    //! NOTE Each stem is mixed from the outputs of its tracks, the master stem is the master output
+    SoundTrackWriter(const SoundTrackStemList& stems, const SoundTrackFormat& format, const msecs_t totalDuration, MixerPtr mixer);
+
     Ret write();
     void abort();
 
     framework::Progress progress();
 
 private:
+    struct Output {
+        encode::AbstractAudioEncoderPtr encoder;
+        std::map<TrackId, gain_t> trackGains;
+        bool isMaster = false;
+        size_t encodedTotal = 0;
+    };
+
+    struct Chunk {
+        std::vector<std::vector<float> > outputsData;
+        samples_t samplesPerChannel = 0;
+    };
+
+    samples_t chunkSamplesPerChannel(size_t outputsCount) const;
+    void allocateChunks();
+    bool addOutput(const io::path_t& destination, const SoundTrackFormat& format, const std::map<TrackId, gain_t>& trackGains,
+                   bool isMaster);
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
     Ret generateAudioData();
+    void mixStems(Chunk& chunk, samples_t offset, samples_t samplesPerChannel);
+    void encodeChunks();
+    void encodeChunk(const Chunk& chunk, size_t outputIdx);
+
+    size_t takeChunk(std::queue<size_t>& queue);
+    void putChunk(std::queue<size_t>& queue, size_t chunkIdx);
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    void sendProgress(samples_t renderedSamplesPerChannel);
 
     IAudioSourcePtr m_source = nullptr;
+    MixerPtr m_mixer = nullptr;
+    SoundTrackFormat m_format;
+    samples_t m_totalSamplesPerChannel = 0;
+    samples_t m_chunkSamplesPerChannel = 0;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::vector<Output> m_outputs;
+    std::vector<float> m_mixBuffer;
 
-    encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    //! NOTE The rendered chunks go to the encoder thread and come back empty,
+    //! so the renderer waits when the encoder is behind
+    std::vector<Chunk> m_chunks;
+    std::queue<size_t> m_freeChunks;
+    std::queue<size_t> m_renderedChunks;
+    std::mutex m_chunksMutex;
+    std::condition_variable m_chunksChanged;
 
     framework::Progress m_progress;
     std::atomic<bool> m_isAborted = false;
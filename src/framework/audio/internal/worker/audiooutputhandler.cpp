@@ -184,7 +184,19 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
-    return Promise<bool>([this, sequenceId, destination, format](auto resolve, auto reject) {
+    return doSaveSoundTrack(sequenceId, destination, SoundTrackStemList(), format);
+}
+
+Promise<bool> AudioOutputHandler::saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackStemList& stems,
+                                                      const SoundTrackFormat& format)
+{
+    return doSaveSoundTrack(sequenceId, io::path_t(), stems, format);
+}
+
+Promise<bool> AudioOutputHandler::doSaveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                   const SoundTrackStemList& stems, const SoundTrackFormat& format)
+{
+    return Promise<bool>([this, sequenceId, destination, stems, format](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
@@ -201,7 +213,9 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
 
-        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(destination, format, totalDuration, mixer());
+        SoundTrackWriterPtr writer = stems.empty()
+                                     ? std::make_shared<SoundTrackWriter>(destination, format, totalDuration, mixer())
+                                     : std::make_shared<SoundTrackWriter>(stems, format, totalDuration, mixer());
         m_saveSoundTracksWritersMap[sequenceId] = writer;
 
         framework::Progress progress = saveSoundTrackProgress(sequenceId);
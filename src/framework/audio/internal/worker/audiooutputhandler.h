@@ -61,6 +61,8 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackStemList& stems,
+                                             const SoundTrackFormat& format) override;
     void abortSavingAllSoundTracks() override;
 
     framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
@@ -73,6 +75,9 @@ private:
     void ensureSeqSubscriptions(const ITrackSequencePtr s) const;
     void ensureMixerSubscriptions() const;
 
+    async::Promise<bool> doSaveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                          const SoundTrackStemList& stems, const SoundTrackFormat& format);
+
     IGetTrackSequence* m_getSequence = nullptr;
 
     mutable async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
@@ -25,12 +25,12 @@
 #include "log.h"
 
 #include <limits>
-
-#include "concurrency/taskscheduler.h"
+#include <memory>
 
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/simdkernels.h"
 #include "audioerrors.h"
 
 using namespace mu;
@@ -39,11 +39,15 @@ using namespace mu::async;
 
 static constexpr size_t DEFAULT_AUX_BUFFER_SIZE = 1024;
 
+static constexpr size_t TRACK_BUFFER_ALIGNMENT = 64; // bytes
+static constexpr size_t TRACK_BUFFER_ALIGNMENT_SAMPLES = TRACK_BUFFER_ALIGNMENT / sizeof(float);
+
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     m_minTrackCountForMultithreading = configuration()->minTrackCountForMultithreading();
+    m_maxSamplesPerChannel = configuration()->renderStep();
 }
 
 Mixer::~Mixer()
@@ -70,6 +74,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     }
 
     m_trackChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    updateTrackBuffers();
 
     result.val = m_trackChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -85,7 +90,7 @@ RetVal<MixerChannelPtr> Mixer::addAuxChannel(const TrackId trackId)
 
     AuxChannelInfo aux;
     aux.channel = channel;
-    aux.buffer = std::vector<float>(DEFAULT_AUX_BUFFER_SIZE, 0.f);
+    aux.buffer = std::vector<float>(std::max(DEFAULT_AUX_BUFFER_SIZE, maxBufferSize()), 0.f);
 
     m_auxChannelInfoList.emplace_back(std::move(aux));
 
@@ -104,6 +109,7 @@ Ret Mixer::removeChannel(const TrackId trackId)
 
     if (search != m_trackChannels.end() && search->second) {
         m_trackChannels.erase(trackId);
+        updateTrackBuffers();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -119,6 +125,14 @@ void Mixer::setAudioChannelsCount(const audioch_t count)
     ONLY_AUDIO_WORKER_THREAD;
 
     m_audioChannelsCount = count;
+
+    allocateTrackBuffers(maxBufferSize());
+
+    for (AuxChannelInfo& aux : m_auxChannelInfoList) {
+        if (aux.buffer.size() < maxBufferSize()) {
+            aux.buffer.resize(maxBufferSize());
+        }
+    }
 }
 
 void Mixer::setSampleRate(unsigned int sampleRate)
@@ -152,27 +166,29 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     size_t outBufferSize = samplesPerChannel * m_audioChannelsCount;
     std::fill(outBuffer, outBuffer + outBufferSize, 0.f);
 
-    if (m_writeCacheBuff.size() != outBufferSize) {
-        m_writeCacheBuff.resize(outBufferSize, 0.f);
-    }
-
     if (m_isIdle && m_tracksToProcessWhenIdle.empty() && m_isSilence) {
         notifyNoAudioSignal();
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    //! NOTE The buffers are allocated for the render step when the tracks or the channels count change
+    IF_ASSERT_FAILED(outBufferSize <= m_trackBufferStride) {
+        allocateTrackBuffers(outBufferSize);
+    }
+
+    processTrackChannels(outBufferSize, samplesPerChannel);
 
     prepareAuxBuffers(outBufferSize);
 
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& pair : tracksData) {
-        const std::vector<float>& trackBuffer = pair.second;
+    for (const TrackBuffer& track : m_trackBuffers) {
+        if (!track.isActive) {
+            continue;
+        }
 
         bool outBufferIsSilent = false;
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel, outBufferIsSilent);
+        mixOutputFromChannel(outBuffer, track.buffer, samplesPerChannel, outBufferIsSilent);
         masterChannelSampleCount = std::max(samplesPerChannel, masterChannelSampleCount);
 
         if (!outBufferIsSilent) {
@@ -181,8 +197,8 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
             continue;
         }
 
-        const AuxSendsParams& auxSends = m_trackChannels.at(pair.first)->outputParams().auxSends;
-        writeTrackToAuxBuffers(trackBuffer.data(), auxSends, samplesPerChannel);
+        const AuxSendsParams& auxSends = track.channel->outputParams().auxSends;
+        writeTrackToAuxBuffers(track.buffer, auxSends, samplesPerChannel);
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0 || m_isSilence) {
@@ -202,49 +218,80 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::updateTrackBuffers()
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
+    m_trackBuffers.clear();
+    m_trackBuffers.reserve(m_trackChannels.size());
+
+    for (const auto& pair : m_trackChannels) {
+        TrackBuffer track;
+        track.trackId = pair.first;
+        track.channel = pair.second.get();
+        m_trackBuffers.push_back(track);
+    }
 
-        buffer = silent_buffer;
+    allocateTrackBuffers(maxBufferSize());
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
-        }
+    if (!m_threadPool && m_trackChannels.size() >= m_minTrackCountForMultithreading) {
+        //! NOTE The worker thread processes tracks too
+        size_t threadsCount = std::max(std::thread::hardware_concurrency() / 2, 2u) - 1;
+        m_threadPool = std::make_unique<MixerThreadPool>(threadsCount);
+    }
+}
 
-        return buffer;
-    };
+size_t Mixer::maxBufferSize() const
+{
+    return m_maxSamplesPerChannel * m_audioChannelsCount;
+}
 
-    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+void Mixer::allocateTrackBuffers(size_t bufferSize)
+{
+    m_trackBufferStride = (bufferSize + TRACK_BUFFER_ALIGNMENT_SAMPLES - 1) / TRACK_BUFFER_ALIGNMENT_SAMPLES * TRACK_BUFFER_ALIGNMENT_SAMPLES;
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
+    size_t alignedSize = m_trackBufferStride * m_trackBuffers.size();
+    m_trackBuffersData.assign(alignedSize + TRACK_BUFFER_ALIGNMENT_SAMPLES, 0.f);
 
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !mu::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    void* data = m_trackBuffersData.data();
+    size_t space = m_trackBuffersData.size() * sizeof(float);
+    float* alignedData = static_cast<float*>(std::align(TRACK_BUFFER_ALIGNMENT, alignedSize * sizeof(float), data, space));
 
-            std::future<std::vector<float> > future = TaskScheduler::instance()->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
-        }
+    for (size_t i = 0; i < m_trackBuffers.size(); ++i) {
+        m_trackBuffers[i].buffer = alignedData + i * m_trackBufferStride;
+    }
+}
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
-        }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !mu::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel)
+{
+    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    for (TrackBuffer& track : m_trackBuffers) {
+        track.isActive = !filterTracks || mu::contains(m_tracksToProcessWhenIdle, track.trackId);
+    }
+
+    m_processBufferSize = outBufferSize;
+    m_processSamplesPerChannel = static_cast<samples_t>(samplesPerChannel);
+
+    if (m_threadPool && useMultithreading()) {
+        m_threadPool->run(&Mixer::processTrackChannel, this, m_trackBuffers.size());
+    } else {
+        for (size_t i = 0; i < m_trackBuffers.size(); ++i) {
+            processTrackChannel(this, i);
         }
     }
 }
 
+void Mixer::processTrackChannel(void* mixer, size_t trackIdx)
+{
+    Mixer* self = static_cast<Mixer*>(mixer);
+    TrackBuffer& track = self->m_trackBuffers[trackIdx];
+    if (!track.isActive) {
+        return;
+    }
+
+    std::fill(track.buffer, track.buffer + self->m_processBufferSize, 0.f);
+    track.channel->process(track.buffer, self->m_processSamplesPerChannel);
+}
+
 bool Mixer::useMultithreading() const
 {
     if (m_trackChannels.size() < m_minTrackCountForMultithreading) {
@@ -374,6 +421,19 @@ void Mixer::setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds)
     m_tracksToProcessWhenIdle = std::move(trackIds);
 }
 
+const float* Mixer::trackOutput(const TrackId trackId) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (const TrackBuffer& track : m_trackBuffers) {
+        if (track.trackId == trackId) {
+            return track.isActive ? track.buffer : nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
 void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, bool& outBufferIsSilent)
 {
     IF_ASSERT_FAILED(outBuffer && inBuffer) {
@@ -386,18 +446,11 @@ void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsign
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * m_audioChannelsCount + audioChNum;
-            float sample = inBuffer[idx];
-
-            outBuffer[idx] += sample;
-
-            if (outBufferIsSilent && !RealIsNull(sample)) {
-                outBufferIsSilent = false;
-            }
-        }
-    }
+    //! NOTE Silent if every sample of the track is null, as with the per-sample check before.
+    //! When every track is silent and so was the last output, process() skips the aux channels
+    //! and the master fx (see Audio_MixerTest.SilentTracks)
+    float peak = dsp::mixAdd(outBuffer, inBuffer, samplesCount * m_audioChannelsCount);
+    outBufferIsSilent = RealIsNull(peak);
 }
 
 void Mixer::prepareAuxBuffers(size_t outBufferSize)
@@ -409,7 +462,7 @@ void Mixer::prepareAuxBuffers(size_t outBufferSize)
             continue;
         }
 
-        if (aux.buffer.size() < outBufferSize) {
+        IF_ASSERT_FAILED(aux.buffer.size() >= outBufferSize) {
             aux.buffer.resize(outBufferSize);
         }
 
@@ -434,16 +487,7 @@ void Mixer::writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParam
             continue;
         }
 
-        float* auxBuffer = aux.buffer.data();
-        float signalAmount = auxSend.signalAmount;
-
-        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-            for (samples_t s = 0; s < samplesPerChannel; ++s) {
-                int idx = s * m_audioChannelsCount + audioChNum;
-
-                auxBuffer[idx] += trackBuffer[idx] * signalAmount;
-            }
-        }
+        dsp::mixAddScaled(aux.buffer.data(), trackBuffer, auxSend.signalAmount, samplesPerChannel * m_audioChannelsCount);
 
         aux.receivedAudioSignal = true;
     }
@@ -470,33 +514,26 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
         return;
     }
 
-    m_isSilence = true;
-
-    float totalSquaredSum = 0.f;
     float volume = dsp::linearFromDecibels(m_masterParams.volume);
 
-    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
-
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * m_audioChannelsCount + audioChNum;
+    gain_t gains[dsp::MAX_AUDIO_CHANNELS_COUNT];
+    float squaredSums[dsp::MAX_AUDIO_CHANNELS_COUNT];
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        gains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
+        squaredSums[audioChNum] = 0.f;
+    }
 
-            if (m_isSilence && !RealIsNull(resultSample)) {
-                m_isSilence = false;
-            }
+    float peak = dsp::applyChannelGains(buffer, m_audioChannelsCount, samplesPerChannel, gains, squaredSums);
+    m_isSilence = RealIsNull(peak);
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    float totalSquaredSum = 0.f;
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        float rms = dsp::samplesRootMeanSquare(squaredSums[audioChNum], samplesPerChannel);
         notifyAboutAudioSignalChanges(audioChNum, rms);
+
+        totalSquaredSum += squaredSums[audioChNum];
     }
 
     if (!m_limiter->isActive()) {
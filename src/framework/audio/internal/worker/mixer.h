@@ -31,6 +31,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "mixerthreadpool.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iaudioconfiguration.h"
@@ -66,6 +67,10 @@ public:
     void setIsIdle(bool idle);
     void setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds);
 
+    //! NOTE The output of the track channel in the last process() call,
+    //! nullptr if the track wasn't processed
+    const float* trackOutput(const TrackId trackId) const;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -73,9 +78,20 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    struct TrackBuffer {
+        TrackId trackId = -1;
+        MixerChannel* channel = nullptr;
+        float* buffer = nullptr;
+        bool isActive = false;
+    };
+
+    void updateTrackBuffers();
+    size_t maxBufferSize() const;
+    void allocateTrackBuffers(size_t bufferSize);
+
+    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel);
+    static void processTrackChannel(void* mixer, size_t trackIdx);
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, bool& outBufferIsSilent);
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
@@ -88,8 +104,17 @@ private:
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
     size_t m_minTrackCountForMultithreading = 0;
+    std::unique_ptr<MixerThreadPool> m_threadPool;
+
+    //! NOTE One buffer per track in m_trackBuffersData, allocated for the render step
+    //! when the tracks or the channels count change, never while the tracks are processed
+    std::vector<TrackBuffer> m_trackBuffers;
+    std::vector<float> m_trackBuffersData;
+    size_t m_trackBufferStride = 0;
+    samples_t m_maxSamplesPerChannel = 0;
 
-    std::vector<float> m_writeCacheBuff;
+    size_t m_processBufferSize = 0;
+    samples_t m_processSamplesPerChannel = 0;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
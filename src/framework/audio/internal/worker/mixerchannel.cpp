@@ -26,6 +26,7 @@
 #include "log.h"
 
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/simdkernels.h"
 #include "internal/audiosanitizer.h"
 
 using namespace mu;
@@ -198,29 +199,26 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 
 void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
 {
-    unsigned int channelsCount = audioChannelsCount();
+    audioch_t channelsCount = static_cast<audioch_t>(audioChannelsCount());
     float volume = dsp::linearFromDecibels(m_params.volume);
-    float totalSquaredSum = 0.f;
-
-    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
 
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+    gain_t gains[dsp::MAX_AUDIO_CHANNELS_COUNT];
+    float squaredSums[dsp::MAX_AUDIO_CHANNELS_COUNT];
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * channelsCount + audioChNum;
-
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        gains[audioChNum] = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+        squaredSums[audioChNum] = 0.f;
+    }
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
-        }
+    dsp::applyChannelGains(buffer, channelsCount, samplesCount, gains, squaredSums);
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
+    float totalSquaredSum = 0.f;
 
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        float rms = dsp::samplesRootMeanSquare(squaredSums[audioChNum], samplesCount);
         notifyAboutAudioSignalChanges(audioChNum, rms);
+
+        totalSquaredSum += squaredSums[audioChNum];
     }
 
     if (!m_compressor->isActive()) {
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mixerthreadpool.h"
+
+#include <chrono>
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+static constexpr int SPIN_COUNT_BEFORE_WAIT = 256;
+static constexpr std::chrono::milliseconds MAX_WAIT_TIME(10);
+
+MixerThreadPool::MixerThreadPool(size_t threadsCount)
+{
+    m_threads.reserve(threadsCount);
+    for (size_t i = 0; i < threadsCount; ++i) {
+        m_threads.emplace_back(&MixerThreadPool::th_workerLoop, this);
+    }
+}
+
+MixerThreadPool::~MixerThreadPool()
+{
+    m_isActive = false;
+    m_wakeCv.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t MixerThreadPool::threadsCount() const
+{
+    return m_threads.size();
+}
+
+void MixerThreadPool::run(Task task, void* context, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t generation = generationOf(m_state.load(std::memory_order_relaxed)) + 1;
+
+    m_task.store(task, std::memory_order_relaxed);
+    m_context.store(context, std::memory_order_relaxed);
+    m_doneCount.store(0, std::memory_order_relaxed);
+    m_state.store((static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(count), std::memory_order_release);
+
+    //! NOTE Doesn't lock, a thread that misses the notification just leaves the tasks of this run to the others
+    m_wakeCv.notify_all();
+
+    processTasks(generation);
+
+    int spinCount = 0;
+    while (m_doneCount.load(std::memory_order_acquire) < count) {
+        if (++spinCount > SPIN_COUNT_BEFORE_WAIT) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void MixerThreadPool::processTasks(uint32_t generation)
+{
+    Task task = m_task.load(std::memory_order_relaxed);
+    void* context = m_context.load(std::memory_order_relaxed);
+
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    while (generationOf(state) == generation && remainingOf(state) > 0) {
+        if (!m_state.compare_exchange_weak(state, state - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            continue;
+        }
+
+        task(context, remainingOf(state) - 1);
+        m_doneCount.fetch_add(1, std::memory_order_release);
+
+        state = m_state.load(std::memory_order_acquire);
+    }
+}
+
+void MixerThreadPool::th_workerLoop()
+{
+    AudioSanitizer::setupWorkerPoolThread();
+
+    uint32_t lastGeneration = generationOf(m_state.load(std::memory_order_acquire));
+    int spinCount = 0;
+
+    while (m_isActive) {
+        uint32_t generation = generationOf(m_state.load(std::memory_order_acquire));
+        if (generation != lastGeneration) {
+            lastGeneration = generation;
+            spinCount = 0;
+            processTasks(generation);
+            continue;
+        }
+
+        if (++spinCount < SPIN_COUNT_BEFORE_WAIT) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCv.wait_for(lock, MAX_WAIT_TIME, [this, lastGeneration]() {
+            return !m_isActive || generationOf(m_state.load(std::memory_order_acquire)) != lastGeneration;
+        });
+    }
+}
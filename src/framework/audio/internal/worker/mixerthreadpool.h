@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_MIXERTHREADPOOL_H
+#define MU_AUDIO_MIXERTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE Fixed set of threads that process the tasks of one run at a time, for the audio thread:
+//! running the tasks allocates nothing, takes no lock and the calling thread processes tasks too,
+//! so a run completes even if none of the pool threads wakes up in time
+class MixerThreadPool
+{
+public:
+    using Task = void (*)(void* context, size_t idx);
+
+    explicit MixerThreadPool(size_t threadsCount);
+    ~MixerThreadPool();
+
+    size_t threadsCount() const;
+
+    //! NOTE Calls task(context, idx) for each idx in [0, count) and returns when all calls are done
+    void run(Task task, void* context, size_t count);
+
+private:
+    void th_workerLoop();
+    void processTasks(uint32_t generation);
+
+    static uint32_t generationOf(uint64_t state) { return static_cast<uint32_t>(state >> 32); }
+    static uint32_t remainingOf(uint64_t state) { return static_cast<uint32_t>(state); }
+
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_isActive = true;
+
+    //! NOTE Generation of the run in the high half, count of tasks not taken yet in the low half.
+    //! A task is only taken by a CAS that also checks the generation, so a thread that comes late
+    //! can't take a task of the next run, and the task and context it read can't be of the next run
+    std::atomic<uint64_t> m_state = 0;
+    std::atomic<Task> m_task = nullptr;
+    std::atomic<void*> m_context = nullptr;
+    std::atomic<uint32_t> m_doneCount = 0;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+};
+}
+
+#endif // MU_AUDIO_MIXERTHREADPOOL_H
@@ -0,0 +1,252 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "audio/internal/encoders/mp3encoder.h"
+#include "audio/internal/encoders/oggencoder.h"
+#include "audio/internal/encoders/flacencoder.h"
+#include "audio/internal/encoders/wavencoder.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+namespace mu::audio {
+static constexpr sample_rate_t SAMPLE_RATE = 48000;
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr samples_t BLOCK_SAMPLES_PER_CHANNEL = 4096;
+static constexpr float TWO_PI = 6.28318530718f;
+
+//! NOTE Several full blocks and a shorter last one, as the sound track writer gives them
+static const std::vector<samples_t> BLOCKS { BLOCK_SAMPLES_PER_CHANNEL, BLOCK_SAMPLES_PER_CHANNEL, BLOCK_SAMPLES_PER_CHANNEL, 1000 };
+
+class Audio_AudioEncodersTest : public ::testing::Test
+{
+protected:
+    static std::vector<float> makeBlock(samples_t samplesPerChannel, samples_t offset)
+    {
+        std::vector<float> block(samplesPerChannel * AUDIO_CHANNELS_COUNT);
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            float sample = 0.5f * std::sin(TWO_PI * 440.f * (offset + s) / SAMPLE_RATE);
+            for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+                block[s * AUDIO_CHANNELS_COUNT + ch] = ch == 0 ? sample : -sample;
+            }
+        }
+
+        return block;
+    }
+
+    static samples_t totalSamplesPerChannel()
+    {
+        samples_t total = 0;
+        for (samples_t samplesPerChannel : BLOCKS) {
+            total += samplesPerChannel;
+        }
+
+        return total;
+    }
+
+    //! NOTE Encodes the blocks one by one, returns what encode() returned for each
+    static std::vector<size_t> encodeBlocks(AbstractAudioEncoder& encoder, std::vector<float>* input = nullptr)
+    {
+        std::vector<size_t> results;
+        samples_t offset = 0;
+
+        for (samples_t samplesPerChannel : BLOCKS) {
+            std::vector<float> block = makeBlock(samplesPerChannel, offset);
+            results.push_back(encoder.encode(samplesPerChannel, block.data()));
+            offset += samplesPerChannel;
+
+            if (input) {
+                input->insert(input->end(), block.cbegin(), block.cend());
+            }
+        }
+
+        return results;
+    }
+
+    static SoundTrackFormat format(SoundTrackType type)
+    {
+        return { type, SAMPLE_RATE, AUDIO_CHANNELS_COUNT, 128 };
+    }
+
+    QByteArray readFile(const QString& fileName) const
+    {
+        QFile file(m_dir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QByteArray();
+        }
+
+        return file.readAll();
+    }
+
+    template<typename T>
+    static T readTag(const QByteArray& data, int pos)
+    {
+        T value = 0;
+        std::memcpy(&value, data.constData() + pos, sizeof(T)); // little endian
+        return value;
+    }
+
+    QTemporaryDir m_dir;
+};
+}
+
+TEST_F(Audio_AudioEncodersTest, Wav)
+{
+    // [GIVEN] A WAV encoder
+    io::path_t path = m_dir.filePath("test.wav");
+    std::vector<float> input;
+
+    {
+        WavEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format(SoundTrackType::WAV), totalSamplesPerChannel(), BLOCK_SAMPLES_PER_CHANNEL));
+
+        // [WHEN] The blocks are encoded
+        std::vector<size_t> results = encodeBlocks(encoder, &input);
+
+        // [THEN] All the samples of each block are written
+        for (size_t i = 0; i < BLOCKS.size(); ++i) {
+            EXPECT_EQ(results.at(i), BLOCKS.at(i) * AUDIO_CHANNELS_COUNT);
+        }
+
+        encoder.flush();
+    }
+
+    // [THEN] The header written again by flush() has the sizes of all the blocks
+    static constexpr int HEADER_SIZE = 46;
+    const int dataSize = static_cast<int>(input.size() * sizeof(float));
+
+    QByteArray data = readFile("test.wav");
+    ASSERT_EQ(data.size(), HEADER_SIZE + dataSize);
+
+    EXPECT_EQ(data.left(4), QByteArray("RIFF"));
+    EXPECT_EQ(readTag<uint32_t>(data, 4), static_cast<uint32_t>(data.size() - 8));
+    EXPECT_EQ(data.mid(8, 4), QByteArray("WAVE"));
+    EXPECT_EQ(data.mid(HEADER_SIZE - 8, 4), QByteArray("data"));
+    EXPECT_EQ(readTag<uint32_t>(data, HEADER_SIZE - 4), static_cast<uint32_t>(dataSize));
+
+    // [THEN] The samples are the ones of the blocks, in order
+    EXPECT_EQ(std::memcmp(data.constData() + HEADER_SIZE, input.data(), dataSize), 0);
+}
+
+TEST_F(Audio_AudioEncodersTest, Mp3)
+{
+    // [GIVEN] An MP3 encoder, with the output buffer sized for one block
+    io::path_t path = m_dir.filePath("test.mp3");
+    size_t writtenBytes = 0;
+
+    {
+        Mp3Encoder encoder;
+        ASSERT_TRUE(encoder.init(path, format(SoundTrackType::MP3), totalSamplesPerChannel(), BLOCK_SAMPLES_PER_CHANNEL));
+
+        // [WHEN] The blocks are encoded
+        for (size_t result : encodeBlocks(encoder)) {
+            writtenBytes += result;
+        }
+
+        // [THEN] Each block fits into the buffer, so something is encoded
+        EXPECT_GT(writtenBytes, 0u);
+
+        // [WHEN] The encoder is flushed
+        size_t flushedBytes = encoder.flush();
+
+        // [THEN] The last frames are written
+        EXPECT_GT(flushedBytes, 0u);
+        writtenBytes += flushedBytes;
+    }
+
+    // [THEN] The file has all that was written, and starts with a tag or a frame
+    QByteArray data = readFile("test.mp3");
+    ASSERT_EQ(static_cast<size_t>(data.size()), writtenBytes);
+
+    bool isFrameSync = static_cast<unsigned char>(data.at(0)) == 0xFF && (static_cast<unsigned char>(data.at(1)) & 0xE0) == 0xE0;
+    EXPECT_TRUE(isFrameSync || data.startsWith("ID3"));
+}
+
+TEST_F(Audio_AudioEncodersTest, OggDrain)
+{
+    // [GIVEN] An Ogg encoder
+    io::path_t path = m_dir.filePath("test.ogg");
+
+    {
+        OggEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format(SoundTrackType::OGG), totalSamplesPerChannel(), BLOCK_SAMPLES_PER_CHANNEL));
+
+        // [WHEN] The blocks are encoded
+        std::vector<size_t> results = encodeBlocks(encoder);
+
+        // [THEN] Each block is taken completely
+        for (size_t i = 0; i < BLOCKS.size(); ++i) {
+            EXPECT_EQ(results.at(i), BLOCKS.at(i));
+        }
+
+        // [WHEN] The encoder is drained
+        encoder.flush();
+    }
+
+    // [THEN] The stream is complete: the last page has the end of stream flag
+    QByteArray data = readFile("test.ogg");
+    ASSERT_TRUE(data.startsWith("OggS"));
+    EXPECT_TRUE(data.contains("OpusHead"));
+
+    int lastPage = data.lastIndexOf("OggS");
+    ASSERT_GE(lastPage, 0);
+    ASSERT_GT(data.size(), lastPage + 5);
+
+    static constexpr unsigned char END_OF_STREAM = 0x04;
+    EXPECT_TRUE(static_cast<unsigned char>(data.at(lastPage + 5)) & END_OF_STREAM);
+}
+
+TEST_F(Audio_AudioEncodersTest, Flac)
+{
+    // [GIVEN] A FLAC encoder
+    io::path_t path = m_dir.filePath("test.flac");
+
+    {
+        FlacEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format(SoundTrackType::FLAC), totalSamplesPerChannel(), BLOCK_SAMPLES_PER_CHANNEL));
+
+        // [WHEN] The blocks are encoded
+        std::vector<size_t> results = encodeBlocks(encoder);
+
+        // [THEN] All the samples of each block are taken
+        for (size_t i = 0; i < BLOCKS.size(); ++i) {
+            EXPECT_EQ(results.at(i), BLOCKS.at(i) * AUDIO_CHANNELS_COUNT);
+        }
+
+        encoder.flush();
+    }
+
+    // [THEN] The file is a FLAC stream
+    QByteArray data = readFile("test.flac");
+    EXPECT_TRUE(data.startsWith("fLaC"));
+}
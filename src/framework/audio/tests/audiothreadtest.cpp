@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "audio/internal/audiothread.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+using namespace std::chrono_literals;
+
+namespace mu::audio {
+//! NOTE Long enough for the loop body to run only on the wake ups
+static constexpr std::chrono::microseconds LONG_INTERVAL = 10s;
+
+class Audio_AudioThreadTest : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        m_thread.stop();
+    }
+
+    bool waitForRuns(int count, std::chrono::milliseconds timeout = 2s) const
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (m_runsCount.load() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    AudioThread m_thread;
+    std::atomic<int> m_runsCount = 0;
+};
+}
+
+TEST_F(Audio_AudioThreadTest, WakeUp_RunsTheLoopBody)
+{
+    // [GIVEN] The thread with an interval longer than the test
+    m_thread.setInterval(LONG_INTERVAL);
+    m_thread.run(nullptr, [this]() { ++m_runsCount; });
+
+    // [GIVEN] The first run is done
+    ASSERT_TRUE(waitForRuns(1));
+
+    // [WHEN] The thread is woken up
+    m_thread.wakeUp();
+
+    // [THEN] The loop body runs again without waiting for the interval
+    EXPECT_TRUE(waitForRuns(2));
+}
+
+TEST_F(Audio_AudioThreadTest, WakeUp_PendingRequestsAreMerged)
+{
+    // [GIVEN] The thread, which loop body blocks on the second run
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    m_thread.setInterval(LONG_INTERVAL);
+    m_thread.run(nullptr, [this, released]() {
+        if (++m_runsCount == 2) {
+            released.wait();
+        }
+    });
+
+    ASSERT_TRUE(waitForRuns(1));
+
+    m_thread.wakeUp();
+    ASSERT_TRUE(waitForRuns(2));
+
+    // [WHEN] The thread is woken up many times while the loop body runs
+    for (int i = 0; i < 100; ++i) {
+        m_thread.wakeUp();
+    }
+
+    release.set_value();
+
+    // [THEN] The requests made while the body runs are served right after it, once
+    EXPECT_TRUE(waitForRuns(3));
+
+    // [THEN] Nothing is left pending: the next run is the one of a new request
+    m_thread.wakeUp();
+    ASSERT_TRUE(waitForRuns(4));
+    EXPECT_EQ(m_runsCount.load(), 4);
+}
+
+TEST_F(Audio_AudioThreadTest, Metrics)
+{
+    // [GIVEN] The thread with a short metrics period
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    m_thread.setInterval(LONG_INTERVAL);
+    m_thread.setMetricsPeriod(100ms);
+    m_thread.run(nullptr, [this, released]() {
+        if (++m_runsCount == 2) {
+            released.wait();
+        }
+    });
+
+    ASSERT_TRUE(waitForRuns(1));
+
+    // [WHEN] A request is served while the test holds the loop body
+    auto beforeRequest = std::chrono::steady_clock::now();
+    m_thread.wakeUp();
+    auto afterRequest = std::chrono::steady_clock::now();
+
+    ASSERT_TRUE(waitForRuns(2));
+    std::this_thread::sleep_for(5ms);
+    auto beforeRelease = std::chrono::steady_clock::now();
+    release.set_value();
+
+    // [WHEN] The thread is woken up until the end of the period
+    //! NOTE One run per wake up, so the first published metrics are read before the next ones
+    AudioThread::Metrics metrics;
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while ((metrics = m_thread.metrics()).wakeUpsPerSecond == 0.0 && std::chrono::steady_clock::now() < deadline) {
+        m_thread.wakeUp();
+        std::this_thread::sleep_for(1ms);
+    }
+    auto afterMetrics = std::chrono::steady_clock::now();
+
+    // [THEN] The metrics count the wake ups and the latency of the held request:
+    // it was made before afterRequest and served after beforeRelease
+    ASSERT_GT(metrics.wakeUpsPerSecond, 0.0);
+
+    auto toUs = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    EXPECT_GE(metrics.blockReadyLatencyMaxUs, toUs(beforeRelease - afterRequest));
+    EXPECT_LE(metrics.blockReadyLatencyMaxUs, toUs(afterMetrics - beforeRequest));
+    EXPECT_GT(metrics.blockReadyLatencyAvgUs, 0.0);
+    EXPECT_LE(metrics.blockReadyLatencyAvgUs, metrics.blockReadyLatencyMaxUs);
+}
@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "audio/internal/worker/mixer.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/tests/mocks/audioconfigurationmock.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::audio;
+
+static std::atomic<bool> s_countAllocations = false;
+static std::atomic<size_t> s_allocationsCount = 0;
+
+void* operator new(std::size_t size)
+{
+    if (s_countAllocations) {
+        ++s_allocationsCount;
+    }
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace mu::audio {
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr samples_t BLOCK_SIZE = 512;
+static constexpr size_t TRACKS_COUNT = 8;
+
+class ConstantSource : public IAudioSource
+{
+public:
+    explicit ConstantSource(float value)
+        : m_value(value) {}
+
+    void setValue(float value) { m_value = value; }
+
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return AUDIO_CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        std::fill(buffer, buffer + samplesPerChannel * AUDIO_CHANNELS_COUNT, m_value);
+        return samplesPerChannel;
+    }
+
+private:
+    float m_value = 0.f;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+
+class Audio_MixerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        modularity::ioc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+    }
+
+    void TearDown() override
+    {
+        modularity::ioc()->unregister<IAudioConfiguration>("utests");
+    }
+
+    MixerPtr makeMixer(size_t minTrackCountForMultithreading)
+    {
+        std::vector<std::shared_ptr<ConstantSource> > sources;
+        for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+            sources.push_back(std::make_shared<ConstantSource>(0.01f * (i + 1)));
+        }
+
+        return makeMixer(minTrackCountForMultithreading, sources);
+    }
+
+    MixerPtr makeMixer(size_t minTrackCountForMultithreading, const std::vector<std::shared_ptr<ConstantSource> >& sources)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading())
+        .WillByDefault(Return(minTrackCountForMultithreading));
+        ON_CALL(*m_configuration, renderStep())
+        .WillByDefault(Return(BLOCK_SIZE));
+
+        MixerPtr mixer = std::make_shared<Mixer>();
+        mixer->setSampleRate(SAMPLE_RATE);
+        mixer->setAudioChannelsCount(AUDIO_CHANNELS_COUNT);
+
+        for (size_t i = 0; i < sources.size(); ++i) {
+            mixer->addChannel(static_cast<TrackId>(i), sources.at(i));
+        }
+
+        return mixer;
+    }
+
+    static bool isSilent(const std::vector<float>& buffer)
+    {
+        return std::all_of(buffer.cbegin(), buffer.cend(), [](float sample) { return RealIsNull(sample); });
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+};
+}
+
+TEST_F(Audio_MixerTest, ProcessDoesNotAllocate)
+{
+    //! NOTE On the worker thread only, then with the tracks processed by the thread pool too
+    for (size_t minTrackCountForMultithreading : { TRACKS_COUNT + 1, size_t(1) }) {
+        // [GIVEN] A mixer with tracks that nothing was processed with yet
+        MixerPtr mixer = makeMixer(minTrackCountForMultithreading);
+        std::vector<float> buffer(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+
+        // [WHEN] The blocks are processed, starting with the first one
+        s_allocationsCount = 0;
+        s_countAllocations = true;
+
+        samples_t processed = 0;
+        for (int i = 0; i < 100; ++i) {
+            processed = mixer->process(buffer.data(), BLOCK_SIZE);
+        }
+
+        s_countAllocations = false;
+
+        // [THEN] Nothing is allocated
+        EXPECT_EQ(s_allocationsCount.load(), 0u) << "min track count for multithreading: " << minTrackCountForMultithreading;
+
+        // [THEN] The tracks were processed
+        EXPECT_EQ(processed, BLOCK_SIZE);
+        EXPECT_FALSE(isSilent(buffer));
+    }
+}
+
+TEST_F(Audio_MixerTest, SameOutputWithThreadPool)
+{
+    // [GIVEN] The same tracks mixed on the worker thread only and with the thread pool
+    MixerPtr singleThreadMixer = makeMixer(TRACKS_COUNT + 1);
+    MixerPtr multiThreadMixer = makeMixer(1);
+
+    std::vector<float> expected(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+    std::vector<float> actual(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+
+    for (int i = 0; i < 4; ++i) {
+        // [WHEN] The blocks are processed
+        singleThreadMixer->process(expected.data(), BLOCK_SIZE);
+        multiThreadMixer->process(actual.data(), BLOCK_SIZE);
+
+        // [THEN] The output is the same, and not silent
+        EXPECT_EQ(expected, actual);
+        EXPECT_FALSE(RealIsNull(actual.front()));
+    }
+}
+
+TEST_F(Audio_MixerTest, SilentTracks)
+{
+    // [GIVEN] Tracks that are all silent
+    std::vector<std::shared_ptr<ConstantSource> > sources;
+    for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+        sources.push_back(std::make_shared<ConstantSource>(0.f));
+    }
+
+    MixerPtr mixer = makeMixer(TRACKS_COUNT + 1, sources);
+    std::vector<float> buffer(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 1.f);
+
+    // [WHEN] The first block is processed
+    mixer->process(buffer.data(), BLOCK_SIZE);
+
+    // [THEN] The output is silent
+    EXPECT_TRUE(isSilent(buffer));
+
+    // [WHEN] The next blocks are processed
+    for (int i = 0; i < 4; ++i) {
+        std::fill(buffer.begin(), buffer.end(), 1.f);
+
+        // [THEN] Nothing is processed after the output went silent: the aux channels
+        //        and the master fx are skipped, and the output is cleared
+        EXPECT_EQ(mixer->process(buffer.data(), BLOCK_SIZE), 0);
+        EXPECT_TRUE(isSilent(buffer));
+    }
+}
+
+TEST_F(Audio_MixerTest, SilentTrackAmongAudibleOnes)
+{
+    // [GIVEN] The same audible tracks, once with a silent track among them
+    std::vector<std::shared_ptr<ConstantSource> > audibleSources {
+        std::make_shared<ConstantSource>(0.1f), std::make_shared<ConstantSource>(0.2f)
+    };
+
+    std::vector<std::shared_ptr<ConstantSource> > sources {
+        std::make_shared<ConstantSource>(0.1f), std::make_shared<ConstantSource>(0.f), std::make_shared<ConstantSource>(0.2f)
+    };
+
+    MixerPtr expectedMixer = makeMixer(TRACKS_COUNT + 1, audibleSources);
+    MixerPtr mixer = makeMixer(TRACKS_COUNT + 1, sources);
+
+    std::vector<float> expected(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+    std::vector<float> actual(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+
+    for (int i = 0; i < 4; ++i) {
+        // [WHEN] The blocks are processed
+        expectedMixer->process(expected.data(), BLOCK_SIZE);
+        samples_t processed = mixer->process(actual.data(), BLOCK_SIZE);
+
+        // [THEN] The silent track doesn't change the output
+        EXPECT_EQ(processed, BLOCK_SIZE);
+        EXPECT_EQ(expected, actual);
+        EXPECT_FALSE(isSilent(actual));
+    }
+}
+
+TEST_F(Audio_MixerTest, TracksGoSilentAndBack)
+{
+    // [GIVEN] Audible tracks
+    std::vector<std::shared_ptr<ConstantSource> > sources;
+    for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+        sources.push_back(std::make_shared<ConstantSource>(0.01f));
+    }
+
+    MixerPtr mixer = makeMixer(TRACKS_COUNT + 1, sources);
+    std::vector<float> buffer(BLOCK_SIZE * AUDIO_CHANNELS_COUNT, 0.f);
+
+    EXPECT_EQ(mixer->process(buffer.data(), BLOCK_SIZE), BLOCK_SIZE);
+    EXPECT_FALSE(isSilent(buffer));
+
+    // [WHEN] They go silent
+    for (const std::shared_ptr<ConstantSource>& source : sources) {
+        source->setValue(0.f);
+    }
+
+    // [THEN] The block where the output goes silent is still processed completely,
+    //        so the tails of the aux channels and the master fx aren't cut
+    EXPECT_EQ(mixer->process(buffer.data(), BLOCK_SIZE), BLOCK_SIZE);
+    EXPECT_TRUE(isSilent(buffer));
+
+    // [THEN] The next ones are skipped
+    EXPECT_EQ(mixer->process(buffer.data(), BLOCK_SIZE), 0);
+    EXPECT_TRUE(isSilent(buffer));
+
+    // [WHEN] They are audible again
+    for (const std::shared_ptr<ConstantSource>& source : sources) {
+        source->setValue(0.01f);
+    }
+
+    // [THEN] The output is processed again
+    EXPECT_EQ(mixer->process(buffer.data(), BLOCK_SIZE), BLOCK_SIZE);
+    EXPECT_FALSE(isSilent(buffer));
+}
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/dsp/simdkernels.h"
+
+#include "realfn.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+namespace mu::audio {
+class Audio_SimdKernelsTest : public ::testing::Test
+{
+public:
+    static std::vector<float> randomSamples(size_t count, unsigned int seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+        std::vector<float> result(count);
+        for (float& sample : result) {
+            sample = distribution(generator);
+        }
+
+        return result;
+    }
+
+    static void expectNear(const std::vector<float>& actual, const std::vector<float>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-6f) << "at " << i;
+        }
+    }
+};
+}
+
+TEST_F(Audio_SimdKernelsTest, MixAdd)
+{
+    //! NOTE Odd sizes check the samples after the last full vector
+    for (size_t count : { 0, 1, 3, 4, 7, 1024, 1027 }) {
+        std::vector<float> src = randomSamples(count, 1);
+        std::vector<float> dest = randomSamples(count, 2);
+
+        std::vector<float> expected = dest;
+        float expectedPeak = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            expected[i] += src[i];
+            expectedPeak = std::max(expectedPeak, std::abs(src[i]));
+        }
+
+        float peak = dsp::mixAdd(dest.data(), src.data(), count);
+
+        expectNear(dest, expected);
+        EXPECT_FLOAT_EQ(peak, expectedPeak);
+        EXPECT_FLOAT_EQ(dsp::peak(src.data(), count), expectedPeak);
+    }
+}
+
+TEST_F(Audio_SimdKernelsTest, MixAddScaledAndApplyGain)
+{
+    for (size_t count : { 5, 1024, 1031 }) {
+        std::vector<float> src = randomSamples(count, 3);
+        std::vector<float> dest = randomSamples(count, 4);
+
+        std::vector<float> expected = dest;
+        for (size_t i = 0; i < count; ++i) {
+            expected[i] = (expected[i] + src[i] * 0.3f) * 0.7f;
+        }
+
+        dsp::mixAddScaled(dest.data(), src.data(), 0.3f, count);
+        dsp::applyGain(dest.data(), 0.7f, count);
+
+        expectNear(dest, expected);
+    }
+}
+
+TEST_F(Audio_SimdKernelsTest, ApplyChannelGains)
+{
+    const float gains[] = { 0.5f, 1.5f, 0.25f };
+
+    //! NOTE Three channels don't fill the vectors evenly and take the sample by sample path
+    for (audioch_t channelsCount : { 1, 2, 3 }) {
+        for (samples_t samplesPerChannel : { 1, 3, 512, 513 }) {
+            std::vector<float> buffer = randomSamples(samplesPerChannel * channelsCount, 5);
+
+            std::vector<float> expected = buffer;
+            float expectedSquaredSums[3] = { 0.f, 0.f, 0.f };
+            float expectedPeak = 0.f;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                expected[i] *= gains[i % channelsCount];
+                expectedSquaredSums[i % channelsCount] += expected[i] * expected[i];
+                expectedPeak = std::max(expectedPeak, std::abs(expected[i]));
+            }
+
+            float squaredSums[3] = { 0.f, 0.f, 0.f };
+            float peak = dsp::applyChannelGains(buffer.data(), channelsCount, samplesPerChannel, gains, squaredSums);
+
+            expectNear(buffer, expected);
+            EXPECT_FLOAT_EQ(peak, expectedPeak);
+            for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+                EXPECT_NEAR(squaredSums[audioChNum], expectedSquaredSums[audioChNum], 1e-3f);
+            }
+        }
+    }
+}
+
+TEST_F(Audio_SimdKernelsTest, Mix200Tracks)
+{
+    static constexpr size_t TRACKS_COUNT = 200;
+    static constexpr size_t BLOCK_SIZE = 512 * 2; // stereo
+    static constexpr size_t BLOCKS_COUNT = 4;
+
+    std::vector<std::vector<float> > tracks;
+    for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+        tracks.push_back(randomSamples(BLOCK_SIZE, static_cast<unsigned int>(i)));
+    }
+
+    std::vector<float> scalarOut(BLOCK_SIZE, 0.f);
+    std::vector<float> simdOut(BLOCK_SIZE, 0.f);
+    bool scalarIsSilent = true;
+    float simdPeak = 0.f;
+
+    // [GIVEN] The scalar loop the mixer used before
+    for (size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        for (const std::vector<float>& track : tracks) {
+            for (size_t s = 0; s < BLOCK_SIZE; ++s) {
+                scalarOut[s] += track[s];
+                if (scalarIsSilent && !RealIsNull(track[s])) {
+                    scalarIsSilent = false;
+                }
+            }
+        }
+    }
+
+    // [WHEN] The same is mixed with the kernel
+    for (size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        for (const std::vector<float>& track : tracks) {
+            simdPeak = std::max(simdPeak, dsp::mixAdd(simdOut.data(), track.data(), BLOCK_SIZE));
+        }
+    }
+
+    // [THEN] The result is the same
+    EXPECT_EQ(scalarIsSilent, RealIsNull(simdPeak));
+    for (size_t s = 0; s < BLOCK_SIZE; ++s) {
+        EXPECT_NEAR(simdOut[s], scalarOut[s], 1e-3f);
+    }
+}
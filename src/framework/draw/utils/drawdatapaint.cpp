@@ -26,21 +26,23 @@
 using namespace mu;
 using namespace mu::draw;
 
-static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, const std::map<int, DrawData::State>& states,
-                     const Color& overlay)
+static void drawDatas(IPaintProviderPtr& provider, const std::vector<DrawData::Data>& datas,
+                      const std::map<int, DrawData::State>& states, const Color& overlay, const Transform* base)
 {
-    // first draw obj itself
-    for (const DrawData::Data& d : item.datas) {
-        DrawData::State st = states.at(d.state);
+    for (const DrawData::Data& d : datas) {
+        const DrawData::State& recorded = states.at(d.state);
+        DrawData::State overlaid;
         if (overlay.isValid()) {
-            st.pen.setColor(overlay);
-            st.brush.setColor(overlay);
+            overlaid = recorded;
+            overlaid.pen.setColor(overlay);
+            overlaid.brush.setColor(overlay);
         }
+        const DrawData::State& st = overlay.isValid() ? overlaid : recorded;
 
         provider->setPen(st.pen);
         provider->setBrush(st.brush);
         provider->setFont(st.font);
-        provider->setTransform(st.transform);
+        provider->setTransform(base ? st.transform * (*base) : st.transform);
         provider->setAntialiasing(st.isAntialiasing);
         provider->setCompositionMode(st.compositionMode);
 
@@ -73,10 +75,17 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
             }
         }
     }
+}
+
+static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, const std::map<int, DrawData::State>& states,
+                     const Color& overlay, const Transform* base = nullptr)
+{
+    // first draw obj itself
+    drawDatas(provider, item.datas, states, overlay, base);
 
     // second draw chilren
     for (const DrawData::Item& ch : item.chilren) {
-        drawItem(provider, ch, states, overlay);
+        drawItem(provider, ch, states, overlay, base);
     }
 }
 
@@ -85,3 +94,22 @@ void DrawDataPaint::paint(Painter* painter, const DrawDataPtr& data, const Color
     IPaintProviderPtr provider = painter->provider();
     drawItem(provider, data->item, data->states, overlay);
 }
+
+void DrawDataPaint::replay(Painter* painter, const DrawDataPtr& data, const std::function<bool(size_t)>& filter)
+{
+    IPaintProviderPtr provider = painter->provider();
+    const Transform base = provider->transform();
+
+    painter->save();
+
+    drawDatas(provider, data->item.datas, data->states, Color(), &base);
+
+    const std::vector<DrawData::Item>& objects = data->item.chilren;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (!filter || filter(i)) {
+            drawItem(provider, objects.at(i), data->states, Color(), &base);
+        }
+    }
+
+    painter->restore();
+}
@@ -22,6 +22,8 @@
 #ifndef MU_DRAW_DRAWDATAPAINT_H
 #define MU_DRAW_DRAWDATAPAINT_H
 
+#include <functional>
+
 #include "../painter.h"
 #include "../types/drawdata.h"
 
@@ -32,6 +34,12 @@ public:
     DrawDataPaint() = default;
 
     static void paint(Painter* painter, const DrawDataPtr& data, const Color& overlay = Color());
+
+    //! NOTE Unlike paint(), draws in the painter's current coordinates,
+    //! as if the recorded commands were issued on the painter again.
+    //! If set, filter gets the index of each top level object and
+    //! decides whether it is drawn.
+    static void replay(Painter* painter, const DrawDataPtr& data, const std::function<bool(size_t)>& filter = nullptr);
 };
 }
 
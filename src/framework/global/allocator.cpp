@@ -217,6 +217,121 @@ ObjectAllocator::Info ObjectAllocator::stateInfo() const
     return info;
 }
 
+// ============================================
+// ArenaAllocator
+// ============================================
+size_t ArenaAllocator::DEFAULT_BLOCK_SIZE(1024 * 64); // 64 kB
+
+static inline size_t alignTo(size_t n, size_t alignment)
+{
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+ArenaAllocator::ArenaAllocator(size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    for (const Block& b : m_blocks) {
+        std::free(b.begin);
+    }
+}
+
+bool ArenaAllocator::useBlock(size_t blockIdx, size_t size, size_t alignment)
+{
+    if (blockIdx >= m_blocks.size()) {
+        return false;
+    }
+
+    const Block& b = m_blocks.at(blockIdx);
+    size_t offset = blockIdx == m_blockIdx ? m_offset : 0;
+    uintptr_t base = reinterpret_cast<uintptr_t>(b.begin);
+    offset = alignTo(base + offset, alignment) - base;
+    if (offset + size > b.size) {
+        return false;
+    }
+
+    m_blockIdx = blockIdx;
+    m_offset = offset;
+    return true;
+}
+
+void* ArenaAllocator::alloc(size_t size, size_t alignment)
+{
+    if (!useBlock(m_blockIdx, size, alignment) && !useBlock(m_blockIdx + 1, size, alignment)) {
+        // the next block (kept from a previous pass) is too small, or there is none
+        Block b;
+        b.size = std::max(m_blockSize, size + alignment);
+        b.begin = reinterpret_cast<uint8_t*>(malloc(b.size));
+
+        size_t idx = m_blocks.empty() ? 0 : m_blockIdx + 1;
+        m_blocks.insert(m_blocks.begin() + idx, b);
+        m_statistic.totalBlockCount++;
+
+        useBlock(idx, size, alignment);
+    }
+
+    void* ptr = m_blocks.at(m_blockIdx).begin + m_offset;
+    m_offset += size;
+
+    m_statistic.totalAllocatedCount++;
+    m_statistic.totalAllocatedBytes += size;
+
+    return ptr;
+}
+
+void ArenaAllocator::free(void* ptr, size_t size)
+{
+    if (m_blocks.empty()) {
+        return;
+    }
+
+    // only the last allocation can be given back
+    uint8_t* top = m_blocks.at(m_blockIdx).begin + m_offset;
+    if (reinterpret_cast<uint8_t*>(ptr) + size == top) {
+        m_offset -= size;
+        m_statistic.totalFreeCount++;
+    }
+}
+
+ArenaAllocator::Marker ArenaAllocator::mark() const
+{
+    return Marker { m_blockIdx, m_offset };
+}
+
+void ArenaAllocator::rewind(const Marker& marker)
+{
+    m_blockIdx = marker.blockIdx;
+    m_offset = marker.offset;
+}
+
+void ArenaAllocator::reset()
+{
+    rewind(Marker());
+}
+
+ArenaAllocator::Info ArenaAllocator::stateInfo() const
+{
+    Info info;
+    info.blockCount = m_blocks.size();
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        info.allocatedBytes += m_blocks.at(i).size;
+        if (i < m_blockIdx) {
+            info.usedBytes += m_blocks.at(i).size;
+        }
+    }
+    info.usedBytes += m_offset;
+
+    info.totalAllocatedCount = m_statistic.totalAllocatedCount;
+    info.totalAllocatedBytes = m_statistic.totalAllocatedBytes;
+    info.totalFreeCount = m_statistic.totalFreeCount;
+    info.totalBlockCount = m_statistic.totalBlockCount;
+
+    return info;
+}
+
 // ============================================
 // AllocatorsRegister
 // ============================================
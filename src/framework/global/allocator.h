@@ -22,6 +22,7 @@
 #ifndef MU_GLOBAL_ALLOCATOR_H
 #define MU_GLOBAL_ALLOCATOR_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <list>
@@ -146,6 +147,125 @@ private:
     Statistic m_statistic;
 };
 
+//! NOTE Hands out memory of any size from large blocks and gives it back
+//! all at once, for data which lives only during one pass of some work
+//! (e.g. one layout). Memory of single objects is not reused, except for
+//! the last allocation (so that a growing container doesn't waste space).
+//! The blocks are kept for the next pass. Not thread safe.
+class ArenaAllocator
+{
+public:
+
+    ArenaAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ArenaAllocator();
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    static size_t DEFAULT_BLOCK_SIZE;
+
+    void* alloc(size_t size, size_t alignment = alignof(std::max_align_t));
+    void free(void* ptr, size_t size);
+
+    struct Marker {
+        size_t blockIdx = 0;
+        size_t offset = 0;
+    };
+
+    Marker mark() const;
+    void rewind(const Marker& marker);
+    void reset();
+
+    //! NOTE Gives back everything allocated during its lifetime.
+    //! Containers using the arena must be destroyed before it
+    //! and must not grow while it exists, if created outside of it.
+    class Scope
+    {
+    public:
+        Scope(ArenaAllocator& arena)
+            : m_arena(arena), m_marker(arena.mark()) {}
+        ~Scope() { m_arena.rewind(m_marker); }
+
+    private:
+        ArenaAllocator& m_arena;
+        Marker m_marker;
+    };
+
+    struct Info
+    {
+        size_t blockCount = 0;
+        size_t allocatedBytes = 0;          // size of all blocks
+        size_t usedBytes = 0;
+
+        uint64_t totalAllocatedCount = 0;   // allocations served
+        uint64_t totalAllocatedBytes = 0;
+        uint64_t totalFreeCount = 0;        // given back right away (last allocation)
+        uint64_t totalBlockCount = 0;       // blocks taken from the system allocator
+    };
+
+    Info stateInfo() const;
+
+private:
+
+    struct Block {
+        uint8_t* begin = nullptr;
+        size_t size = 0;
+    };
+
+    bool useBlock(size_t blockIdx, size_t size, size_t alignment);
+
+    size_t m_blockSize = 0;
+    std::vector<Block> m_blocks;
+    size_t m_blockIdx = 0;
+    size_t m_offset = 0;
+
+    struct Statistic
+    {
+        uint64_t totalAllocatedCount = 0;
+        uint64_t totalAllocatedBytes = 0;
+        uint64_t totalFreeCount = 0;
+        uint64_t totalBlockCount = 0;
+    };
+
+    Statistic m_statistic;
+};
+
+//! NOTE For standard containers, ex:
+//! std::vector<int, ArenaStlAllocator<int> > v(arena);
+template<class T>
+class ArenaStlAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaStlAllocator(ArenaAllocator& arena)
+        : m_arena(&arena) {}
+
+    template<class U>
+    ArenaStlAllocator(const ArenaStlAllocator<U>& other)
+        : m_arena(other.arena()) {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(m_arena->alloc(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        m_arena->free(ptr, n * sizeof(T));
+    }
+
+    ArenaAllocator* arena() const { return m_arena; }
+
+    template<class U>
+    bool operator==(const ArenaStlAllocator<U>& other) const { return m_arena == other.arena(); }
+    template<class U>
+    bool operator!=(const ArenaStlAllocator<U>& other) const { return m_arena != other.arena(); }
+
+private:
+    ArenaAllocator* m_arena = nullptr;
+};
+
 class AllocatorsRegister
 {
 public:
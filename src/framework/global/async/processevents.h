@@ -33,6 +33,11 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     deto::async::onMainThreadInvoke(f);
 }
+
+inline void onThreadInvoke(const std::function<void()>& f)
+{
+    deto::async::onThreadInvoke(f);
+}
 }
 
 #endif // MU_ASYNC_PROCESSEVENTS_H
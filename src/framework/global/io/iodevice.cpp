@@ -49,6 +49,9 @@ bool IODevice::open(IODevice::OpenMode mode)
 
 void IODevice::close()
 {
+    if (isOpen()) {
+        doClose();
+    }
     m_mode = Unknown;
 }
 
@@ -141,7 +144,7 @@ size_t IODevice::read(uint8_t* data, size_t len)
         len = left;
     }
 
-    std::memcpy(data, cdataOffsetted(), len);
+    len = fetchData(data, len);
 
     m_pos += len;
     return len;
@@ -166,13 +169,26 @@ ByteArray IODevice::read(size_t len)
         len = left;
     }
 
-    ByteArray result(cdataOffsetted(), len);
+    ByteArray result(len);
+    len = fetchData(result.data(), len);
+    result.truncate(len);
 
     m_pos += len;
 
     return result;
 }
 
+size_t IODevice::fetchData(uint8_t* data, size_t len)
+{
+    const uint8_t* d = cdataOffsetted();
+    if (!d) {
+        return 0;
+    }
+
+    std::memcpy(data, d, len);
+    return len;
+}
+
 const uint8_t* IODevice::cdataOffsetted() const
 {
     const uint8_t* d = rawData();
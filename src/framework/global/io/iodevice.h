@@ -78,6 +78,12 @@ protected:
     virtual bool resizeData(size_t size) = 0;
     virtual size_t writeData(const uint8_t* data, size_t len) = 0;
 
+    //! NOTE Reads len bytes from pos(), len is already clamped to size().
+    //! By default they are copied from rawData(),
+    //! devices that produce data on demand (rawData() is null) override it
+    virtual size_t fetchData(uint8_t* data, size_t len);
+    virtual void doClose() {}
+
     bool isOpenModeReadable() const;
     bool isOpenModeWriteable() const;
 
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ioretcodes.h"
+
+#include "log.h"
+
+using namespace mu::io;
+
+MappedFile::MappedFile(const path_t& filePath)
+    : m_filePath(filePath)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+path_t MappedFile::filePath() const
+{
+    return m_filePath;
+}
+
+bool MappedFile::doOpen(OpenMode m)
+{
+    if (m != OpenMode::ReadOnly) {
+        NOT_SUPPORTED << "mapped files are read-only";
+        return false;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(m_filePath.toStdWString().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        setError(int(Err::FSReadError), "failed open file");
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        setError(int(Err::FSReadError), "failed get file size");
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    // an empty file can't be mapped, there is nothing to read anyway
+    if (m_size == 0) {
+        return true;
+    }
+
+    m_mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle) {
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    m_fd = ::open(m_filePath.toStdString().c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        setError(int(Err::FSReadError), "failed open file");
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0) {
+        unmap();
+        setError(int(Err::FSReadError), "failed get file size");
+        return false;
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+
+    // an empty file can't be mapped, there is nothing to read anyway
+    if (m_size == 0) {
+        return true;
+    }
+
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data != MAP_FAILED) {
+        m_data = static_cast<const uint8_t*>(data);
+    }
+#endif
+
+    if (!m_data) {
+        unmap();
+        setError(int(Err::FSReadError), "failed map file");
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::doClose()
+{
+    unmap();
+}
+
+void MappedFile::unmap()
+{
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+#else
+    if (m_data) {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+size_t MappedFile::dataSize() const
+{
+    return m_size;
+}
+
+const uint8_t* MappedFile::rawData() const
+{
+    return m_data;
+}
+
+bool MappedFile::resizeData(size_t)
+{
+    return false;
+}
+
+size_t MappedFile::writeData(const uint8_t*, size_t)
+{
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IO_MAPPEDFILE_H
+#define MU_IO_MAPPEDFILE_H
+
+#include "iodevice.h"
+#include "path.h"
+
+namespace mu::io {
+//! NOTE Read-only file, mapped into memory instead of being read.
+//! The data is paged in by the OS on access, so only the parts that are used take up RAM
+//! and rawData() stays valid (and is safe to read from several threads) while the file is open.
+//! Files are replaced on save (written to a temp file and renamed), which keeps a mapping valid.
+class MappedFile : public IODevice
+{
+public:
+
+    MappedFile() = default;
+    MappedFile(const path_t& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    path_t filePath() const;
+
+protected:
+
+    bool doOpen(OpenMode m) override;
+    void doClose() override;
+    size_t dataSize() const override;
+    const uint8_t* rawData() const override;
+    bool resizeData(size_t size) override;
+    size_t writeData(const uint8_t* data, size_t len) override;
+
+private:
+
+    void unmap();
+
+    path_t m_filePath;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+}
+
+#endif // MU_IO_MAPPEDFILE_H
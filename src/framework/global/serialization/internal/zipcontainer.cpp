@@ -21,8 +21,11 @@
  */
 #include "zipcontainer.h"
 
+#include <algorithm>
+#include <climits>
 #include <ctime>
 #include <cstring>
+#include <vector>
 #include <zlib.h>
 
 #include "io/dir.h"
@@ -110,45 +113,6 @@ static void writeMSDosDate(uint8_t* dest, const std::tm& dt)
     }
 }
 
-static int inflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen)
-{
-    z_stream stream;
-    int err;
-
-    stream.next_in = const_cast<Bytef*>(source);
-    stream.avail_in = (uInt)sourceLen;
-    if ((uLong)stream.avail_in != sourceLen) {
-        return Z_BUF_ERROR;
-    }
-
-    stream.next_out = dest;
-    stream.avail_out = (uInt) * destLen;
-    if ((uLong)stream.avail_out != *destLen) {
-        return Z_BUF_ERROR;
-    }
-
-    stream.zalloc = (alloc_func)0;
-    stream.zfree = (free_func)0;
-
-    err = inflateInit2(&stream, -MAX_WBITS);
-    if (err != Z_OK) {
-        return err;
-    }
-
-    err = inflate(&stream, Z_FINISH);
-    if (err != Z_STREAM_END) {
-        inflateEnd(&stream);
-        if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0)) {
-            return Z_DATA_ERROR;
-        }
-        return err;
-    }
-    *destLen = stream.total_out;
-
-    err = inflateEnd(&stream);
-    return err;
-}
-
 static int deflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen)
 {
     z_stream stream;
@@ -384,7 +348,15 @@ struct ZipContainer::Impl {
         Directory, File, Symlink
     };
 
+    class EntryReader;
+    class EntryWriter;
+    EntryWriter* entryWriter = nullptr;
+
+    FileHeader makeHeader(EntryType type, const std::string& fileName) const;
     void addEntry(EntryType type, const std::string& fileName, const ByteArray& contents);
+    std::unique_ptr<IODevice> openEntryWriter(const std::string& fileName);
+    void finishEntry(size_t index, uint crc_32, size_t compressedSize, size_t uncompressedSize, bool ok);
+    void closeEntryWriter();
     bool writeToDevice(const uint8_t* data, size_t len);
     bool writeToDevice(const ByteArray& data);
 
@@ -392,9 +364,332 @@ struct ZipContainer::Impl {
         : device(d) {}
 
     void scanFiles();
+    const uint8_t* view(size_t offset, size_t len, ByteArray& buf) const;
+    const FileHeader* findHeader(const std::string& fileName) const;
+    std::unique_ptr<IODevice> openEntryReader(const std::string& fileName);
     ZipContainer::FileInfo fillFileInfo(size_t index) const;
 };
 
+//---------------------------------------------------------
+//   EntryReader
+//    inflates the entry as it is read; stored entries of
+//    memory backed archives are served in place
+//---------------------------------------------------------
+
+class ZipContainer::Impl::EntryReader : public IODevice
+{
+public:
+    EntryReader(IODevice* archive, size_t dataOffset, size_t compressedSize, size_t uncompressedSize, bool deflated)
+        : m_archive(archive), m_dataOffset(dataOffset), m_compressedSize(compressedSize), m_uncompressedSize(uncompressedSize),
+        m_deflated(deflated)
+    {
+    }
+
+    ~EntryReader() override
+    {
+        close();
+    }
+
+protected:
+    bool doOpen(OpenMode m) override
+    {
+        if (m != OpenMode::ReadOnly) {
+            NOT_SUPPORTED << "zip entries are opened for reading or writing only";
+            return false;
+        }
+
+        // null if the archive is not in memory, then it's read chunk by chunk
+        m_archiveData = m_archive->readData();
+
+        if (m_deflated) {
+            std::memset(&m_stream, 0, sizeof(z_stream));
+            if (inflateInit2(&m_stream, -MAX_WBITS) != Z_OK) {
+                return false;
+            }
+            m_streamInited = true;
+            m_inPos = 0;
+            m_outPos = 0;
+        }
+
+        return true;
+    }
+
+    void doClose() override
+    {
+        if (m_streamInited) {
+            inflateEnd(&m_stream);
+            m_streamInited = false;
+        }
+    }
+
+    size_t dataSize() const override
+    {
+        return m_uncompressedSize;
+    }
+
+    const uint8_t* rawData() const override
+    {
+        return (!m_deflated && m_archiveData) ? m_archiveData + m_dataOffset : nullptr;
+    }
+
+    bool resizeData(size_t) override
+    {
+        return false;
+    }
+
+    size_t writeData(const uint8_t*, size_t) override
+    {
+        return 0;
+    }
+
+    size_t fetchData(uint8_t* data, size_t len) override
+    {
+        if (!m_deflated) {
+            if (m_archiveData) {
+                return IODevice::fetchData(data, len);
+            }
+
+            m_archive->seek(m_dataOffset + pos());
+            return m_archive->read(data, len);
+        }
+
+        // seeking back starts over, seeking forward skips the data in between
+        if (pos() < m_outPos) {
+            inflateReset(&m_stream);
+            m_stream.avail_in = 0;
+            m_inPos = 0;
+            m_outPos = 0;
+        }
+
+        while (m_outPos < pos()) {
+            uint8_t skipped[4096];
+            if (inflateTo(skipped, std::min(sizeof(skipped), pos() - m_outPos)) == 0) {
+                return 0;
+            }
+        }
+
+        return inflateTo(data, len);
+    }
+
+private:
+    static constexpr size_t INPUT_CHUNK_SIZE = 64 * 1024;
+
+    bool feedInput()
+    {
+        if (m_inPos >= m_compressedSize) {
+            return false;
+        }
+
+        size_t len = std::min(m_compressedSize - m_inPos, m_archiveData ? size_t(UINT_MAX) : INPUT_CHUNK_SIZE);
+        if (m_archiveData) {
+            m_stream.next_in = const_cast<Bytef*>(m_archiveData + m_dataOffset + m_inPos);
+        } else {
+            m_input.resize(len);
+            m_archive->seek(m_dataOffset + m_inPos);
+            len = m_archive->read(m_input.data(), len);
+            if (len == 0) {
+                return false;
+            }
+            m_stream.next_in = m_input.data();
+        }
+
+        m_stream.avail_in = (uInt)len;
+        m_inPos += len;
+        return true;
+    }
+
+    size_t inflateTo(uint8_t* data, size_t len)
+    {
+        m_stream.next_out = data;
+        m_stream.avail_out = (uInt)std::min(len, size_t(UINT_MAX));
+        const uInt avail = m_stream.avail_out;
+
+        while (m_stream.avail_out > 0) {
+            if (m_stream.avail_in == 0 && !feedInput()) {
+                break;
+            }
+
+            const int res = ::inflate(&m_stream, Z_NO_FLUSH);
+            if (res == Z_STREAM_END) {
+                break;
+            }
+
+            if (res != Z_OK && !(res == Z_BUF_ERROR && m_stream.avail_in == 0)) {
+                LOGW("Zip: failed to inflate the entry, error %d, input data may be corrupted", res);
+                setError(res, "failed inflate");
+                break;
+            }
+        }
+
+        const size_t produced = avail - m_stream.avail_out;
+        m_outPos += produced;
+        return produced;
+    }
+
+    IODevice* m_archive = nullptr;
+    const uint8_t* m_archiveData = nullptr;
+    size_t m_dataOffset = 0;
+    size_t m_compressedSize = 0;
+    size_t m_uncompressedSize = 0;
+    bool m_deflated = false;
+
+    z_stream m_stream;
+    bool m_streamInited = false;
+    size_t m_inPos = 0;     // compressed bytes given to the stream
+    size_t m_outPos = 0;    // uncompressed bytes taken from the stream
+    std::vector<uint8_t> m_input;
+};
+
+//---------------------------------------------------------
+//   EntryWriter
+//    deflates the written data straight into the archive,
+//    the crc and sizes follow the data in a data descriptor
+//---------------------------------------------------------
+
+class ZipContainer::Impl::EntryWriter : public IODevice
+{
+public:
+    EntryWriter(Impl* zip, size_t headerIndex, bool deflated)
+        : m_zip(zip), m_headerIndex(headerIndex), m_deflated(deflated)
+    {
+    }
+
+    ~EntryWriter() override
+    {
+        close();
+    }
+
+protected:
+    bool doOpen(OpenMode m) override
+    {
+        if (m != OpenMode::WriteOnly) {
+            NOT_SUPPORTED << "zip entries are opened for reading or writing only";
+            return false;
+        }
+
+        if (m_deflated) {
+            std::memset(&m_stream, 0, sizeof(z_stream));
+            if (deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                return false;
+            }
+            m_streamInited = true;
+            m_output.resize(OUTPUT_CHUNK_SIZE);
+        }
+
+        return true;
+    }
+
+    void doClose() override
+    {
+        if (!m_zip) {
+            return;
+        }
+
+        bool ok = m_ok;
+        if (m_streamInited) {
+            m_stream.next_in = nullptr;
+            m_stream.avail_in = 0;
+            ok &= deflateInput(Z_FINISH);
+            ok &= flushOutput();
+            deflateEnd(&m_stream);
+            m_streamInited = false;
+        }
+
+        Impl* zip = m_zip;
+        m_zip = nullptr;
+        zip->finishEntry(m_headerIndex, m_crc, m_compressedSize, m_written, ok);
+    }
+
+    size_t dataSize() const override
+    {
+        return m_size;
+    }
+
+    const uint8_t* rawData() const override
+    {
+        return nullptr;
+    }
+
+    bool resizeData(size_t size) override
+    {
+        m_size = size;
+        return true;
+    }
+
+    size_t writeData(const uint8_t* data, size_t len) override
+    {
+        // the data goes out as it comes, there is no way back
+        IF_ASSERT_FAILED(m_zip && pos() == m_written) {
+            return 0;
+        }
+
+        m_crc = ::crc32(m_crc, data, (uInt)len);
+        m_written += len;
+
+        if (!m_deflated) {
+            m_compressedSize += len;
+            m_ok &= m_zip->writeToDevice(data, len);
+            return m_ok ? len : 0;
+        }
+
+        m_stream.next_in = const_cast<Bytef*>(data);
+        m_stream.avail_in = (uInt)len;
+        m_ok &= deflateInput(Z_NO_FLUSH);
+        return m_ok ? len : 0;
+    }
+
+private:
+    static constexpr size_t OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+    bool deflateInput(int flush)
+    {
+        for (;;) {
+            m_stream.next_out = m_output.data() + m_outputSize;
+            m_stream.avail_out = (uInt)(m_output.size() - m_outputSize);
+
+            const int res = ::deflate(&m_stream, flush);
+            m_outputSize = m_output.size() - m_stream.avail_out;
+
+            if (res == Z_STREAM_ERROR) {
+                return false;
+            }
+
+            // the output is written to the archive in chunks
+            if (m_outputSize == m_output.size()) {
+                if (!flushOutput()) {
+                    return false;
+                }
+                continue;
+            }
+
+            return flush != Z_FINISH || res == Z_STREAM_END;
+        }
+    }
+
+    bool flushOutput()
+    {
+        const bool ok = m_zip->writeToDevice(m_output.data(), m_outputSize);
+        m_compressedSize += m_outputSize;
+        m_outputSize = 0;
+        return ok;
+    }
+
+    Impl* m_zip = nullptr;
+    size_t m_headerIndex = 0;
+    bool m_deflated = false;
+
+    z_stream m_stream;
+    bool m_streamInited = false;
+    std::vector<uint8_t> m_output;
+    size_t m_outputSize = 0;
+
+    uLong m_crc = ::crc32(0, 0, 0);
+    size_t m_size = 0;
+    size_t m_written = 0;
+    size_t m_compressedSize = 0;
+    bool m_ok = true;
+};
+
 void ZipContainer::Impl::scanFiles()
 {
     if (!dirtyFileTree) {
@@ -412,78 +707,172 @@ void ZipContainer::Impl::scanFiles()
     }
 
     dirtyFileTree = false;
-    uint8_t tmp[4];
-    device->read(tmp, 4);
-    if (readUInt(tmp) != 0x04034b50) {
+    ByteArray buf;
+    const uint8_t* signature = view(0, 4, buf);
+    if (!signature || readUInt(signature) != 0x04034b50) {
         LOGW("Zip: not a zip file!");
         return;
     }
 
-    // find EndOfDirectory header
+    // find EndOfDirectory header, only the comment (at most 65535 bytes) follows it
+    const size_t size = device->size();
+    const size_t tailSize = std::min(size, sizeof(EndOfDirectory) + 0xffff);
+    const uint8_t* tail = tailSize >= sizeof(EndOfDirectory) ? view(size - tailSize, tailSize, buf) : nullptr;
+    const uint8_t* eod = nullptr;
     int i = 0;
-    int start_of_directory_local = -1;
-    int num_dir_entries = 0;
-    EndOfDirectory eod;
-    while (start_of_directory_local == -1) {
-        const int pos = int(device->size()) - int(sizeof(EndOfDirectory)) - i;
-        if (pos < 0 || i > 65535) {
-            LOGW("Zip: EndOfDirectory not found");
-            return;
-        }
-
-        device->seek(pos);
-        device->read((uint8_t*)&eod, sizeof(EndOfDirectory));
-        if (readUInt(eod.signature) == 0x06054b50) {
+    for (; tail && i <= int(tailSize - sizeof(EndOfDirectory)); ++i) {
+        const uint8_t* candidate = tail + tailSize - sizeof(EndOfDirectory) - i;
+        if (readUInt(candidate) == 0x06054b50) {
+            eod = candidate;
             break;
         }
-        ++i;
+    }
+
+    if (!eod) {
+        LOGW("Zip: EndOfDirectory not found");
+        return;
     }
 
     // have the eod
-    start_of_directory_local = readUInt(eod.dir_start_offset);
-    num_dir_entries = readUShort(eod.num_dir_entries);
-    ZDEBUG("start_of_directory at %d, num_dir_entries=%d", start_of_directory_local, num_dir_entries);
-    int comment_length = readUShort(eod.comment_length);
+    const EndOfDirectory* eodHeader = reinterpret_cast<const EndOfDirectory*>(eod);
+    const size_t start_of_directory_local = readUInt(eodHeader->dir_start_offset);
+    const int num_dir_entries = readUShort(eodHeader->num_dir_entries);
+    ZDEBUG("start_of_directory at %zu, num_dir_entries=%d", start_of_directory_local, num_dir_entries);
+    int comment_length = readUShort(eodHeader->comment_length);
     if (comment_length != i) {
         LOGW("Zip: failed to parse zip file.");
     }
-    comment = device->read(std::min(comment_length, i));
+    comment = ByteArray(eod + sizeof(EndOfDirectory), std::min(comment_length, i));
 
-    device->seek(start_of_directory_local);
+    // the directory is parsed in place, only what is kept is copied
+    const size_t directory_size = start_of_directory_local <= size ? size - start_of_directory_local : 0;
+    const uint8_t* directory = view(start_of_directory_local, directory_size, buf);
+    if (!directory) {
+        LOGW("Zip: Failed to read the zip index");
+        return;
+    }
+
+    size_t pos = 0;
+    fileHeaders.reserve(num_dir_entries);
     for (i = 0; i < num_dir_entries; ++i) {
-        FileHeader header;
-        int read = (int)device->read((uint8_t*)&header.h, sizeof(CentralFileHeader));
-        if (read < (int)sizeof(CentralFileHeader)) {
+        if (directory_size - pos < sizeof(CentralFileHeader)) {
             LOGW("Zip: Failed to read complete header, index may be incomplete");
             break;
         }
+
+        FileHeader header;
+        std::memcpy(&header.h, directory + pos, sizeof(CentralFileHeader));
+        pos += sizeof(CentralFileHeader);
         if (readUInt(header.h.signature) != 0x02014b50) {
             LOGW("Zip: invalid header signature, index may be incomplete");
             break;
         }
 
-        size_t l = readUShort(header.h.file_name_length);
-        header.file_name = device->read(l);
-        if (header.file_name.size() != l) {
-            LOGW("Zip: Failed to read filename from zip index, index may be incomplete");
-            break;
-        }
-        l = readUShort(header.h.extra_field_length);
-        header.extra_field = device->read(l);
-        if (header.extra_field.size() != l) {
-            LOGW("Zip: Failed to read extra field in zip file, skipping file, index may be incomplete");
+        const size_t nameLength = readUShort(header.h.file_name_length);
+        const size_t extraLength = readUShort(header.h.extra_field_length);
+        const size_t commentLength = readUShort(header.h.file_comment_length);
+        if (directory_size - pos < nameLength + extraLength + commentLength) {
+            LOGW("Zip: Failed to read filename, extra field or file comment from zip index, index may be incomplete");
             break;
         }
-        l = readUShort(header.h.file_comment_length);
-        header.file_comment = device->read(l);
-        if (header.file_comment.size() != l) {
-            LOGW("Zip: Failed to read read file comment, index may be incomplete");
-            break;
+
+        header.file_name = ByteArray(directory + pos, nameLength);
+        pos += nameLength;
+        header.extra_field = ByteArray(directory + pos, extraLength);
+        pos += extraLength;
+        header.file_comment = ByteArray(directory + pos, commentLength);
+        pos += commentLength;
+
+        ZDEBUG("found file '%s'", header.file_name.constChar());
+        fileHeaders.push_back(std::move(header));
+    }
+}
+
+//! NOTE Memory backed archives (mapped files, buffers) are used in place,
+//! otherwise the range is read into buf
+const uint8_t* ZipContainer::Impl::view(size_t offset, size_t len, ByteArray& buf) const
+{
+    const size_t size = device->size();
+    if (offset > size || len > size - offset) {
+        return nullptr;
+    }
+
+    if (const uint8_t* data = device->readData()) {
+        return data + offset;
+    }
+
+    device->seek(offset);
+    buf = device->read(len);
+    return buf.size() == len ? buf.constData() : nullptr;
+}
+
+const FileHeader* ZipContainer::Impl::findHeader(const std::string& fileName) const
+{
+    ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
+    for (const FileHeader& header : fileHeaders) {
+        if (header.file_name == fileNameBa) {
+            return &header;
         }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<IODevice> ZipContainer::Impl::openEntryReader(const std::string& fileName)
+{
+    scanFiles();
+
+    const FileHeader* header = findHeader(fileName);
+    if (!header) {
+        return nullptr;
+    }
+
+    ushort version_needed = readUShort(header->h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        LOGW("Zip: .ZIP specification version %d implementation is needed to extract the data.", version_needed);
+        return nullptr;
+    }
+
+    ushort general_purpose_bits = readUShort(header->h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        LOGW("Zip: Unsupported encryption method is needed to extract the data.");
+        return nullptr;
+    }
 
-        ZDEBUG("found file '%s'", header.file_name.data());
-        fileHeaders.push_back(header);
+    size_t compressed_size = readUInt(header->h.compressed_size);
+    size_t uncompressed_size = readUInt(header->h.uncompressed_size);
+    size_t start = readUInt(header->h.offset_local_header);
+
+    ByteArray buf;
+    const LocalFileHeader* lh = reinterpret_cast<const LocalFileHeader*>(view(start, sizeof(LocalFileHeader), buf));
+    if (!lh) {
+        LOGW("Zip: Failed to read the local header of %s", fileName.c_str());
+        return nullptr;
     }
+
+    const size_t dataOffset = start + sizeof(LocalFileHeader) + readUShort(lh->file_name_length) + readUShort(lh->extra_field_length);
+    const size_t size = device->size();
+    if (dataOffset > size) {
+        LOGW("Zip: Failed to read the data of %s", fileName.c_str());
+        return nullptr;
+    }
+    compressed_size = std::min(compressed_size, size - dataOffset);
+
+    int compression_method = readUShort(lh->compression_method);
+    if (compression_method == CompressionMethodStored) {
+        uncompressed_size = std::min(uncompressed_size, compressed_size);
+    } else if (compression_method != CompressionMethodDeflated) {
+        LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return nullptr;
+    }
+
+    auto entry = std::make_unique<EntryReader>(device, dataOffset, compressed_size, uncompressed_size,
+                                               compression_method == CompressionMethodDeflated);
+    if (!entry->open(IODevice::ReadOnly)) {
+        LOGW("Zip: Z_MEM_ERROR: Not enough memory");
+        return nullptr;
+    }
+
+    return entry;
 }
 
 ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(size_t index) const
@@ -559,30 +948,13 @@ ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(size_t index) const
     return fileInfo;
 }
 
-void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
+FileHeader ZipContainer::Impl::makeHeader(EntryType type, const std::string& fileName) const
 {
-    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
-        status = ZipContainer::FileOpenError;
-        return;
-    }
-    device->seek(start_of_directory);
-
-    // don't compress small files
-    ZipContainer::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == ZipContainer::AutoCompress) {
-        if (contents.size() < 64) {
-            compression = ZipContainer::NeverCompress;
-        } else {
-            compression = ZipContainer::AlwaysCompress;
-        }
-    }
-
     FileHeader header;
     std::memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, (uint)contents.size());
 
     std::time_t t = std::time(0);   // get time now
     std::tm now;
@@ -592,37 +964,6 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     localtime_r(&t, &now);
 #endif
     writeMSDosDate(header.h.last_mod_file, now);
-    ByteArray data = contents;
-    if (compression == ZipContainer::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-        ulong len = (ulong)contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, (uint)data.size());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uint8_t*)contents.constData(), (uint)contents.size());
-    writeUInt(header.h.crc_32, crc_32);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -666,6 +1007,64 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     writeUInt(header.h.external_file_attributes, mode << 16);
     writeUInt(header.h.offset_local_header, start_of_directory);
 
+    return header;
+}
+
+void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
+{
+    closeEntryWriter();
+
+    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
+        status = ZipContainer::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    // don't compress small files
+    ZipContainer::CompressionPolicy compression = compressionPolicy;
+    if (compressionPolicy == ZipContainer::AutoCompress) {
+        if (contents.size() < 64) {
+            compression = ZipContainer::NeverCompress;
+        } else {
+            compression = ZipContainer::AlwaysCompress;
+        }
+    }
+
+    FileHeader header = makeHeader(type, fileName);
+    writeUInt(header.h.uncompressed_size, (uint)contents.size());
+
+    ByteArray data = contents;
+    if (compression == ZipContainer::AlwaysCompress) {
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+
+        ulong len = (ulong)contents.size();
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        int res;
+        do {
+            data.resize(len);
+            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
+
+            switch (res) {
+            case Z_OK:
+                data.resize(len);
+                break;
+            case Z_MEM_ERROR:
+                LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+                data.resize(0);
+                break;
+            case Z_BUF_ERROR:
+                len *= 2;
+                break;
+            }
+        } while (res == Z_BUF_ERROR);
+    }
+// TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
+    writeUInt(header.h.compressed_size, (uint)data.size());
+    uint crc_32 = ::crc32(0, 0, 0);
+    crc_32 = ::crc32(crc_32, (const uint8_t*)contents.constData(), (uint)contents.size());
+    writeUInt(header.h.crc_32, crc_32);
+
     fileHeaders.push_back(header);
 
     bool ok = true;
@@ -683,6 +1082,79 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     }
 }
 
+std::unique_ptr<IODevice> ZipContainer::Impl::openEntryWriter(const std::string& fileName)
+{
+    closeEntryWriter();
+
+    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
+        status = ZipContainer::FileOpenError;
+        return nullptr;
+    }
+    device->seek(start_of_directory);
+
+    // the size is not known beforehand, so only NeverCompress stores
+    const bool deflated = compressionPolicy != ZipContainer::NeverCompress;
+
+    FileHeader header = makeHeader(File, fileName);
+    writeUShort(header.h.compression_method, deflated ? CompressionMethodDeflated : CompressionMethodStored);
+    writeUShort(header.h.general_purpose_bits, readUShort(header.h.general_purpose_bits) | HasDataDescriptor);
+
+    fileHeaders.push_back(header);
+    dirtyFileTree = true;
+
+    // the crc and sizes are zero here, they follow the data
+    bool ok = true;
+    LocalFileHeader h = header.h.toLocalHeader();
+    ok &= writeToDevice((const uint8_t*)&h, sizeof(LocalFileHeader));
+    ok &= writeToDevice(header.file_name);
+    if (!ok) {
+        status = ZipContainer::FileWriteError;
+    }
+
+    auto writer = std::make_unique<EntryWriter>(this, fileHeaders.size() - 1, deflated);
+    if (!writer->open(IODevice::WriteOnly)) {
+        LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file");
+        status = ZipContainer::FileWriteError;
+        return nullptr;
+    }
+
+    entryWriter = writer.get();
+    return writer;
+}
+
+void ZipContainer::Impl::finishEntry(size_t index, uint crc_32, size_t compressedSize, size_t uncompressedSize, bool ok)
+{
+    FileHeader& header = fileHeaders.at(index);
+    writeUInt(header.h.crc_32, crc_32);
+    writeUInt(header.h.compressed_size, (uint)compressedSize);
+    writeUInt(header.h.uncompressed_size, (uint)uncompressedSize);
+
+    uint8_t signature[4];
+    writeUInt(signature, 0x08074b50);
+    DataDescriptor dd;
+    copyUInt(dd.crc_32, header.h.crc_32);
+    copyUInt(dd.compressed_size, header.h.compressed_size);
+    copyUInt(dd.uncompressed_size, header.h.uncompressed_size);
+
+    ok &= writeToDevice(signature, sizeof(signature));
+    ok &= writeToDevice((const uint8_t*)&dd, sizeof(DataDescriptor));
+
+    start_of_directory = (uint)device->pos();
+    entryWriter = nullptr;
+
+    if (!ok) {
+        status = ZipContainer::FileWriteError;
+    }
+}
+
+//! NOTE Entries are written one after another, so an open one is finished before anything else is written
+void ZipContainer::Impl::closeEntryWriter()
+{
+    if (entryWriter) {
+        entryWriter->close();
+    }
+}
+
 bool ZipContainer::Impl::writeToDevice(const uint8_t* data, size_t len)
 {
     return device->write(data, len) == len;
@@ -726,97 +1198,22 @@ int ZipContainer::count() const
 bool ZipContainer::fileExists(const std::string& fileName) const
 {
     p->scanFiles();
-    ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
-    for (size_t i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == fileNameBa) {
-            return true;
-        }
-    }
-    return false;
+    return p->findHeader(fileName) != nullptr;
 }
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
-    p->scanFiles();
-
-    ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
-
-    size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == fileNameBa) {
-            break;
-        }
-    }
-
-    if (i == p->fileHeaders.size()) {
-        return ByteArray();
-    }
-
-    FileHeader header = p->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        LOGW("Zip: .ZIP specification version %d implementation is needed to extract the data.", version_needed);
+    std::unique_ptr<IODevice> entry = p->openEntryReader(fileName);
+    if (!entry) {
         return ByteArray();
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-
-    if ((general_purpose_bits & Encrypted) != 0) {
-        LOGW("Zip: Unsupported encryption method is needed to extract the data.");
-        return ByteArray();
-    }
-
-    ByteArray compressed = p->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
-
-            switch (res) {
-            case Z_OK:
-                if ((size_t)len != baunzip.size()) {
-                    baunzip.resize(len);
-                }
-                break;
-            case Z_MEM_ERROR:
-                LOGW("Zip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                LOGW("Zip: Z_DATA_ERROR: Input data is corrupted");
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
-    }
+    return entry->readAll();
+}
 
-    LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return ByteArray();
+std::unique_ptr<IODevice> ZipContainer::openFile(const std::string& fileName) const
+{
+    return p->openEntryReader(fileName);
 }
 
 ZipContainer::Status ZipContainer::status() const
@@ -839,6 +1236,11 @@ void ZipContainer::addFile(const std::string& fileName, const ByteArray& data)
     p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), data);
 }
 
+std::unique_ptr<IODevice> ZipContainer::openFileForWriting(const std::string& fileName)
+{
+    return p->openEntryWriter(Dir::fromNativeSeparators(fileName).toStdString());
+}
+
 void ZipContainer::addDirectory(const std::string& dirName)
 {
     std::string name(Dir::fromNativeSeparators(dirName).toStdString());
@@ -851,6 +1253,8 @@ void ZipContainer::addDirectory(const std::string& dirName)
 
 void ZipContainer::close()
 {
+    p->closeEntryWriter();
+
     if (!(p->device->openMode() & IODevice::WriteOnly)) {
         p->device->close();
         return;
@@ -23,6 +23,7 @@
 #define MU_GLOBAL_ZIPCONTAINER_H
 
 #include <ctime>
+#include <memory>
 #include <string>
 
 #include "io/iodevice.h"
@@ -66,6 +67,10 @@ public:
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
 
+    //! NOTE The entry is inflated as it is read,
+    //! the device stays valid while the container is open
+    std::unique_ptr<io::IODevice> openFile(const std::string& fileName) const;
+
     // Write
     enum CompressionPolicy {
         AlwaysCompress,
@@ -77,6 +82,10 @@ public:
     CompressionPolicy compressionPolicy() const;
 
     void addFile(const std::string& fileName, const ByteArray& data);
+
+    //! NOTE The written data is deflated into the archive as it comes,
+    //! the entry is finished when the device is closed or anything else is added
+    std::unique_ptr<io::IODevice> openFileForWriting(const std::string& fileName);
     void addDirectory(const std::string& dirName);
 
 private:
@@ -21,21 +21,728 @@
  */
 #include "xmlstreamreader.h"
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 
-#include "thirdparty/tinyxml/tinyxml2.h"
+#include "allocator.h"
 
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
+
+//! NOTE The input is read in chunks of this size. A token is always contiguous
+//! in one chunk: the beginning of an incomplete token is copied to the next chunk.
+static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+namespace {
+enum DecodeFlags {
+    DECODE_NEWLINES = 1 << 0,
+    DECODE_ENTITIES = 1 << 1
+};
+
+struct Chunk {
+    explicit Chunk(size_t size)
+        : data(new char[size]), capacity(size) {}
+
+    std::unique_ptr<char[]> data;
+    size_t capacity = 0;
+};
+
+using ChunkPtr = std::shared_ptr<Chunk>;
+
+inline bool isWhiteSpace(char ch)
+{
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\v' || ch == '\f';
+}
+
+inline bool isNameStartChar(char ch)
+{
+    const unsigned char c = static_cast<unsigned char>(ch);
+    return c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == ':' || c == '_';
+}
+
+inline bool isNameChar(char ch)
+{
+    return isNameStartChar(ch) || (ch >= '0' && ch <= '9') || ch == '.' || ch == '-';
+}
+
+size_t toUtf8(uint32_t ucs, char* out)
+{
+    if (ucs < 0x80) {
+        out[0] = static_cast<char>(ucs);
+        return 1;
+    } else if (ucs < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (ucs >> 6));
+        out[1] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 2;
+    } else if (ucs < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (ucs >> 12));
+        out[1] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (ucs >> 18));
+    out[1] = static_cast<char>(0x80 | ((ucs >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (ucs & 0x3F));
+    return 4;
+}
+
+//! NOTE Entity at p (which points to '&'), written to out.
+//! Returns the length of the entity or 0 if it is not one we know (then it's kept as is).
+size_t decodeEntity(const char* p, const char* end, char* out, size_t* outLen)
+{
+    struct Entity {
+        const char* pattern;
+        size_t length;
+        char value;
+    };
+
+    static const Entity ENTITIES[] = {
+        { "quot", 4, '\"' },
+        { "amp", 3, '&' },
+        { "apos", 4, '\'' },
+        { "lt", 2, '<' },
+        { "gt", 2, '>' }
+    };
+
+    if (p + 1 < end && p[1] == '#') {
+        const bool hex = p + 2 < end && p[2] == 'x';
+        const char* q = p + (hex ? 3 : 2);
+        uint32_t ucs = 0;
+        size_t digits = 0;
+        for (; q < end && *q != ';'; ++q, ++digits) {
+            unsigned int d = 0;
+            if (*q >= '0' && *q <= '9') {
+                d = *q - '0';
+            } else if (hex && *q >= 'a' && *q <= 'f') {
+                d = *q - 'a' + 10;
+            } else if (hex && *q >= 'A' && *q <= 'F') {
+                d = *q - 'A' + 10;
+            } else {
+                return 0;
+            }
+            ucs = ucs * (hex ? 16 : 10) + d;
+            if (ucs > 0x10FFFF) {
+                return 0;
+            }
+        }
+        if (q == end || digits == 0) {
+            return 0;
+        }
+        *outLen = toUtf8(ucs, out);
+        return q - p + 1;
+    }
+
+    for (const Entity& e : ENTITIES) {
+        if (p + e.length + 1 < end && std::strncmp(p + 1, e.pattern, e.length) == 0 && p[e.length + 1] == ';') {
+            out[0] = e.value;
+            *outLen = 1;
+            return e.length + 2;
+        }
+    }
+
+    return 0;
+}
+
+//! NOTE Decoding never makes a string longer, so it is done in place
+size_t decode(char* str, size_t len, int flags)
+{
+    const char* p = str;
+    const char* end = str + len;
+    char* q = str;
+    while (p < end) {
+        const char ch = *p;
+        if ((flags & DECODE_NEWLINES) && (ch == '\r' || ch == '\n')) {
+            // CR-LF, LF-CR and CR alone become LF
+            const char pair = ch == '\r' ? '\n' : '\r';
+            p += (p + 1 < end && p[1] == pair) ? 2 : 1;
+            *q++ = '\n';
+        } else if ((flags & DECODE_ENTITIES) && ch == '&') {
+            char buf[4];
+            size_t bufLen = 0;
+            size_t entityLen = decodeEntity(p, end, buf, &bufLen);
+            if (entityLen) {
+                p += entityLen;
+                std::memcpy(q, buf, bufLen);
+                q += bufLen;
+            } else {
+                *q++ = *p++;
+            }
+        } else {
+            *q++ = *p++;
+        }
+    }
+    *q = '\0';
+    return q - str;
+}
+
+struct Text {
+    char* str = nullptr;
+    size_t len = 0;
+    int flags = 0;
+
+    AsciiStringView view()
+    {
+        if (!str) {
+            return AsciiStringView();
+        }
+        if (flags) {
+            len = decode(str, len, flags);
+            flags = 0;
+        }
+        return AsciiStringView(str, len);
+    }
+};
+
+struct RawAttribute {
+    AsciiStringView name;
+    Text value;
+};
+
+struct Token {
+    XmlStreamReader::TokenType type = XmlStreamReader::NoToken;
+    AsciiStringView name;
+    Text text;
+    std::vector<RawAttribute> attributes;
+    ChunkPtr chunk;             // keeps name-less data (text, attribute values) alive
+    int64_t line = 0;
+    int64_t column = 0;
+
+    void clear()
+    {
+        type = XmlStreamReader::NoToken;
+        name = AsciiStringView();
+        text = Text();
+        attributes.clear();
+        chunk.reset();
+    }
+
+    RawAttribute* attribute(const char* attrName)
+    {
+        for (RawAttribute& a : attributes) {
+            if (a.name == attrName) {
+                return &a;
+            }
+        }
+        return nullptr;
+    }
+};
+
+//! NOTE Element and attribute names are stored once for the reader's lifetime,
+//! so name() stays valid and names compare by pointer
+class NameTable
+{
+public:
+    AsciiStringView intern(const char* str, size_t len)
+    {
+        if ((m_count + 1) * 2 > m_slots.size()) {
+            grow();
+        }
+
+        const uint32_t h = hash(str, len);
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            Entry& e = m_slots[i];
+            if (!e.str) {
+                char* s = static_cast<char*>(m_strings.alloc(len + 1, 1));
+                std::memcpy(s, str, len);
+                s[len] = '\0';
+                e = { s, len, h };
+                ++m_count;
+                return AsciiStringView(s, len);
+            }
+            if (e.hash == h && e.len == len && std::memcmp(e.str, str, len) == 0) {
+                return AsciiStringView(e.str, len);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        const char* str = nullptr;
+        size_t len = 0;
+        uint32_t hash = 0;
+    };
+
+    static uint32_t hash(const char* str, size_t len)
+    {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; ++i) {
+            h = (h ^ static_cast<unsigned char>(str[i])) * 16777619u;
+        }
+        return h;
+    }
+
+    void grow()
+    {
+        std::vector<Entry> old = std::move(m_slots);
+        m_slots.assign(std::max<size_t>(64, old.size() * 2), Entry());
+        const size_t mask = m_slots.size() - 1;
+        for (const Entry& e : old) {
+            if (!e.str) {
+                continue;
+            }
+            size_t i = e.hash & mask;
+            while (m_slots[i].str) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = e;
+        }
+    }
+
+    std::vector<Entry> m_slots;
+    size_t m_count = 0;
+    ArenaAllocator m_strings { 4 * 1024 };
+};
+}
+
+//---------------------------------------------------------
+//   Xml
+//    pull tokenizer, reads the input chunk by chunk
+//---------------------------------------------------------
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    // input
+    IODevice* device = nullptr;
+    ByteArray data;
+    size_t dataPos = 0;
+    bool inputEnd = false;
+
+    ChunkPtr chunk;
+    char* pos = nullptr;
+    char* end = nullptr;
+    bool pendingLt = false;         // *pos is a '<' overwritten by the terminator of the previous text
+    bool pendingEndElement = false; // after an empty element <a/>
+    bool started = false;
+    bool onlyDeclarations = true;   // declarations are allowed only at the beginning
+
+    // position
+    const char* counted = nullptr;
+    int64_t line = 1;
+    int64_t column = 1;
+
+    struct OpenElement {
+        AsciiStringView name;
+        ChunkPtr chunk;             // keeps attribute values alive until the end element
+    };
+
+    NameTable names;
+    std::vector<OpenElement> stack;
+
+    Token token;
+    Token prevToken;
+    ChunkPtr lastText;              // keeps the result of readAsciiText() alive
+
+    Error err = NoError;
+    String errString;
+    int64_t errLine = 0;
+    int64_t errColumn = 0;
     String customErr;
+
+    void reset()
+    {
+        device = nullptr;
+        data = ByteArray();
+        dataPos = 0;
+        inputEnd = false;
+        chunk.reset();
+        pos = end = nullptr;
+        pendingLt = pendingEndElement = started = false;
+        onlyDeclarations = true;
+        counted = nullptr;
+        line = column = 1;
+        stack.clear();
+        token.clear();
+        prevToken.clear();
+        lastText.reset();
+        err = NoError;
+        errString.clear();
+        errLine = errColumn = 0;
+        customErr.clear();
+    }
+
+    size_t readInput(char* dst, size_t max)
+    {
+        if (device) {
+            return device->read(reinterpret_cast<uint8_t*>(dst), max);
+        }
+
+        const size_t n = std::min(max, data.size() - dataPos);
+        std::memcpy(dst, data.constData() + dataPos, n);
+        dataPos += n;
+        return n;
+    }
+
+    void countLines(const char* to)
+    {
+        const char* c = counted;
+        while (c < to) {
+            const char* nl = static_cast<const char*>(std::memchr(c, '\n', to - c));
+            if (!nl) {
+                column += to - c;
+                break;
+            }
+            ++line;
+            column = 1;
+            c = nl + 1;
+        }
+        counted = std::max(counted, to);
+    }
+
+    //! NOTE Reads more input, [tokenStart, end) stays contiguous (moved to a new chunk)
+    bool fill(char*& tokenStart)
+    {
+        if (inputEnd) {
+            return false;
+        }
+
+        countLines(tokenStart);
+
+        const size_t keep = end - tokenStart;
+        ChunkPtr next = std::make_shared<Chunk>(std::max(CHUNK_SIZE, keep * 2 + 1));
+        if (keep) {
+            std::memcpy(next->data.get(), tokenStart, keep);
+        }
+
+        // one byte is left for the terminator of a text at the very end
+        const size_t read = readInput(next->data.get() + keep, next->capacity - keep - 1);
+        if (read == 0) {
+            inputEnd = true;
+            return false;
+        }
+
+        // the part of the token that was already counted stays counted
+        const size_t countedOffset = counted - tokenStart;
+        chunk = next;
+        tokenStart = chunk->data.get();
+        end = tokenStart + keep + read;
+        *end = '\0';
+        counted = tokenStart + countedOffset;
+        return true;
+    }
+
+    //! NOTE Finds seq at or after s + offset, offset is then its position
+    bool find(char*& s, size_t& offset, const char* seq, size_t n)
+    {
+        for (;;) {
+            char* from = s + offset;
+            while (from + n <= end) {
+                char* c = static_cast<char*>(std::memchr(from, seq[0], end - from - n + 1));
+                if (!c) {
+                    from = end - n + 1;
+                    break;
+                }
+                if (std::memcmp(c, seq, n) == 0) {
+                    offset = c - s;
+                    return true;
+                }
+                from = c + 1;
+            }
+            offset = from - s;
+            if (!fill(s)) {
+                return false;
+            }
+        }
+    }
+
+    TokenType error(Error e, const String& message)
+    {
+        err = e;
+        errLine = line;
+        errColumn = column;
+        errString = message + String(u", line: %1, column: %2").arg(line).arg(column);
+        token.type = Invalid;
+        LOGE() << errString;
+        return Invalid;
+    }
+
+    void beginToken(char* s)
+    {
+        countLines(s);
+        token.line = line;
+        token.column = column;
+        token.chunk = chunk;
+        started = true;
+    }
+
+    void endToken(char* next)
+    {
+        pos = next;
+        countLines(next);
+        if (token.type != StartDocument) {
+            onlyDeclarations = false;
+        }
+    }
+
+    TokenType next()
+    {
+        std::swap(token, prevToken);
+        token.clear();
+
+        if (pendingEndElement) {
+            pendingEndElement = false;
+            token.type = EndElement;
+            token.name = stack.back().name;
+            token.line = prevToken.line;
+            token.column = prevToken.column;
+            stack.pop_back();
+            return token.type;
+        }
+
+        if (!started) {
+            // skip the UTF-8 BOM
+            while (end - pos < 3 && fill(pos)) {
+            }
+            if (end - pos >= 3 && std::memcmp(pos, "\xEF\xBB\xBF", 3) == 0) {
+                pos += 3;
+                counted = pos;
+            }
+        }
+
+        for (;;) {
+            if (pendingLt) {
+                TokenType type = readMarkup();
+                if (type == NoToken) {
+                    continue;
+                }
+                return type;
+            }
+
+            // whitespace between markup is skipped, before text it belongs to the text
+            char* start = pos;
+            size_t offset = 0;
+            for (;;) {
+                char* p = start + offset;
+                while (p < end && isWhiteSpace(*p)) {
+                    ++p;
+                }
+                offset = p - start;
+                if (p < end || !fill(start)) {
+                    break;
+                }
+            }
+
+            char* p = start + offset;
+            if (p == end) {
+                pos = p;
+                countLines(p);
+                if (!stack.empty()) {
+                    return error(PrematureEndOfDocumentError, String(u"unexpected end of document, element <%1> is not closed")
+                                 .arg(String::fromAscii(stack.back().name.ascii())));
+                }
+                if (!started) {
+                    return error(PrematureEndOfDocumentError, u"empty document");
+                }
+                token.type = EndDocument;
+                return token.type;
+            }
+
+            if (*p == '<') {
+                pos = p;
+                pendingLt = true;
+                TokenType type = readMarkup();
+                if (type == NoToken) {
+                    continue;
+                }
+                return type;
+            }
+
+            pos = start;
+            return readText(offset);
+        }
+    }
+
+    TokenType readText(size_t offset)
+    {
+        char* s = pos;
+        beginToken(s + offset);
+
+        if (!find(s, offset, "<", 1)) {
+            return error(NotWellFormedError, u"text outside of an element at the end of document");
+        }
+
+        char* lt = s + offset;
+        token.type = Characters;
+        token.text = { s, offset, DECODE_NEWLINES | DECODE_ENTITIES };
+        token.chunk = chunk;
+
+        // the '<' is remembered, so the text can be terminated in place
+        *lt = '\0';
+        pendingLt = true;
+        endToken(lt);
+        return token.type;
+    }
+
+    //! NOTE pos points to '<' (which may be overwritten already, see pendingLt).
+    //! Returns NoToken for skipped markup
+    TokenType readMarkup()
+    {
+        char* s = pos;
+        pendingLt = false;
+        beginToken(s);
+
+        // enough to tell the kind of markup
+        while (end - s < 9 && fill(s)) {
+        }
+
+        auto startsWith = [&s, this](const char* prefix, size_t n) {
+            return static_cast<size_t>(end - s) >= n && std::memcmp(s + 1, prefix + 1, n - 1) == 0;
+        };
+
+        if (startsWith("<!--", 4)) {
+            return readDelimited(s, 4, "-->", 3, Comment, DECODE_NEWLINES);
+        } else if (startsWith("<![CDATA[", 9)) {
+            return readDelimited(s, 9, "]]>", 3, Characters, DECODE_NEWLINES);
+        } else if (startsWith("<!", 2)) {
+            return readDelimited(s, 2, ">", 1, DTD, DECODE_NEWLINES);
+        } else if (startsWith("<?", 2)) {
+            TokenType type = readDelimited(s, 2, "?>", 2, StartDocument, DECODE_NEWLINES);
+            if (type == StartDocument && !onlyDeclarations) {
+                // declarations in the middle (e.g. from Sibelius) are skipped
+                token.clear();
+                return NoToken;
+            }
+            return type;
+        }
+
+        return readElement(s);
+    }
+
+    TokenType readDelimited(char* s, size_t prefixLen, const char* delim, size_t delimLen, TokenType type, int flags)
+    {
+        size_t offset = prefixLen;
+        if (!find(s, offset, delim, delimLen)) {
+            return error(PrematureEndOfDocumentError, String(u"expected %1").arg(String::fromAscii(delim)));
+        }
+
+        char* d = s + offset;
+        *d = '\0';
+        token.type = type;
+        token.text = { s + prefixLen, offset - prefixLen, flags };
+        token.chunk = chunk;
+        endToken(d + delimLen);
+        return type;
+    }
+
+    TokenType readElement(char* s)
+    {
+        // the whole tag, '>' inside of attribute values doesn't end it
+        size_t offset = 1;
+        char quote = 0;
+        for (;;) {
+            char* c = s + offset;
+            for (; c < end; ++c) {
+                if (quote) {
+                    if (*c == quote) {
+                        quote = 0;
+                    }
+                } else if (*c == '"' || *c == '\'') {
+                    quote = *c;
+                } else if (*c == '>') {
+                    break;
+                }
+            }
+            offset = c - s;
+            if (c < end) {
+                break;
+            }
+            if (!fill(s)) {
+                return error(PrematureEndOfDocumentError, u"unexpected end of document in a tag");
+            }
+        }
+
+        char* gt = s + offset;
+        char* p = s + 1;
+        token.chunk = chunk;
+
+        auto readName = [this, &p, gt]() {
+            char* n = p;
+            if (p < gt && isNameStartChar(*p)) {
+                ++p;
+                while (p < gt && isNameChar(*p)) {
+                    ++p;
+                }
+            }
+            return p > n ? names.intern(n, p - n) : AsciiStringView();
+        };
+
+        auto skipWhiteSpace = [&p, gt]() {
+            while (p < gt && isWhiteSpace(*p)) {
+                ++p;
+            }
+        };
+
+        if (*p == '/') {
+            ++p;
+            AsciiStringView name = readName();
+            skipWhiteSpace();
+            if (name.empty() || p != gt) {
+                return error(NotWellFormedError, u"invalid end tag");
+            }
+            if (stack.empty() || stack.back().name.ascii() != name.ascii()) {
+                return error(NotWellFormedError, String(u"mismatched end tag </%1>").arg(String::fromAscii(name.ascii())));
+            }
+
+            stack.pop_back();
+            token.type = EndElement;
+            token.name = name;
+            endToken(gt + 1);
+            return token.type;
+        }
+
+        AsciiStringView name = readName();
+        if (name.empty()) {
+            return error(NotWellFormedError, u"invalid element name");
+        }
+
+        bool empty = false;
+        for (;;) {
+            skipWhiteSpace();
+            if (p == gt) {
+                break;
+            }
+            if (*p == '/' && p + 1 == gt) {
+                empty = true;
+                break;
+            }
+
+            AsciiStringView attrName = readName();
+            if (attrName.empty()) {
+                return error(NotWellFormedError, String(u"invalid attribute in element <%1>").arg(String::fromAscii(name.ascii())));
+            }
+            skipWhiteSpace();
+            if (p == gt || *p != '=') {
+                return error(NotWellFormedError, String(u"expected = after attribute %1").arg(String::fromAscii(attrName.ascii())));
+            }
+            ++p;
+            skipWhiteSpace();
+            if (p == gt || (*p != '"' && *p != '\'')) {
+                return error(NotWellFormedError, String(u"expected quoted value of attribute %1").arg(String::fromAscii(attrName.ascii())));
+            }
+
+            const char q = *p++;
+            char* value = p;
+            while (*p != q) {   // the closing quote is before gt, see above
+                ++p;
+            }
+            *p++ = '\0';
+
+            if (token.attribute(attrName.ascii())) {
+                return error(NotWellFormedError, String(u"duplicate attribute %1").arg(String::fromAscii(attrName.ascii())));
+            }
+            token.attributes.push_back({ attrName, { value, static_cast<size_t>(p - 1 - value), DECODE_NEWLINES | DECODE_ENTITIES } });
+        }
+
+        token.type = StartElement;
+        token.name = name;
+        stack.push_back({ name, chunk });
+        pendingEndElement = empty;
+        endToken(gt + 1);
+        return token.type;
+    }
 };
 
 XmlStreamReader::XmlStreamReader()
@@ -46,8 +753,7 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+    m_xml->device = device;
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -60,8 +766,8 @@ XmlStreamReader::XmlStreamReader(const ByteArray& data)
 XmlStreamReader::XmlStreamReader(const QByteArray& data)
 {
     m_xml = new Xml();
-    ByteArray ba = ByteArray::fromQByteArrayNoCopy(data);
-    setData(ba);
+    // copied, the reader may outlive the given data
+    setData(ByteArray(data.constData(), data.size()));
 }
 
 #endif
@@ -73,14 +779,9 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
-    m_xml->customErr.clear();
-
-    if (m_xml->err != XML_SUCCESS) {
-        LOGE() << errorString();
-    }
+    m_xml->reset();
+    m_xml->data = data;
+    m_token = TokenType::NoToken;
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -100,75 +801,20 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_token == TokenType::EndDocument) {
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
-    }
-
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
-
-    m_xml->node = p.first;
-    m_token = p.second;
+    m_token = m_xml->next();
 
-    if (m_token == XmlStreamReader::TokenType::DTD) {
+    if (m_token == TokenType::DTD) {
         tryParseEntity(m_xml);
     }
 
@@ -179,9 +825,9 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
-    if (std::strncmp(str, ENTITY, 6) == 0) {
-        String val = String::fromUtf8(str);
+    AsciiStringView str = xml->token.text.view();
+    if (str.size() >= 6 && std::strncmp(str.ascii(), ENTITY, 6) == 0) {
+        String val = String::fromUtf8(str.ascii());
         StringList list = val.split(' ');
         if (list.size() == 3) {
             String name = list.at(1);
@@ -195,7 +841,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->token.text.view().ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -245,7 +891,7 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return (m_token == TokenType::StartElement || m_token == TokenType::EndElement) ? m_xml->token.name : AsciiStringView();
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -254,24 +900,12 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
-    }
-    return e->FindAttribute(name) != nullptr;
+    return m_xml->token.attribute(name) != nullptr;
 }
 
 String XmlStreamReader::attribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return String();
-    }
-
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return String();
-    }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(asciiAttribute(name).ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -285,11 +919,11 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    RawAttribute* a = m_xml->token.attribute(name);
+    if (!a) {
         return AsciiStringView();
     }
-    return e->Attribute(name);
+    return a->value.view();
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -324,15 +958,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->token.attributes.size());
+    for (RawAttribute& ra : m_xml->token.attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = ra.name;
+        a.value = String::fromUtf8(ra.value.view().ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -340,7 +970,7 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -348,8 +978,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->token.text.view();
     }
     return AsciiStringView();
 }
@@ -365,10 +995,8 @@ String XmlStreamReader::readText()
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
+            case Invalid:
+                return result;
             default:
                 break;
             }
@@ -384,14 +1012,13 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->token.text.view();
+                m_xml->lastText = m_xml->token.chunk;
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
+            case Invalid:
+                return result;
             default:
                 break;
             }
@@ -414,12 +1041,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->err != NoError ? m_xml->errLine : m_xml->token.line;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->err != NoError ? m_xml->errColumn : m_xml->token.column;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -428,12 +1055,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -446,7 +1068,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->errString;
 }
 
 void XmlStreamReader::raiseError(const String& message)
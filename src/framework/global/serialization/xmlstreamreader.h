@@ -35,6 +35,12 @@
 #endif
 
 namespace mu {
+//! NOTE Pull parser, the input is tokenized chunk by chunk, without building a document tree.
+//! Returned views have limited lifetimes:
+//! name() - valid for the lifetime of the reader (names are interned)
+//! asciiAttribute() - valid until the end of the element the attribute belongs to
+//! asciiText() - valid until the next token is read
+//! readAsciiText() - valid until the next call of readAsciiText()
 class XmlStreamReader
 {
 public:
@@ -21,22 +21,180 @@
  */
 #include "xmlstreamwriter.h"
 
-#include "containers.h"
-#include "textstream.h"
+#include <charconv>
+#include <cstring>
+#ifndef __cpp_lib_to_chars
+#include <locale>
+#include <sstream>
+#endif
 
 #include "log.h"
 
 using namespace mu;
 
+//! NOTE The output is formatted straight into a UTF-8 buffer,
+//! which is written to the device in chunks (and when the document is complete)
+static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
 struct XmlStreamWriter::Impl {
-    std::list<std::string> stack;
-    TextStream stream;
+    io::IODevice* device = nullptr;
+    std::string buf;
+    std::vector<std::string> stack;
+    std::string indent;
+
+    void flush()
+    {
+        if (device && device->isOpen() && !buf.empty()) {
+            device->write(reinterpret_cast<const uint8_t*>(buf.data()), buf.size());
+            buf.clear();
+        }
+    }
+
+    //! NOTE Everything written is in the device when a top-level element is complete
+    void written()
+    {
+        if (stack.empty() || buf.size() >= CHUNK_SIZE) {
+            flush();
+        }
+    }
 
     void putLevel()
     {
-        size_t level = stack.size();
-        for (size_t i = 0; i < level * 2; ++i) {
-            stream << ' ';
+        const size_t len = stack.size() * 2;
+        if (indent.size() < len) {
+            indent.resize(len * 2, ' ');
+        }
+        buf.append(indent.data(), len);
+    }
+
+    void put(char c)
+    {
+        buf.push_back(c);
+    }
+
+    void put(const char* s)
+    {
+        buf.append(s);
+    }
+
+    void put(const AsciiStringView& s)
+    {
+        buf.append(s.ascii(), s.size());
+    }
+
+    template<typename T>
+    void putNumber(T v)
+    {
+        char tmp[24];
+        std::to_chars_result r = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        buf.append(tmp, r.ptr);
+    }
+
+    //! NOTE As written by std::ostream, that is printf("%g")
+    void putNumber(double v)
+    {
+#ifdef __cpp_lib_to_chars
+        char tmp[32];
+        std::to_chars_result r = std::to_chars(tmp, tmp + sizeof(tmp), v, std::chars_format::general, 6);
+        buf.append(tmp, r.ptr);
+#else
+        std::ostringstream ss;
+        ss.imbue(std::locale::classic());
+        ss << v;
+        buf.append(ss.str());
+#endif
+    }
+
+    static bool isInvalidXmlChar(char16_t c)
+    {
+        // ignore invalid characters in xml 1.0
+        return c < 0x0020 && c != 0x0009 && c != 0x000A && c != 0x000D;
+    }
+
+    bool putEscaped(char16_t c)
+    {
+        switch (c) {
+        case u'<': buf.append("&lt;");
+            return true;
+        case u'>': buf.append("&gt;");
+            return true;
+        case u'&': buf.append("&amp;");
+            return true;
+        case u'\"': buf.append("&quot;");
+            return true;
+        default:
+            return isInvalidXmlChar(c);
+        }
+    }
+
+    //! NOTE UTF-8 (or ASCII) text, multibyte sequences are copied as they are
+    void putText(const char* s, size_t len, bool escape)
+    {
+        if (!escape) {
+            buf.append(s, len);
+            return;
+        }
+
+        for (size_t i = 0; i < len; ++i) {
+            const char c = s[i];
+            if (static_cast<unsigned char>(c) >= 0x80 || !putEscaped(static_cast<char16_t>(c))) {
+                buf.push_back(c);
+            }
+        }
+    }
+
+    void putText(const char16_t* s, size_t len, bool escape)
+    {
+        for (size_t i = 0; i < len; ++i) {
+            const char16_t c = s[i];
+            if (c < 0x80) {
+                if (!escape || !putEscaped(c)) {
+                    buf.push_back(static_cast<char>(c));
+                }
+            } else if (c < 0x800) {
+                buf.push_back(static_cast<char>(0xC0 | (c >> 6)));
+                buf.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            } else if (c < 0xD800 || c >= 0xE000) {
+                buf.push_back(static_cast<char>(0xE0 | (c >> 12)));
+                buf.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                buf.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            } else if (c < 0xDC00 && i + 1 < len && s[i + 1] >= 0xDC00 && s[i + 1] < 0xE000) {
+                const char32_t cp = 0x10000 + ((char32_t(c) - 0xD800) << 10) + (char32_t(s[i + 1]) - 0xDC00);
+                buf.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                buf.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                buf.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                buf.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                ++i;
+            } else {
+                // as String::toUtf8, the rest of a string with a broken surrogate pair is lost
+                LOGE() << "invalid utf-16, lone surrogate";
+                return;
+            }
+        }
+    }
+
+    void putText(const String& s, bool escape)
+    {
+        const std::u16string_view str = s.view();
+        putText(str.data(), str.size(), escape);
+    }
+
+    //! NOTE The name is the part before the attributes
+    static size_t nameLength(const String& nameWithAttributes)
+    {
+        const std::u16string_view str = nameWithAttributes.view();
+        const size_t space = str.find(u' ');
+        return space == std::u16string_view::npos ? str.size() : space;
+    }
+
+    void putAttributes(const Attributes& attrs, XmlStreamWriter* writer)
+    {
+        for (const Attribute& a : attrs) {
+            put(' ');
+            put(a.first);
+            buf.append("=\"");
+            writer->writeValue(a.second);
+            put('\"');
         }
     }
 };
@@ -49,7 +207,7 @@ XmlStreamWriter::XmlStreamWriter()
 XmlStreamWriter::XmlStreamWriter(io::IODevice* dev)
 {
     m_impl = new Impl();
-    m_impl->stream.setDevice(dev);
+    m_impl->device = dev;
 }
 
 XmlStreamWriter::~XmlStreamWriter()
@@ -60,22 +218,26 @@ XmlStreamWriter::~XmlStreamWriter()
 
 void XmlStreamWriter::setDevice(io::IODevice* dev)
 {
-    m_impl->stream.setDevice(dev);
+    m_impl->device = dev;
 }
 
 void XmlStreamWriter::flush()
 {
-    m_impl->stream.flush();
+    m_impl->flush();
 }
 
 void XmlStreamWriter::startDocument()
 {
-    m_impl->stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    m_impl->put("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    m_impl->written();
 }
 
 void XmlStreamWriter::writeDoctype(const String& type)
 {
-    m_impl->stream << "<!DOCTYPE " << type << '>' << '\n';
+    m_impl->put("<!DOCTYPE ");
+    m_impl->putText(type, false);
+    m_impl->put(">\n");
+    m_impl->written();
 }
 
 String XmlStreamWriter::escapeSymbol(char16_t c)
@@ -100,25 +262,29 @@ void XmlStreamWriter::writeValue(const Value& v)
     switch (v.index()) {
     case 0:
         break;
-    case 1: m_impl->stream << std::get<int>(v);
-        break;
-    case 2: m_impl->stream << std::get<unsigned int>(v);
+    case 1: m_impl->putNumber(std::get<int>(v));
         break;
-    case 3: m_impl->stream << std::get<signed long int>(v);
+    case 2: m_impl->putNumber(std::get<unsigned int>(v));
         break;
-    case 4: m_impl->stream << std::get<unsigned long int>(v);
+    case 3: m_impl->putNumber(std::get<signed long int>(v));
         break;
-    case 5: m_impl->stream << std::get<signed long long>(v);
+    case 4: m_impl->putNumber(std::get<unsigned long int>(v));
         break;
-    case 6: m_impl->stream << std::get<unsigned long long>(v);
+    case 5: m_impl->putNumber(std::get<signed long long>(v));
         break;
-    case 7: m_impl->stream << std::get<double>(v);
+    case 6: m_impl->putNumber(std::get<unsigned long long>(v));
         break;
-    case 8: m_impl->stream << escapeString(AsciiStringView(std::get<const char*>(v)));
+    case 7: m_impl->putNumber(std::get<double>(v));
         break;
-    case 9: m_impl->stream << escapeString(std::get<AsciiStringView>(v));
-        break;
-    case 10: m_impl->stream << escapeString(std::get<String>(v));
+    case 8: {
+        const char* s = std::get<const char*>(v);
+        m_impl->putText(s, s ? std::strlen(s) : 0, true);
+    } break;
+    case 9: {
+        const AsciiStringView& s = std::get<AsciiStringView>(v);
+        m_impl->putText(s.ascii(), s.size(), true);
+    } break;
+    case 10: m_impl->putText(std::get<String>(v), true);
         break;
     default:
         LOGI() << "index: " << v.index();
@@ -133,14 +299,12 @@ void XmlStreamWriter::startElement(const AsciiStringView& name, const Attributes
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << '>' << '\n';
-    m_impl->stack.push_back(name.ascii());
+    m_impl->put('<');
+    m_impl->put(name);
+    m_impl->putAttributes(attrs, this);
+    m_impl->put(">\n");
+    m_impl->stack.emplace_back(name.ascii(), name.size());
+    m_impl->written();
 }
 
 void XmlStreamWriter::startElement(const String& name, const Attributes& attrs)
@@ -152,15 +316,30 @@ void XmlStreamWriter::startElement(const String& name, const Attributes& attrs)
 void XmlStreamWriter::startElementRaw(const String& name)
 {
     m_impl->putLevel();
-    m_impl->stream << '<' << name << '>' << '\n';
-    m_impl->stack.push_back(name.split(' ')[0].toStdString());
+    m_impl->put('<');
+    m_impl->putText(name, false);
+    m_impl->put(">\n");
+
+    // the name is ascii
+    const std::u16string_view str = name.view();
+    m_impl->stack.emplace_back(str.begin(), str.begin() + Impl::nameLength(name));
+    m_impl->written();
 }
 
 void XmlStreamWriter::endElement()
 {
+    IF_ASSERT_FAILED(!m_impl->stack.empty()) {
+        return;
+    }
+
+    // indented as the content, as in existing files
     m_impl->putLevel();
-    m_impl->stream << "</" << mu::takeLast(m_impl->stack) << '>' << '\n';
-    flush();
+    m_impl->put("</");
+    m_impl->buf.append(m_impl->stack.back());
+    m_impl->put(">\n");
+
+    m_impl->stack.pop_back();
+    m_impl->written();
 }
 
 // <element attr="value" />
@@ -170,13 +349,11 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& att
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << "/>\n";
+    m_impl->put('<');
+    m_impl->put(name);
+    m_impl->putAttributes(attrs, this);
+    m_impl->put("/>\n");
+    m_impl->written();
 }
 
 void XmlStreamWriter::element(const AsciiStringView& name, const Value& body)
@@ -185,9 +362,14 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Value& body)
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name << '>';
+    m_impl->put('<');
+    m_impl->put(name);
+    m_impl->put('>');
     writeValue(body);
-    m_impl->stream << "</" << name << '>' << '\n';
+    m_impl->put("</");
+    m_impl->put(name);
+    m_impl->put(">\n");
+    m_impl->written();
 }
 
 void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& attrs, const Value& body)
@@ -196,45 +378,56 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& att
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << ">";
+    m_impl->put('<');
+    m_impl->put(name);
+    m_impl->putAttributes(attrs, this);
+    m_impl->put('>');
     writeValue(body);
-    m_impl->stream << "</" << name << '>' << '\n';
+    m_impl->put("</");
+    m_impl->put(name);
+    m_impl->put(">\n");
+    m_impl->written();
 }
 
 void XmlStreamWriter::elementRaw(const String& nameWithAttributes, const Value& body)
 {
     m_impl->putLevel();
+    m_impl->put('<');
+    m_impl->putText(nameWithAttributes, false);
     if (body.index() == 0) {
-        m_impl->stream << '<' << nameWithAttributes << "/>\n";
+        m_impl->put("/>\n");
     } else {
-        String ename(String(nameWithAttributes).split(' ')[0]);
-        m_impl->stream << '<' << nameWithAttributes << '>';
+        m_impl->put('>');
         writeValue(body);
-        m_impl->stream << "</" << ename << '>' << '\n';
+        m_impl->put("</");
+        m_impl->putText(nameWithAttributes.view().data(), Impl::nameLength(nameWithAttributes), false);
+        m_impl->put(">\n");
     }
+    m_impl->written();
 }
 
 void XmlStreamWriter::elementStringRaw(const String& nameWithAttributes, const String& body)
 {
     m_impl->putLevel();
+    m_impl->put('<');
+    m_impl->putText(nameWithAttributes, false);
     if (body.isEmpty()) {
-        m_impl->stream << '<' << nameWithAttributes << "/>\n";
+        m_impl->put("/>\n");
     } else {
-        String ename(String(nameWithAttributes).split(' ')[0]);
-        m_impl->stream << '<' << nameWithAttributes << '>';
-        m_impl->stream << body;
-        m_impl->stream << "</" << ename << '>' << '\n';
+        m_impl->put('>');
+        m_impl->putText(body, false);
+        m_impl->put("</");
+        m_impl->putText(nameWithAttributes.view().data(), Impl::nameLength(nameWithAttributes), false);
+        m_impl->put(">\n");
     }
+    m_impl->written();
 }
 
 void XmlStreamWriter::comment(const String& text)
 {
     m_impl->putLevel();
-    m_impl->stream << "<!-- " << text << " -->\n";
+    m_impl->put("<!-- ");
+    m_impl->putText(text, false);
+    m_impl->put(" -->\n");
+    m_impl->written();
 }
@@ -29,7 +29,6 @@
 #include "io/iodevice.h"
 
 namespace mu {
-class TextStream;
 class XmlStreamWriter
 {
 public:
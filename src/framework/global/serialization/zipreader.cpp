@@ -23,6 +23,7 @@
 
 #include "internal/zipcontainer.h"
 #include "io/file.h"
+#include "io/mappedfile.h"
 
 using namespace mu;
 using namespace mu::io;
@@ -38,9 +39,13 @@ ZipReader::ZipReader(const io::path_t& filePath)
     : m_filePath(filePath)
 {
     m_impl = new Impl();
-    m_impl->device = new File(filePath);
+    m_impl->device = new MappedFile(filePath);
     m_impl->isSelfDevice = true;
-    if (m_impl->device->open(IODevice::ReadOnly)) {
+    if (!m_impl->device->open(IODevice::ReadOnly)) {
+        //! NOTE Could not be mapped, read it through the file system
+        delete m_impl->device;
+        m_impl->device = new File(filePath);
+        m_impl->device->open(IODevice::ReadOnly);
     }
     m_impl->zip = new ZipContainer(m_impl->device);
 }
@@ -105,3 +110,8 @@ ByteArray ZipReader::fileData(const std::string& fileName) const
 {
     return m_impl->zip->fileData(fileName);
 }
+
+std::unique_ptr<IODevice> ZipReader::openFile(const std::string& fileName) const
+{
+    return m_impl->zip->openFile(fileName);
+}
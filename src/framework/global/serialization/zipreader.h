@@ -22,6 +22,7 @@
 #ifndef MU_GLOBAL_ZIPREADER_H
 #define MU_GLOBAL_ZIPREADER_H
 
+#include <memory>
 #include <vector>
 
 #include "io/path.h"
@@ -55,6 +56,9 @@ public:
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
 
+    //! NOTE Reads the file as it is inflated, without holding all of it in memory
+    std::unique_ptr<io::IODevice> openFile(const std::string& fileName) const;
+
 private:
     struct Impl;
     Impl* m_impl = nullptr;
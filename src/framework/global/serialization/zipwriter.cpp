@@ -94,3 +94,8 @@ void ZipWriter::addFile(const std::string& fileName, const ByteArray& data)
     m_impl->zip->addFile(fileName, data);
     flush();
 }
+
+std::unique_ptr<io::IODevice> ZipWriter::openFile(const std::string& fileName)
+{
+    return m_impl->zip->openFileForWriting(fileName);
+}
@@ -22,6 +22,8 @@
 #ifndef MU_GLOBAL_ZIPWRITER_H
 #define MU_GLOBAL_ZIPWRITER_H
 
+#include <memory>
+
 #include "io/path.h"
 #include "io/iodevice.h"
 
@@ -39,6 +41,10 @@ public:
 
     void addFile(const std::string& fileName, const ByteArray& data);
 
+    //! NOTE The file is written (and compressed) as the data comes,
+    //! it's finished when the device is closed or another file is added
+    std::unique_ptr<io::IODevice> openFile(const std::string& fileName);
+
 private:
 
     void flush();
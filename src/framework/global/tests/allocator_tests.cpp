@@ -21,6 +21,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <map>
+
 #include "allocator.h"
 
 #include "log.h"
@@ -196,3 +198,81 @@ TEST_F(Global_AllocatorTests, Many_NewCleanup)
     EXPECT_EQ(info.totalChunks, 12); // DEFAULT_BLOCK_SIZE * 3
     EXPECT_EQ(info.freeChunks, 12);
 }
+
+TEST_F(Global_AllocatorTests, Arena_AllocReset)
+{
+    //! GIVEN An arena with small blocks
+    ArenaAllocator arena(256);
+
+    //! DO Allocate more than one block
+    std::vector<uint64_t*> values;
+    for (uint64_t i = 0; i < 100; ++i) {
+        uint64_t* v = static_cast<uint64_t*>(arena.alloc(sizeof(uint64_t), alignof(uint64_t)));
+        *v = i;
+        values.push_back(v);
+    }
+
+    //! CHECK Values are not overwritten
+    for (uint64_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(*values.at(i), i);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(values.at(i)) % alignof(uint64_t), 0);
+    }
+
+    ArenaAllocator::Info info = arena.stateInfo();
+    EXPECT_EQ(info.totalAllocatedCount, 100);
+    EXPECT_EQ(info.usedBytes >= 800, true);
+    size_t blockCount = info.blockCount;
+    EXPECT_EQ(info.totalBlockCount, blockCount);
+
+    //! DO Reset and allocate the same again
+    arena.reset();
+    EXPECT_EQ(arena.stateInfo().usedBytes, 0);
+    for (uint64_t i = 0; i < 100; ++i) {
+        arena.alloc(sizeof(uint64_t), alignof(uint64_t));
+    }
+
+    //! CHECK No new blocks were needed
+    info = arena.stateInfo();
+    EXPECT_EQ(info.blockCount, blockCount);
+    EXPECT_EQ(info.totalBlockCount, blockCount);
+}
+
+TEST_F(Global_AllocatorTests, Arena_Containers)
+{
+    ArenaAllocator arena(1024);
+
+    {
+        //! DO Grow a vector and a map in a scope
+        ArenaAllocator::Scope scope(arena);
+
+        std::vector<int, ArenaStlAllocator<int> > v(arena);
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+
+        std::map<int, double, std::less<int>, ArenaStlAllocator<std::pair<const int, double> > > m(arena);
+        for (int i = 0; i < 100; ++i) {
+            m[i] = i * 0.5;
+        }
+
+        //! CHECK
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(v.at(i), i);
+        }
+        EXPECT_EQ(m.size(), 100);
+        EXPECT_EQ(m.at(99), 49.5);
+
+        //! CHECK A large allocation gets its own block
+        void* large = arena.alloc(4096);
+        EXPECT_TRUE(large);
+    }
+
+    //! CHECK Everything is given back when the scope ends
+    EXPECT_EQ(arena.stateInfo().usedBytes, 0);
+
+    //! CHECK The last allocation is given back right away
+    void* p = arena.alloc(16);
+    arena.free(p, 16);
+    EXPECT_EQ(arena.stateInfo().usedBytes, 0);
+    EXPECT_EQ(arena.stateInfo().totalFreeCount >= 1, true);
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "io/file.h"
+#include "io/mappedfile.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_IO_MappedFileTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(size_t size)
+{
+    ByteArray data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data.data()[i] = static_cast<uint8_t>(i % 251);
+    }
+    return data;
+}
+
+TEST_F(Global_IO_MappedFileTests, MapAndRead)
+{
+    //! GIVEN Some file
+    path_t filePath("Global_IO_MappedFileTests_MapAndRead.bin");
+    ByteArray ref = makeData(100000);
+    ASSERT_TRUE(File::writeFile(filePath, ref));
+
+    {
+        //! DO Map it
+        MappedFile f(filePath);
+        ASSERT_TRUE(f.open(IODevice::ReadOnly));
+
+        //! CHECK The whole file is in memory
+        EXPECT_EQ(f.size(), ref.size());
+        ASSERT_TRUE(f.readData());
+        EXPECT_EQ(std::memcmp(f.readData(), ref.constData(), ref.size()), 0);
+
+        //! CHECK Reading copies from the mapping
+        EXPECT_EQ(f.read(1000), ByteArray(ref.constData(), 1000));
+        f.seek(99000);
+        EXPECT_EQ(f.readAll(), ByteArray(ref.constData() + 99000, 1000));
+        EXPECT_TRUE(f.read(1).empty());
+
+        //! DO Close it
+        f.close();
+
+        //! CHECK
+        EXPECT_FALSE(f.isOpen());
+    }
+
+    File::remove(filePath);
+}
+
+TEST_F(Global_IO_MappedFileTests, ReadOnly)
+{
+    //! GIVEN Some file
+    path_t filePath("Global_IO_MappedFileTests_ReadOnly.bin");
+    ASSERT_TRUE(File::writeFile(filePath, makeData(100)));
+
+    //! DO Open it for writing
+    MappedFile f(filePath);
+
+    //! CHECK It can't be
+    EXPECT_FALSE(f.open(IODevice::WriteOnly));
+    EXPECT_FALSE(f.isOpen());
+
+    File::remove(filePath);
+}
+
+TEST_F(Global_IO_MappedFileTests, TruncatedFile)
+{
+    //! GIVEN A file that was cut short
+    path_t filePath("Global_IO_MappedFileTests_TruncatedFile.bin");
+    ByteArray ref = makeData(100000);
+    ASSERT_TRUE(File::writeFile(filePath, ref));
+    ASSERT_TRUE(File::writeFile(filePath, ByteArray(ref.constData(), 10)));
+
+    //! DO Map it
+    MappedFile f(filePath);
+    ASSERT_TRUE(f.open(IODevice::ReadOnly));
+
+    //! CHECK Only what is left is mapped and read
+    EXPECT_EQ(f.size(), 10u);
+    EXPECT_EQ(f.readAll(), ByteArray(ref.constData(), 10));
+
+    f.close();
+
+    //! GIVEN The file is emptied
+    ASSERT_TRUE(File::writeFile(filePath, ByteArray()));
+
+    //! CHECK An empty file opens, there is nothing to map or read
+    ASSERT_TRUE(f.open(IODevice::ReadOnly));
+    EXPECT_EQ(f.size(), 0u);
+    EXPECT_TRUE(f.readAll().empty());
+
+    f.close();
+    File::remove(filePath);
+}
+
+TEST_F(Global_IO_MappedFileTests, MissingFile)
+{
+    //! GIVEN No file
+    path_t filePath("Global_IO_MappedFileTests_MissingFile.bin");
+    File::remove(filePath);
+
+    //! DO Map it
+    MappedFile f(filePath);
+
+    //! CHECK It fails with an error
+    EXPECT_FALSE(f.open(IODevice::ReadOnly));
+    EXPECT_FALSE(f.isOpen());
+    EXPECT_TRUE(f.hasError());
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "io/buffer.h"
+#include "serialization/xmlstreamreader.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+    //! NOTE Token types and names (or texts), in the form "type:value"
+    static std::vector<std::string> tokens(XmlStreamReader& xml)
+    {
+        std::vector<std::string> result;
+        while (!xml.atEnd()) {
+            XmlStreamReader::TokenType type = xml.readNext();
+            std::string value;
+            if (xml.isStartElement() || xml.isEndElement()) {
+                value = xml.name().ascii();
+            } else if (xml.isCharacters() || type == XmlStreamReader::Comment) {
+                value = xml.asciiText().ascii();
+            }
+            result.push_back(std::string(xml.tokenString().ascii()) + ":" + value);
+        }
+        return result;
+    }
+
+    static std::vector<std::string> tokens(const std::string& data)
+    {
+        XmlStreamReader xml(ByteArray(data.c_str(), data.size()));
+        return tokens(xml);
+    }
+};
+
+TEST_F(Global_Ser_XmlStreamReaderTests, TokenSequence)
+{
+    std::vector<std::string> expected = {
+        "StartDocument:", "StartElement:museScore", "StartElement:Score", "Comment: a comment ",
+        "StartElement:Staff", "EndElement:Staff", "StartElement:name", "Characters:Piano", "EndElement:name",
+        "EndElement:Score", "EndElement:museScore", "EndDocument:"
+    };
+
+    EXPECT_EQ(tokens("\xEF\xBB\xBF<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<museScore version=\"4.20\">\n"
+                     "  <Score>\n"
+                     "    <!-- a comment -->\n"
+                     "    <Staff id=\"1\"/>\n"
+                     "    <name>Piano</name>\n"
+                     "    </Score>\n"
+                     "  </museScore>\n"), expected);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Attributes)
+{
+    XmlStreamReader xml(ByteArray("<Note pitch=\"60\" tpc='14' velo=\"-0.5\" text=\"a&amp;b &lt;c&gt; &#x263A;\"/>"));
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "Note");
+    EXPECT_TRUE(xml.hasAttribute("pitch"));
+    EXPECT_FALSE(xml.hasAttribute("track"));
+    EXPECT_EQ(xml.intAttribute("pitch"), 60);
+    EXPECT_EQ(xml.intAttribute("tpc"), 14);
+    EXPECT_EQ(xml.intAttribute("track", 3), 3);
+    EXPECT_DOUBLE_EQ(xml.doubleAttribute("velo"), -0.5);
+    EXPECT_EQ(xml.attribute("text"), String(u"a&b <c> ☺"));
+    EXPECT_EQ(xml.attributes().size(), 4);
+
+    // [THEN] An attribute value is valid until the end of its element
+    AsciiStringView pitch = xml.asciiAttribute("pitch");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(pitch, "60");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Text)
+{
+    XmlStreamReader xml(ByteArray("<a>\r\n  <b>x &amp; y\r\nz &unknown; &#65;</b><c><![CDATA[<not> &amp; markup]]></c>"
+                                  "<d>  12 </d><e/></a>"));
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), String(u"x & y\nz &unknown; A"));
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readAsciiText(), "<not> &amp; markup");
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readInt(), 12);
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), String());
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "a");
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, SkipCurrentElement)
+{
+    XmlStreamReader xml(ByteArray("<a><b><c>1</c><c/></b><d>2</d></a>"));
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    xml.skipCurrentElement();
+    EXPECT_TRUE(xml.isEndElement());
+    EXPECT_EQ(xml.name(), "b");
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "d");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Errors)
+{
+    for (const char* data : { "", "<a><b></a>", "<a>", "<a x=\"1\" x=\"2\"/>", "<a></a></b>", "<a x=1/>" }) {
+        XmlStreamReader xml(ByteArray(data, std::strlen(data)));
+        tokens(xml);
+        EXPECT_TRUE(xml.isError()) << data;
+        EXPECT_EQ(xml.tokenType(), XmlStreamReader::Invalid) << data;
+    }
+
+    XmlStreamReader xml(ByteArray("<a>\n<b>\n</c>"));
+    tokens(xml);
+    EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+    EXPECT_EQ(xml.lineNumber(), 3);
+
+    xml.raiseError(u"custom");
+    EXPECT_EQ(xml.error(), XmlStreamReader::CustomError);
+    EXPECT_EQ(xml.errorString(), u"custom");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, LineNumbers)
+{
+    XmlStreamReader xml(ByteArray("<a>\n  <b>\n    <c/>\n  </b>\n</a>\n"));
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 1);
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 2);
+    EXPECT_EQ(xml.columnNumber(), 3);
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 3);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, LargeDocumentFromDevice)
+{
+    // [GIVEN] A document much larger than the chunks it is read in
+    std::string data = "<?xml version=\"1.0\"?>\n<museScore>\n";
+    for (int i = 0; i < 20000; ++i) {
+        data += "  <Chord id=\"" + std::to_string(i) + "\"><!-- c --><durationType>quarter</durationType>"
+                "<Note><pitch>" + std::to_string(i % 128) + "</pitch></Note></Chord>\n";
+    }
+    data += "</museScore>\n";
+
+    // [WHEN] It's read from a device and from memory
+    Buffer buf(reinterpret_cast<const uint8_t*>(data.c_str()), data.size());
+    buf.open(IODevice::ReadOnly);
+    XmlStreamReader fromDevice(&buf);
+    std::vector<std::string> deviceTokens = tokens(fromDevice);
+
+    // [THEN] The tokens are the same and complete
+    EXPECT_FALSE(fromDevice.isError());
+    EXPECT_EQ(deviceTokens, tokens(data));
+    EXPECT_EQ(deviceTokens.size(), 20000 * 11 + 4);
+
+    // [THEN] Values read across chunk borders are intact
+    buf.seek(0);
+    XmlStreamReader xml(&buf);
+    int sum = 0;
+    int line = 0;
+    while (!xml.atEnd()) {
+        if (xml.readNext() == XmlStreamReader::StartElement && xml.name() == "pitch") {
+            line = static_cast<int>(xml.lineNumber());
+            sum += xml.readInt();
+        }
+    }
+    int expected = 0;
+    for (int i = 0; i < 20000; ++i) {
+        expected += i % 128;
+    }
+    EXPECT_EQ(sum, expected);
+    EXPECT_EQ(line, 20002);
+}
@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "io/buffer.h"
+#include "io/file.h"
+#include "io/mappedfile.h"
+#include "serialization/zipreader.h"
+#include "serialization/zipwriter.h"
+#include "serialization/internal/zipcontainer.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_ZipTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(size_t size)
+{
+    ByteArray data(size);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < size; ++i) {
+        seed = seed * 1103515245 + 12345;
+        data.data()[i] = static_cast<uint8_t>('a' + (seed >> 16) % 8);
+    }
+    return data;
+}
+
+static ByteArray part(const ByteArray& data, size_t pos, size_t len)
+{
+    return ByteArray(data.constData() + pos, std::min(len, data.size() - pos));
+}
+
+TEST_F(Global_Ser_ZipTests, StreamedEntries)
+{
+    //! GIVEN An archive with a file added at once and a file written in pieces
+    ByteArray whole = makeData(100000);
+    ByteArray streamed = makeData(300000);
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        ZipWriter writer(&buf);
+        writer.addFile("whole.txt", whole);
+
+        std::unique_ptr<IODevice> entry = writer.openFile("streamed.txt");
+        ASSERT_TRUE(entry);
+        for (size_t pos = 0; pos < streamed.size(); pos += 1000) {
+            ByteArray piece = part(streamed, pos, 1000);
+            EXPECT_EQ(entry->write(piece), piece.size());
+        }
+
+        //! NOTE Adding a file finishes the one being written
+        writer.addFile("last.txt", ByteArray("last"));
+        EXPECT_FALSE(writer.hasError());
+    }
+
+    //! DO Read the files at once
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+
+    //! CHECK
+    EXPECT_EQ(reader.fileData("whole.txt"), whole);
+    EXPECT_EQ(reader.fileData("streamed.txt"), streamed);
+    EXPECT_EQ(reader.fileData("last.txt"), ByteArray("last"));
+    EXPECT_FALSE(reader.hasError());
+
+    //! DO Read a file in pieces, seeking back and forth
+    std::unique_ptr<IODevice> entry = reader.openFile("streamed.txt");
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->size(), streamed.size());
+
+    //! CHECK
+    EXPECT_EQ(entry->read(1000), part(streamed, 0, 1000));
+    entry->seek(200000);
+    EXPECT_EQ(entry->read(1000), part(streamed, 200000, 1000));
+    entry->seek(500);
+    EXPECT_EQ(entry->read(1000), part(streamed, 500, 1000));
+    entry->seek(299500);
+    EXPECT_EQ(entry->readAll(), part(streamed, 299500, 1000));
+
+    EXPECT_FALSE(reader.openFile("missing.txt"));
+}
+
+TEST_F(Global_Ser_ZipTests, StoredEntries)
+{
+    //! GIVEN An archive in memory with stored (not compressed) files
+    ByteArray big = makeData(100000);
+    ByteArray small("small");
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        ZipContainer zip(&buf);
+        zip.setCompressionPolicy(ZipContainer::NeverCompress);
+        zip.addFile("big.txt", big);
+        zip.addFile("small.txt", small);
+        zip.close();
+    }
+
+    //! DO Open the files
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+    std::unique_ptr<IODevice> bigEntry = reader.openFile("big.txt");
+    std::unique_ptr<IODevice> smallEntry = reader.openFile("small.txt");
+    ASSERT_TRUE(bigEntry);
+    ASSERT_TRUE(smallEntry);
+
+    //! CHECK The data is served in place, from the archive itself
+    const uint8_t* bigData = bigEntry->readData();
+    ASSERT_TRUE(bigData);
+    EXPECT_GE(bigData, zipData.constData());
+    EXPECT_LE(bigData + big.size(), zipData.constData() + zipData.size());
+    EXPECT_EQ(std::memcmp(bigData, big.constData(), big.size()), 0);
+    EXPECT_EQ(bigEntry->size(), big.size());
+
+    const uint8_t* smallData = smallEntry->readData();
+    ASSERT_TRUE(smallData);
+    EXPECT_EQ(std::memcmp(smallData, small.constData(), small.size()), 0);
+
+    //! CHECK Reading copies the same data, at once and in pieces
+    EXPECT_EQ(reader.fileData("big.txt"), big);
+    EXPECT_EQ(reader.fileData("small.txt"), small);
+
+    EXPECT_EQ(bigEntry->read(1000), part(big, 0, 1000));
+    bigEntry->seek(50000);
+    EXPECT_EQ(bigEntry->read(1000), part(big, 50000, 1000));
+    bigEntry->seek(99500);
+    EXPECT_EQ(bigEntry->readAll(), part(big, 99500, 1000));
+    EXPECT_FALSE(reader.hasError());
+}
+
+TEST_F(Global_Ser_ZipTests, MappedArchive)
+{
+    //! GIVEN An archive file with a stored and a compressed file
+    path_t filePath("Global_Ser_ZipTests_MappedArchive.zip");
+    ByteArray stored("stored");
+    ByteArray deflated = makeData(100000);
+    {
+        //! NOTE Files under 64 bytes are stored
+        File file(filePath);
+        ASSERT_TRUE(file.open(IODevice::WriteOnly));
+        ZipContainer zip(&file);
+        zip.setCompressionPolicy(ZipContainer::AutoCompress);
+        zip.addFile("stored.txt", stored);
+        zip.addFile("deflated.txt", deflated);
+        zip.close();
+        file.close();
+    }
+
+    //! DO Read it by path
+    {
+        ZipReader reader(filePath);
+
+        //! CHECK
+        EXPECT_EQ(reader.fileData("stored.txt"), stored);
+        EXPECT_EQ(reader.fileData("deflated.txt"), deflated);
+        EXPECT_FALSE(reader.hasError());
+    }
+
+    //! DO Read it through a mapped file
+    {
+        MappedFile mapped(filePath);
+        ASSERT_TRUE(mapped.open(IODevice::ReadOnly));
+        const uint8_t* mappedData = mapped.readData();
+        const size_t mappedSize = mapped.size();
+        ASSERT_TRUE(mappedData);
+
+        ZipReader reader(&mapped);
+        std::unique_ptr<IODevice> entry = reader.openFile("stored.txt");
+        ASSERT_TRUE(entry);
+
+        //! CHECK The stored file is served in place, from the mapping
+        const uint8_t* entryData = entry->readData();
+        ASSERT_TRUE(entryData);
+        EXPECT_GE(entryData, mappedData);
+        EXPECT_LE(entryData + stored.size(), mappedData + mappedSize);
+        EXPECT_EQ(entry->size(), stored.size());
+        EXPECT_EQ(ByteArray(entryData, entry->size()), stored);
+
+        //! CHECK The compressed one is inflated
+        EXPECT_EQ(reader.fileData("deflated.txt"), deflated);
+        EXPECT_FALSE(reader.hasError());
+    }
+
+    //! GIVEN The archive is cut in the middle, so its central directory is lost
+    ByteArray data;
+    ASSERT_TRUE(File::readFile(filePath, data));
+    ASSERT_TRUE(File::writeFile(filePath, part(data, 0, data.size() / 2)));
+
+    //! DO Read it again
+    {
+        ZipReader reader(filePath);
+
+        //! CHECK Nothing is found, and nothing is read past the end of the mapping
+        EXPECT_TRUE(reader.fileData("stored.txt").empty());
+        EXPECT_TRUE(reader.fileData("deflated.txt").empty());
+        EXPECT_FALSE(reader.openFile("deflated.txt"));
+    }
+
+    File::remove(filePath);
+
+    //! CHECK A missing archive has no files
+    ZipReader reader(filePath);
+    EXPECT_FALSE(reader.exists());
+    EXPECT_TRUE(reader.fileData("stored.txt").empty());
+}
@@ -76,6 +76,7 @@ public:
 
     static void processEvents();
     static void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    static void onThreadInvoke(const std::function<void()>& f);
 
 protected:
     explicit AbstractInvoker();
@@ -168,6 +169,12 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     AbstractInvoker::onMainThreadInvoke(f);
 }
+
+//! NOTE f is called, on the invoking thread, when something is queued for the current thread
+inline void onThreadInvoke(const std::function<void()>& f)
+{
+    AbstractInvoker::onThreadInvoke(f);
+}
 }
 }
 
@@ -20,6 +20,7 @@ public:
     void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    void onThreadInvoke(const std::function<void()>& f);
 
 private:
 
@@ -32,6 +33,8 @@ private:
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
+
+    std::map<std::thread::id, std::function<void()> > m_onThreadInvoke;
 };
 }
 }
@@ -254,6 +254,8 @@ public:
     static String fromStdString(const std::string& str);
     std::string toStdString() const;
     std::u16string toStdU16String() const;
+    //! NOTE Valid while the string is alive and not changed
+    std::u16string_view view() const { return constStr(); }
 
     static String fromUcs4(const char32_t* str, size_t size = mu::nidx);
     static String fromUcs4(char32_t chr);
@@ -21,12 +21,16 @@
  */
 #include "abstractaudiowriter.h"
 
+#include <cmath>
+#include <set>
+
 #include <QApplication>
 #include <QFile>
 #include <QFileInfo>
 #include <QThread>
 
 #include "audio/iaudiooutput.h"
+#include "engraving/dom/part.h"
 
 #include "log.h"
 
@@ -86,16 +90,61 @@ mu::framework::Progress* AbstractAudioWriter::progress()
     return &m_progress;
 }
 
-mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& destinationDevice, const audio::SoundTrackFormat& format)
+static mu::io::path_t filePath(QIODevice& device)
 {
     //!Note Temporary workaround, since QIODevice is the alias for QIODevice, which falls with SIGSEGV
     //!     on any call from background thread. Once we have our own implementation of QIODevice
     //!     we can pass QIODevice directly into IPlayback::IAudioOutput::saveSoundTrack
-    QFile* file = qobject_cast<QFile*>(&destinationDevice);
+    QFile* file = qobject_cast<QFile*>(&device);
+    IF_ASSERT_FAILED(file) {
+        return mu::io::path_t();
+    }
 
     QFileInfo info(*file);
-    QString path = info.absoluteFilePath();
+    return mu::io::path_t(info.absoluteFilePath());
+}
+
+mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& destinationDevice, const audio::SoundTrackFormat& format)
+{
+    io::path_t path = filePath(destinationDevice);
+
+    return saveAndWait(notation, [this, path, format](const audio::TrackSequenceId sequenceId) {
+        return playback()->audioOutput()->saveSoundTrack(sequenceId, path, format);
+    });
+}
+
+mu::Ret AbstractAudioWriter::doWriteEachAndWait(const INotationPtrList& notations, const std::vector<QIODevice*>& devices,
+                                                const Options& options, const audio::SoundTrackFormat& format)
+{
+    IF_ASSERT_FAILED(notations.size() == devices.size()) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    if (notations.size() < 2) {
+        //! NOTE Nothing to share between the renders
+        return INotationWriter::writeEach(notations, devices, options);
+    }
+
+    IMasterNotationPtr masterNotation = globalContext()->currentMasterNotation();
+    if (!masterNotation) {
+        return INotationWriter::writeEach(notations, devices, options);
+    }
+
+    std::vector<io::path_t> paths;
+    for (QIODevice* device : devices) {
+        paths.push_back(filePath(*device));
+    }
+
+    //! NOTE The tracks of the excerpts are the tracks of the master parts,
+    //!      so playing back the master score is enough to get all of them
+    INotationPtr notation = masterNotation->notation();
+    return saveAndWait(notation, [this, notations, paths, notation, options, format](const audio::TrackSequenceId sequenceId) {
+        return playback()->audioOutput()->saveSoundTrackStems(sequenceId, makeStems(notations, paths, notation, options), format);
+    });
+}
 
+mu::Ret AbstractAudioWriter::saveAndWait(INotationPtr notation, const SaveSoundTrack& save)
+{
     m_isCompleted = false;
     m_writeRet = Ret();
 
@@ -108,7 +157,7 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
     });
 
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, save](const audio::TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
@@ -117,9 +166,9 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
                 m_progress.progressChanged.send(current, total, title);
             });
 
-            playback()->audioOutput()->saveSoundTrack(sequenceId, io::path_t(path), std::move(format))
-            .onResolve(this, [this, path](const bool /*result*/) {
-                LOGD() << "Successfully saved sound track by path: " << path;
+            save(sequenceId)
+            .onResolve(this, [this](const bool /*result*/) {
+                LOGD() << "Successfully saved sound track";
                 m_writeRet = make_ok();
                 m_isCompleted = true;
                 m_progress.finished.send(make_ok());
@@ -143,6 +192,65 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
     return m_writeRet;
 }
 
+mu::audio::SoundTrackStemList AbstractAudioWriter::makeStems(const INotationPtrList& notations, const std::vector<io::path_t>& paths,
+                                                             const INotationPtr& masterNotation, const Options& options) const
+{
+    audio::gain_t otherGain = otherPartsGain(options);
+    const playback::IPlaybackController::InstrumentTrackIdMap& trackIdMap = playbackController()->instrumentTrackIdMap();
+
+    audio::SoundTrackStemList stems;
+    stems.reserve(notations.size());
+
+    for (size_t i = 0; i < notations.size(); ++i) {
+        audio::SoundTrackStem stem;
+        stem.destination = paths[i];
+
+        //! NOTE The master score sounds as when it's played back, with the reverb and the master fx
+        if (notations[i] == masterNotation) {
+            stem.isMaster = true;
+            stems.push_back(std::move(stem));
+            continue;
+        }
+
+        std::set<ID> partIds;
+        for (const Part* part : notations[i]->parts()->partList()) {
+            partIds.insert(part->id());
+        }
+
+        stem.trackGains = stemTrackGains(partIds, trackIdMap, otherGain);
+        stems.push_back(std::move(stem));
+    }
+
+    return stems;
+}
+
+mu::audio::gain_t AbstractAudioWriter::otherPartsGain(const Options& options)
+{
+    //! NOTE The parts of the other notations are silent unless a volume (in dB) is given for them
+    Val otherPartsVolume = options.value(OptionKey::OTHER_PARTS_VOLUME, Val());
+    if (otherPartsVolume.isNull()) {
+        return 0.f;
+    }
+
+    return static_cast<audio::gain_t>(std::pow(10.0, otherPartsVolume.toDouble() / 20.0));
+}
+
+std::map<mu::audio::TrackId, mu::audio::gain_t> AbstractAudioWriter::stemTrackGains(
+    const std::set<ID>& partIds, const playback::IPlaybackController::InstrumentTrackIdMap& trackIdMap, audio::gain_t otherPartsGain)
+{
+    std::map<audio::TrackId, audio::gain_t> trackGains;
+
+    for (const auto& pair : trackIdMap) {
+        if (partIds.find(pair.first.partId) != partIds.cend()) {
+            trackGains[pair.second] = 1.f;
+        } else if (otherPartsGain > 0.f) {
+            trackGains[pair.second] = otherPartsGain;
+        }
+    }
+
+    return trackGains;
+}
+
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
 {
     std::vector<UnitType> supported = supportedUnitTypes();
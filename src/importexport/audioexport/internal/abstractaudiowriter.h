@@ -22,6 +22,10 @@
 #ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
 #define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
 
+#include <functional>
+#include <map>
+#include <set>
+
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
 #include "audio/iplayback.h"
@@ -52,9 +56,25 @@ public:
 protected:
     Ret doWriteAndWait(notation::INotationPtr notation, QIODevice& destinationDevice, const audio::SoundTrackFormat& format);
 
+    //! NOTE Renders the master score once and writes one file per notation:
+    //!      the master score gets the master output, each excerpt only its parts
+    Ret doWriteEachAndWait(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices, const Options& options,
+                           const audio::SoundTrackFormat& format);
+
+    static audio::gain_t otherPartsGain(const Options& options);
+    static std::map<audio::TrackId, audio::gain_t> stemTrackGains(const std::set<ID>& partIds,
+                                                                  const playback::IPlaybackController::InstrumentTrackIdMap& trackIdMap,
+                                                                  audio::gain_t otherPartsGain);
+
 private:
+    using SaveSoundTrack = std::function<async::Promise<bool>(const audio::TrackSequenceId)>;
+
     UnitType unitTypeFromOptions(const Options& options) const;
 
+    Ret saveAndWait(notation::INotationPtr notation, const SaveSoundTrack& save);
+    audio::SoundTrackStemList makeStems(const notation::INotationPtrList& notations, const std::vector<io::path_t>& paths,
+                                        const notation::INotationPtr& masterNotation, const Options& options) const;
+
     framework::Progress m_progress;
     bool m_isCompleted = false;
     Ret m_writeRet;
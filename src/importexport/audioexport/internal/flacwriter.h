@@ -30,6 +30,11 @@ class FlacWriter : public AbstractAudioWriter
 {
 public:
     Ret write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writeEach(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices,
+                  const Options& options = Options()) override;
+
+private:
+    audio::SoundTrackFormat format() const;
 };
 }
 
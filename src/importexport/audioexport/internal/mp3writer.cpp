@@ -29,12 +29,20 @@ using namespace mu::framework;
 
 mu::Ret Mp3Writer::write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options&)
 {
-    const audio::SoundTrackFormat format {
+    return doWriteAndWait(notation, destinationDevice, format());
+}
+
+mu::Ret Mp3Writer::writeEach(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices, const Options& options)
+{
+    return doWriteEachAndWait(notations, devices, options, format());
+}
+
+mu::audio::SoundTrackFormat Mp3Writer::format() const
+{
+    return {
         audio::SoundTrackType::MP3,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         configuration()->exportMp3Bitrate()
     };
-
-    return doWriteAndWait(notation, destinationDevice, format);
 }
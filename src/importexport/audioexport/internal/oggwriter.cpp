@@ -29,12 +29,20 @@ using namespace mu::io;
 
 mu::Ret OggWriter::write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options&)
 {
-    const audio::SoundTrackFormat format {
+    return doWriteAndWait(notation, destinationDevice, format());
+}
+
+mu::Ret OggWriter::writeEach(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices, const Options& options)
+{
+    return doWriteEachAndWait(notations, devices, options, format());
+}
+
+mu::audio::SoundTrackFormat OggWriter::format() const
+{
+    return {
         audio::SoundTrackType::OGG,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         128 /* bitRate */
     };
-
-    return doWriteAndWait(notation, destinationDevice, format);
 }
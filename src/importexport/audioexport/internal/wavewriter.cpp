@@ -29,12 +29,20 @@ using namespace mu::framework;
 
 mu::Ret WaveWriter::write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options&)
 {
-    const audio::SoundTrackFormat format {
+    return doWriteAndWait(notation, destinationDevice, format());
+}
+
+mu::Ret WaveWriter::writeEach(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices, const Options& options)
+{
+    return doWriteEachAndWait(notations, devices, options, format());
+}
+
+mu::audio::SoundTrackFormat WaveWriter::format() const
+{
+    return {
         audio::SoundTrackType::WAV,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         0 /* bitRate */
     };
-
-    return doWriteAndWait(notation, destinationDevice, format);
 }
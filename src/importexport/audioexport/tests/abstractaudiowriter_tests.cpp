@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+
+#include "importexport/audioexport/internal/abstractaudiowriter.h"
+
+#include "context/tests/mocks/globalcontextmock.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::notation;
+using namespace mu::project;
+
+namespace mu::iex::audioexport {
+class TestAudioWriter : public AbstractAudioWriter
+{
+public:
+    using AbstractAudioWriter::otherPartsGain;
+    using AbstractAudioWriter::stemTrackGains;
+
+    Ret write(INotationPtr notation, QIODevice&, const Options&) override
+    {
+        writtenNotations.push_back(notation);
+        return make_ok();
+    }
+
+    Ret writeEach(const INotationPtrList& notations, const std::vector<QIODevice*>& devices, const Options& options) override
+    {
+        return doWriteEachAndWait(notations, devices, options, audio::SoundTrackFormat());
+    }
+
+    INotationPtrList writtenNotations;
+};
+
+class AudioExport_AbstractAudioWriterTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_globalContext = std::make_shared<NiceMock<context::GlobalContextMock> >();
+        modularity::ioc()->registerExport<context::IGlobalContext>("utests", m_globalContext);
+    }
+
+    void TearDown() override
+    {
+        modularity::ioc()->unregister<context::IGlobalContext>("utests");
+    }
+
+    std::shared_ptr<NiceMock<context::GlobalContextMock> > m_globalContext;
+};
+}
+
+TEST_F(AudioExport_AbstractAudioWriterTests, OtherPartsGain)
+{
+    // [GIVEN] No volume for the other parts
+    INotationWriter::Options options;
+
+    // [THEN] They are silent
+    EXPECT_FLOAT_EQ(TestAudioWriter::otherPartsGain(options), 0.f);
+
+    // [WHEN] A volume in dB is given
+    // [THEN] It's converted to a gain
+    options[INotationWriter::OptionKey::OTHER_PARTS_VOLUME] = Val(0.0);
+    EXPECT_FLOAT_EQ(TestAudioWriter::otherPartsGain(options), 1.f);
+
+    options[INotationWriter::OptionKey::OTHER_PARTS_VOLUME] = Val(-20.0);
+    EXPECT_FLOAT_EQ(TestAudioWriter::otherPartsGain(options), 0.1f);
+}
+
+TEST_F(AudioExport_AbstractAudioWriterTests, StemTrackGains)
+{
+    // [GIVEN] Two parts, the first one with two instruments
+    playback::IPlaybackController::InstrumentTrackIdMap trackIdMap;
+    trackIdMap[{ ID(1), "piano" }] = 10;
+    trackIdMap[{ ID(1), "celesta" }] = 11;
+    trackIdMap[{ ID(2), "violin" }] = 20;
+
+    std::set<ID> partIds { ID(1) };
+
+    // [WHEN] The stem of the first part is made without the other parts
+    std::map<audio::TrackId, audio::gain_t> gains = TestAudioWriter::stemTrackGains(partIds, trackIdMap, 0.f);
+
+    // [THEN] It has the tracks of the part at full volume only
+    std::map<audio::TrackId, audio::gain_t> expected { { 10, 1.f }, { 11, 1.f } };
+    EXPECT_EQ(gains, expected);
+
+    // [WHEN] The other parts are kept at a lower volume
+    gains = TestAudioWriter::stemTrackGains(partIds, trackIdMap, 0.5f);
+
+    // [THEN] Their tracks are mixed in with that gain
+    expected[20] = 0.5f;
+    EXPECT_EQ(gains, expected);
+}
+
+TEST_F(AudioExport_AbstractAudioWriterTests, WriteEachFallback_OneNotation)
+{
+    // [GIVEN] A single notation
+    TestAudioWriter writer;
+    QBuffer device;
+    INotationPtrList notations { nullptr };
+
+    // [THEN] There is nothing to share, so it's written on its own, without looking for the master score
+    EXPECT_CALL(*m_globalContext, currentMasterNotation()).Times(0);
+
+    // [WHEN] It's written
+    Ret ret = writer.writeEach(notations, { &device }, {});
+
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(writer.writtenNotations, notations);
+}
+
+TEST_F(AudioExport_AbstractAudioWriterTests, WriteEachFallback_NoMasterNotation)
+{
+    // [GIVEN] Several notations, but no open master score to play back
+    TestAudioWriter writer;
+    QBuffer device1;
+    QBuffer device2;
+    INotationPtrList notations { nullptr, nullptr };
+
+    EXPECT_CALL(*m_globalContext, currentMasterNotation())
+    .WillOnce(Return(nullptr));
+
+    // [WHEN] They are written
+    Ret ret = writer.writeEach(notations, { &device1, &device2 }, {});
+
+    // [THEN] Each one is written on its own
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(writer.writtenNotations.size(), notations.size());
+}
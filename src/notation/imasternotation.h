@@ -51,6 +51,9 @@ public:
     virtual const ExcerptNotationList& potentialExcerpts() const = 0;
 
     virtual void initExcerpts(const ExcerptNotationList& excerpts) = 0;
+    //! NOTE Parts that were not open are read in the background after opening the score,
+    //! this reads the given ones now if they are not read yet
+    virtual void loadExcerpts(const INotationPtrList& excerptNotations) = 0;
     virtual void setExcerpts(const ExcerptNotationList& excerpts) = 0;
     virtual void resetExcerpt(IExcerptNotationPtr excerpt) = 0;
     virtual void sortExcerpts(ExcerptNotationList& excerpts) = 0;
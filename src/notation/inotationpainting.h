@@ -36,6 +36,7 @@ public:
     virtual ~INotationPainting() = default;
 
     using Options = engraving::rendering::IScoreRenderer::PaintOptions;
+    using PaintCachePtr = engraving::rendering::IScoreRenderer::PaintCachePtr;
 
     virtual void setViewMode(const ViewMode& vm) = 0;
     virtual ViewMode viewMode() const = 0;
@@ -45,7 +46,8 @@ public:
     virtual SizeF pageSizeInch() const = 0;
     virtual SizeF pageSizeInch(const Options& opt) const = 0;
 
-    virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+    virtual PaintCachePtr createPaintCache() const = 0;
+    virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting, const PaintCachePtr& cache) = 0;
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
@@ -23,6 +23,7 @@
 #include "excerptnotation.h"
 
 #include "engraving/dom/excerpt.h"
+#include "engraving/dom/masterscore.h"
 #include "engraving/dom/text.h"
 #include "engraving/dom/undo.h"
 
@@ -50,6 +51,12 @@ void ExcerptNotation::init()
 
     setScore(m_excerpt->excerptScore());
 
+    if (m_excerpt->isLazy()) {
+        m_excerpt->scoreLoaded().onNotify(this, [this]() {
+            setScore(m_excerpt->excerptScore());
+        });
+    }
+
     if (isEmpty()) {
         fillWithDefaultInfo();
     }
@@ -166,6 +173,12 @@ INotationPtr ExcerptNotation::notation()
 
 IExcerptNotationPtr ExcerptNotation::clone() const
 {
+    // read a lazy excerpt, its score is cloned
+    Ret ret = m_excerpt->masterScore()->loadLazyExcerpt(m_excerpt);
+    if (!ret) {
+        LOGE() << "failed to read excerpt " << m_excerpt->fileName() << ": " << ret.toString();
+    }
+
     mu::engraving::Excerpt* copy = new mu::engraving::Excerpt(*m_excerpt);
     copy->markAsCustom();
 
@@ -505,6 +505,21 @@ void MasterNotation::initExcerpts(const ExcerptNotationList& excerpts)
     }
 }
 
+void MasterNotation::loadExcerpts(const INotationPtrList& excerptNotations)
+{
+    for (IExcerptNotationPtr excerptNotation : m_excerpts) {
+        if (!mu::contains(excerptNotations, excerptNotation->notation())) {
+            continue;
+        }
+
+        mu::engraving::Excerpt* excerpt = get_impl(excerptNotation)->excerpt();
+        Ret ret = masterScore()->loadLazyExcerpt(excerpt);
+        if (!ret) {
+            LOGE() << "failed to read excerpt " << excerpt->fileName() << ": " << ret.toString();
+        }
+    }
+}
+
 void MasterNotation::setExcerpts(const ExcerptNotationList& excerpts)
 {
     TRACEFUNC;
@@ -614,6 +629,10 @@ void MasterNotation::setExcerptIsOpen(const INotationPtr excerptNotation, bool o
         return;
     }
 
+    if (open) {
+        loadExcerpts({ excerptNotation });
+    }
+
     excerptNotation->setIsOpen(open);
 
     if (open) {
@@ -662,7 +681,7 @@ void MasterNotation::updateExcerpts()
         }
 
         IExcerptNotationPtr excerptNotation = createAndInitExcerptNotation(excerpt);
-        bool open = excerpt->excerptScore()->isOpen();
+        bool open = excerptNotation->notation()->isOpen();
         if (open) {
             excerptNotation->notation()->elements()->msScore()->doLayout();
         }
@@ -178,7 +178,12 @@ void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const
     }
 }
 
-void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+INotationPainting::PaintCachePtr NotationPainting::createPaintCache() const
+{
+    return scoreRenderer()->createPaintCache();
+}
+
+void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting, const PaintCachePtr& cache)
 {
     Options opt;
     opt.isSetViewport = false;
@@ -186,6 +191,7 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.frameRect = frameRect;
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
+    opt.cache = isPrinting ? nullptr : cache;
     doPaint(painter, opt);
 }
 
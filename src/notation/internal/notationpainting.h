@@ -55,7 +55,8 @@ public:
     SizeF pageSizeInch() const override;
     SizeF pageSizeInch(const Options& opt) const override;
 
-    void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    PaintCachePtr createPaintCache() const override;
+    void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting, const PaintCachePtr& cache) override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
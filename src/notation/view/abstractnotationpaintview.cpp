@@ -581,7 +581,11 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     painter->setWorldTransform(m_matrix * guiScalingCompensation);
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    if (!m_paintCache) {
+        m_paintCache = notation()->painting()->createPaintCache();
+    }
+
+    notation()->painting()->paintView(painter, toLogical(rect), isPrinting, m_paintCache);
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -1227,6 +1231,7 @@ void AbstractNotationPaintView::dropEvent(QDropEvent* event)
 void AbstractNotationPaintView::setNotation(INotationPtr notation)
 {
     m_notation = notation;
+    m_paintCache = nullptr;
     m_continuousPanel->setNotation(m_notation);
     m_playbackCursor->setNotation(m_notation);
     m_loopInMarker->setNotation(m_notation);
@@ -251,6 +251,7 @@ private:
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
 
     INotationPtr m_notation;
+    INotationPainting::PaintCachePtr m_paintCache;
     draw::Transform m_matrix;
 
     std::unique_ptr<NotationViewInputController> m_inputController;
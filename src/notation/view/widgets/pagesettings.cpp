@@ -339,6 +339,7 @@ void PageSettings::applyToAllParts()
     if (!_changeFlag) {
         return;
     }
+    score()->masterScore()->loadLazyExcerpts();
     for (Excerpt* e : score()->masterScore()->excerpts()) {
         applyToScore(e->excerptScore());
     }
@@ -22,6 +22,7 @@
 
 #include "excerpt.h"
 #include "score.h"
+#include "engraving/dom/masterscore.h"
 #include "engraving/dom/score.h"
 
 namespace mu::plugins::api {
@@ -31,6 +32,7 @@ namespace mu::plugins::api {
 
 Score* Excerpt::partScore()
 {
+    e->masterScore()->loadLazyExcerpt(e);
     return wrap<Score>(e->excerptScore(), Ownership::SCORE);
 }
 
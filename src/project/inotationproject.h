@@ -26,6 +26,7 @@
 
 #include "io/path.h"
 #include "types/ret.h"
+#include "async/promise.h"
 
 #include "iprojectaudiosettings.h"
 #include "notation/imasternotation.h"
@@ -71,6 +72,10 @@ public:
     virtual Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) = 0;
     virtual Ret writeToDevice(QIODevice* device) = 0;
 
+    //! NOTE Like save(path, SaveMode::AutoSave), but only the snapshot of the project
+    //! is taken on the calling thread, the files are written on another one
+    virtual async::Promise<Ret> autoSaveInBackground(const io::path_t& path) = 0;
+
     virtual ProjectMeta metaInfo() const = 0;
     virtual void setMetaInfo(const ProjectMeta& meta, bool undoable = false) = 0;
 
@@ -23,6 +23,8 @@
 #ifndef MU_PROJECT_INOTATIONWRITER_H
 #define MU_PROJECT_INOTATIONWRITER_H
 
+#include <vector>
+
 #include "types/ret.h"
 #include "types/val.h"
 
@@ -30,6 +32,8 @@
 #include "global/progress.h"
 #include "notation/inotation.h"
 
+#include "log.h"
+
 namespace mu::project {
 class INotationWriter
 {
@@ -47,7 +51,8 @@ public:
         UNIT_TYPE,
         PAGE_NUMBER,
         TRANSPARENT_BACKGROUND,
-        BEATS_COLORS
+        BEATS_COLORS,
+        OTHER_PARTS_VOLUME // dB, the audio of a part also contains the other parts at this volume
     };
 
     using Options = QMap<OptionKey, Val>;
@@ -58,6 +63,24 @@ public:
     virtual Ret write(notation::INotationPtr notation, QIODevice& device, const Options& options = Options()) = 0;
     virtual Ret writeList(const notation::INotationPtrList& notations, QIODevice& device, const Options& options = Options()) = 0;
 
+    //! NOTE Writes each notation to its own device, the writers that can do it in one pass override it
+    virtual Ret writeEach(const notation::INotationPtrList& notations, const std::vector<QIODevice*>& devices,
+                          const Options& options = Options())
+    {
+        IF_ASSERT_FAILED(notations.size() == devices.size()) {
+            return make_ret(Ret::Code::InternalError);
+        }
+
+        for (size_t i = 0; i < notations.size(); ++i) {
+            Ret ret = write(notations[i], *devices[i], options);
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        return make_ok();
+    }
+
     virtual framework::Progress* progress() { return nullptr; }
     virtual void abort() {}
 };
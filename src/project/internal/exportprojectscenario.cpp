@@ -128,6 +128,9 @@ bool ExportProjectScenario::exportScores(const notation::INotationPtrList& notat
 
     masterNotation()->initExcerpts(excerptsToInit);
 
+    // Parts that were not open might not be read yet
+    masterNotation()->loadExcerpts(notations);
+
     // Scores that are closed may have never been laid out, so we lay them out now
     for (INotationPtr notation : notations) {
         mu::engraving::Score* score = notation->elements()->msScore();
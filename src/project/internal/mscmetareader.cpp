@@ -21,21 +21,29 @@
  */
 #include "mscmetareader.h"
 
+#include <algorithm>
+#include <functional>
 #include <sstream>
 
 #include "io/buffer.h"
 
-#include "stringutils.h"
-#include "global/deprecated/xmlreader.h"
+#include "serialization/json.h"
+#include "serialization/xmlstreamreader.h"
 #include "engraving/infrastructure/mscreader.h"
 
 #include "log.h"
 
+using namespace mu;
 using namespace mu::io;
 using namespace mu::project;
-using namespace mu::framework;
 using namespace mu::engraving;
 
+static constexpr int CACHE_VERSION = 2;
+static constexpr size_t CACHE_SAVE_INTERVAL = 64; // new entries
+static constexpr size_t CACHE_MAX_ENTRIES = 512;
+
+static const std::string CACHE_FILE_NAME("meta.json");
+
 mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) const
 {
     RetVal<ProjectMeta> meta;
@@ -53,15 +61,30 @@ mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) cons
         return make_ret(Ret::Code::InternalError);
     }
 
+    //! NOTE The file is only opened if it was changed since it was read last time
+    CacheEntry entry;
+    entry.modified = fileSystem()->lastModified(filePath).toString();
+    entry.size = fileSystem()->fileSize(filePath).val;
+
+    if (findCached(filePath, entry, meta.val)) {
+        meta.val.filePath = filePath;
+        return meta;
+    }
+
     MscReader msczReader(params);
     if (!msczReader.open()) {
         return make_ret(Ret::Code::InternalError);
     }
 
     // Read score meta
-    ByteArray scoreData = msczReader.readScoreFile();
-    framework::XmlReader xmlReader(scoreData.toQByteArray());
-    doReadMeta(xmlReader, meta.val);
+    //! NOTE The score is read as it is decompressed, only up to the frames of the first staff
+    std::unique_ptr<IODevice> scoreDevice = msczReader.openScoreFile();
+    if (scoreDevice) {
+        XmlStreamReader xmlReader(scoreDevice.get());
+        doReadMeta(xmlReader, meta.val);
+    }
+
+    entry.meta = meta.val;
 
     // Read thumbnail
     ByteArray thumbnailData = msczReader.readThumbnailFile();
@@ -71,37 +94,42 @@ mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) cons
         meta.val.thumbnail.loadFromData(thumbnailData.toQByteArray(), "PNG");
     }
 
+    addCached(filePath, entry, thumbnailData);
+
     meta.val.filePath = filePath;
 
     return meta;
 }
 
-MscMetaReader::RawMeta MscMetaReader::doReadBox(framework::XmlReader& xmlReader) const
+MscMetaReader::RawMeta MscMetaReader::doReadBox(XmlStreamReader& xmlReader) const
 {
     RawMeta meta;
 
     while (xmlReader.readNextStartElement()) {
-        if (xmlReader.tagName() == "Text") {
+        if (xmlReader.name() == "Text") {
             bool isTitle = false;
             bool isSubtitle = false;
             bool isComposer = false;
             bool isLyricist = false;
             while (xmlReader.readNextStartElement()) {
-                std::string tag(xmlReader.tagName());
+                AsciiStringView tag(xmlReader.name());
 
                 if (tag == "style") {
-                    std::string val = strings::toLower(xmlReader.readString());
+                    String val = xmlReader.readText().toLower();
 
-                    if (val == "title" || val == "2") {
+                    if (val == u"title" || val == u"2") {
                         isTitle = true;
-                    } else if (val == "composer" || val == "4") {
+                    } else if (val == u"composer" || val == u"4") {
                         isComposer = true;
-                    } else if (val == "subtitle") {
+                    } else if (val == u"subtitle") {
                         isSubtitle = true;
-                    } else if (val == "lyricist") {
+                    } else if (val == u"lyricist") {
                         isLyricist = true;
                     } else {
+                        //! NOTE Nothing else is needed from this text, the rest of it is skipped.
+                        //! The reader is then at the end of the text, so the loop over its children stops
                         xmlReader.skipCurrentElement();
+                        break;
                     }
                 } else if (tag == "text") {
                     if (isTitle) {
@@ -139,61 +167,68 @@ MscMetaReader::RawMeta MscMetaReader::doReadBox(framework::XmlReader& xmlReader)
     return meta;
 }
 
-MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(framework::XmlReader& xmlReader) const
+MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(XmlStreamReader& xmlReader) const
 {
     RawMeta meta;
 
     while (xmlReader.readNextStartElement()) {
-        std::string tag(xmlReader.tagName());
+        AsciiStringView tag(xmlReader.name());
 
         if (tag == "work-title") {
-            meta.titleTag = QString::fromStdString(xmlReader.readString());
+            meta.titleTag = xmlReader.readText().toQString();
         } else if (tag == "metaTag") {
-            std::string name = xmlReader.attribute("name");
+            String name = xmlReader.attribute("name");
 
-            if (name == "workTitle") {
+            if (name == u"workTitle") {
                 meta.titleAttribute = readMetaTagText(xmlReader);
-            } else if (name == "composer") {
+            } else if (name == u"composer") {
                 meta.composerAttribute = readMetaTagText(xmlReader);
-            } else if (name == "arranger") {
+            } else if (name == u"arranger") {
                 meta.arranger = readMetaTagText(xmlReader);
-            } else if (name == "lyricist") {
+            } else if (name == u"lyricist") {
                 meta.lyricistAttribute = readMetaTagText(xmlReader);
-            } else if (name == "copyright") {
+            } else if (name == u"copyright") {
                 meta.copyright = readMetaTagText(xmlReader);
-            } else if (name == "translator") {
+            } else if (name == u"translator") {
                 meta.translator = readMetaTagText(xmlReader);
-            } else if (name == "creationDate") {
+            } else if (name == u"creationDate") {
                 meta.creationDate = readMetaTagText(xmlReader);
             } else {
                 xmlReader.skipCurrentElement();
             }
         } else if (tag == "Staff") {
-            if (meta.titleStyle.isEmpty()) {
-                while (xmlReader.readNextStartElement()) {
-                    std::string boxTag(xmlReader.tagName());
-
-                    if (boxTag == "HBox"
-                        || boxTag == "VBox"
-                        || boxTag == "TBox"
-                        || boxTag == "FBox") {
-                        RawMeta boxMeta = doReadBox(xmlReader);
-
-                        meta.titleStyle = boxMeta.titleStyle;
-                        meta.titleStyleHtml = boxMeta.titleStyleHtml;
-                        meta.subtitleStyle = boxMeta.subtitleStyle;
-                        meta.subtitleStyleHtml = boxMeta.subtitleStyleHtml;
-                        meta.composerStyle = boxMeta.composerStyle;
-                        meta.composerStyleHtml = boxMeta.composerStyleHtml;
-                        meta.lyricistStyle = boxMeta.lyricistStyle;
-                        meta.lyricistStyleHtml = boxMeta.lyricistStyleHtml;
-                    } else {
-                        xmlReader.skipCurrentElement();
-                    }
+            //! NOTE The parts and the meta tags are before the staves, the title frames
+            //! are at the beginning of the first staff, nothing after them is needed
+            while (xmlReader.readNextStartElement()) {
+                AsciiStringView boxTag(xmlReader.name());
+
+                if (boxTag == "HBox"
+                    || boxTag == "VBox"
+                    || boxTag == "TBox"
+                    || boxTag == "FBox") {
+                    RawMeta boxMeta = doReadBox(xmlReader);
+
+                    auto merge = [](QString& value, const QString& boxValue) {
+                        if (!boxValue.isEmpty()) {
+                            value = boxValue;
+                        }
+                    };
+
+                    merge(meta.titleStyle, boxMeta.titleStyle);
+                    merge(meta.titleStyleHtml, boxMeta.titleStyleHtml);
+                    merge(meta.subtitleStyle, boxMeta.subtitleStyle);
+                    merge(meta.subtitleStyleHtml, boxMeta.subtitleStyleHtml);
+                    merge(meta.composerStyle, boxMeta.composerStyle);
+                    merge(meta.composerStyleHtml, boxMeta.composerStyleHtml);
+                    merge(meta.lyricistStyle, boxMeta.lyricistStyle);
+                    merge(meta.lyricistStyleHtml, boxMeta.lyricistStyleHtml);
+                } else {
+                    break;
                 }
-            } else {
-                xmlReader.skipCurrentElement();
             }
+
+            meta.isComplete = true;
+            return meta;
         } else if (tag == "Part") {
             meta.partsCount++;
             xmlReader.skipCurrentElement();
@@ -205,20 +240,20 @@ MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(framework::XmlReader& xmlRea
     return meta;
 }
 
-void MscMetaReader::doReadMeta(framework::XmlReader& xmlReader, ProjectMeta& meta) const
+void MscMetaReader::doReadMeta(XmlStreamReader& xmlReader, ProjectMeta& meta) const
 {
     RawMeta rawMeta;
 
-    while (xmlReader.readNextStartElement()) {
-        if (xmlReader.tagName() == "museScore") {
-            std::string version = xmlReader.attribute("version");
-            bool suitedVersion = version.rfind("1", 0) == 0;
+    while (!rawMeta.isComplete && xmlReader.readNextStartElement()) {
+        if (xmlReader.name() == "museScore") {
+            String version = xmlReader.attribute("version");
+            bool suitedVersion = version.startsWith(u"1");
 
             if (suitedVersion) {
                 rawMeta = doReadRawMeta(xmlReader);
             } else {
-                while (xmlReader.readNextStartElement()) {
-                    if (xmlReader.tagName() == "Score") {
+                while (!rawMeta.isComplete && xmlReader.readNextStartElement()) {
+                    if (xmlReader.name() == "Score") {
                         rawMeta = doReadRawMeta(xmlReader);
                     } else {
                         xmlReader.skipCurrentElement();
@@ -321,13 +356,242 @@ std::string MscMetaReader::cutXmlTags(const std::string& str) const
     return fin;
 }
 
-QString MscMetaReader::readText(mu::framework::XmlReader& xmlReader) const
+QString MscMetaReader::readText(XmlStreamReader& xmlReader) const
+{
+    //! NOTE The text of the child elements too, without their tags
+    String str;
+    int depth = 0;
+    while (!xmlReader.atEnd()) {
+        XmlStreamReader::TokenType token = xmlReader.readNext();
+        if (token == XmlStreamReader::StartElement) {
+            ++depth;
+        } else if (token == XmlStreamReader::EndElement) {
+            if (depth == 0) {
+                break;
+            }
+            --depth;
+        } else if (token == XmlStreamReader::Characters) {
+            str += xmlReader.text();
+        } else if (token == XmlStreamReader::Invalid) {
+            break;
+        }
+    }
+
+    return formatFromXml(str.toStdString());
+}
+
+QString MscMetaReader::readMetaTagText(XmlStreamReader& xmlReader) const
+{
+    return xmlReader.readText().toQString();
+}
+
+//---------------------------------------------------------
+//   cache
+//---------------------------------------------------------
+
+void MscMetaReader::flushCache() const
 {
-    std::string str = xmlReader.readString(framework::XmlReader::IncludeChildElements);
-    return formatFromXml(str);
+    std::lock_guard lock(m_cacheMutex);
+    if (m_cacheUnsaved > 0) {
+        saveCache();
+    }
 }
 
-QString MscMetaReader::readMetaTagText(mu::framework::XmlReader& xmlReader) const
+bool MscMetaReader::findCached(const io::path_t& filePath, const CacheEntry& key, ProjectMeta& meta) const
 {
-    return QString::fromStdString(xmlReader.readString());
+    std::lock_guard lock(m_cacheMutex);
+    loadCache();
+
+    auto it = m_cache.find(filePath);
+    if (it == m_cache.end()) {
+        return false;
+    }
+
+    if (it->second.modified != key.modified || it->second.size != key.size) {
+        evictCached(it);
+        return false;
+    }
+
+    ProjectMeta cachedMeta = it->second.meta;
+
+    if (!it->second.thumbnail.empty()) {
+        io::path_t thumbnailPath = configuration()->projectMetaCacheDirPath().appendingComponent(it->second.thumbnail);
+        RetVal<ByteArray> thumbnailData = fileSystem()->readFile(thumbnailPath);
+        if (!thumbnailData.ret) {
+            evictCached(it);
+            return false;
+        }
+
+        cachedMeta.thumbnail.loadFromData(thumbnailData.val.toQByteArray(), "PNG");
+    }
+
+    it->second.lastUsed = ++m_cacheUseCounter;
+    meta = cachedMeta;
+    return true;
+}
+
+void MscMetaReader::addCached(const io::path_t& filePath, CacheEntry entry, const ByteArray& thumbnailData) const
+{
+    std::lock_guard lock(m_cacheMutex);
+    loadCache();
+
+    entry.meta.thumbnail = QPixmap();
+
+    if (!thumbnailData.empty()) {
+        //! NOTE An entry without its thumbnail would hide the thumbnail of the project, so it is not kept
+        io::path_t cacheDir = configuration()->projectMetaCacheDirPath();
+        if (cacheDir.empty()) {
+            return;
+        }
+
+        std::stringstream name;
+        name << std::hex << std::hash<std::string> {}(filePath.toStdString()) << ".png";
+        entry.thumbnail = String::fromStdString(name.str());
+
+        fileSystem()->makePath(cacheDir);
+        Ret ret = fileSystem()->writeFile(cacheDir.appendingComponent(entry.thumbnail), thumbnailData);
+        if (!ret) {
+            LOGW() << "failed save thumbnail to project meta cache: " << ret.toString();
+            return;
+        }
+    }
+
+    entry.lastUsed = ++m_cacheUseCounter;
+    m_cache[filePath] = entry;
+
+    //! NOTE The least recently used entry goes when the cache is full
+    while (m_cache.size() > CACHE_MAX_ENTRIES) {
+        auto oldest = m_cache.begin();
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) {
+                oldest = it;
+            }
+        }
+
+        evictCached(oldest);
+    }
+
+    if (++m_cacheUnsaved >= CACHE_SAVE_INTERVAL) {
+        saveCache();
+    }
+}
+
+void MscMetaReader::evictCached(std::map<io::path_t, CacheEntry>::iterator it) const
+{
+    if (!it->second.thumbnail.empty()) {
+        io::path_t cacheDir = configuration()->projectMetaCacheDirPath();
+        fileSystem()->remove(cacheDir.appendingComponent(it->second.thumbnail));
+    }
+
+    m_cache.erase(it);
+    ++m_cacheUnsaved;
+}
+
+void MscMetaReader::loadCache() const
+{
+    if (m_cacheLoaded) {
+        return;
+    }
+    m_cacheLoaded = true;
+
+    io::path_t cacheDir = configuration()->projectMetaCacheDirPath();
+    if (cacheDir.empty()) {
+        return;
+    }
+
+    io::path_t path = cacheDir.appendingComponent(CACHE_FILE_NAME);
+    if (!fileSystem()->exists(path)) {
+        return;
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(path);
+    if (!data.ret) {
+        LOGW() << "failed read project meta cache: " << data.ret.toString();
+        return;
+    }
+
+    std::string err;
+    const JsonDocument json = JsonDocument::fromJson(data.val, &err);
+    if (!err.empty() || !json.isObject() || json.rootObject().value("version").toInt() != CACHE_VERSION) {
+        LOGW() << "ignored project meta cache: " << err;
+        return;
+    }
+
+    const JsonArray files = json.rootObject().value("files").toArray();
+    for (size_t i = 0; i < files.size(); ++i) {
+        const JsonObject obj = files.at(i).toObject();
+        const io::path_t filePath = obj.value("path").toStdString();
+
+        CacheEntry entry;
+        entry.modified = obj.value("modified").toString();
+        entry.size = static_cast<uint64_t>(obj.value("size").toDouble());
+        entry.thumbnail = obj.value("thumbnail").toString();
+        entry.lastUsed = static_cast<uint64_t>(obj.value("lastUsed").toDouble());
+
+        //! NOTE The entries of removed or moved files are dropped
+        if (!fileSystem()->exists(filePath)) {
+            if (!entry.thumbnail.empty()) {
+                fileSystem()->remove(cacheDir.appendingComponent(entry.thumbnail));
+            }
+            ++m_cacheUnsaved;
+            continue;
+        }
+
+        ProjectMeta& meta = entry.meta;
+        meta.title = obj.value("title").toString().toQString();
+        meta.subtitle = obj.value("subtitle").toString().toQString();
+        meta.composer = obj.value("composer").toString().toQString();
+        meta.arranger = obj.value("arranger").toString().toQString();
+        meta.lyricist = obj.value("lyricist").toString().toQString();
+        meta.translator = obj.value("translator").toString().toQString();
+        meta.copyright = obj.value("copyright").toString().toQString();
+        meta.creationDate = QDate::fromString(obj.value("creationDate").toString().toQString(), Qt::ISODate);
+        meta.partsCount = static_cast<size_t>(obj.value("partsCount").toInt());
+
+        m_cacheUseCounter = std::max(m_cacheUseCounter, entry.lastUsed);
+        m_cache[filePath] = entry;
+    }
+}
+
+void MscMetaReader::saveCache() const
+{
+    m_cacheUnsaved = 0;
+
+    io::path_t cacheDir = configuration()->projectMetaCacheDirPath();
+    if (cacheDir.empty()) {
+        return;
+    }
+
+    JsonArray files;
+    for (const auto& pair : m_cache) {
+        const ProjectMeta& meta = pair.second.meta;
+
+        JsonObject obj;
+        obj["path"] = pair.first.toStdString();
+        obj["modified"] = pair.second.modified;
+        obj["size"] = static_cast<double>(pair.second.size);
+        obj["thumbnail"] = pair.second.thumbnail;
+        obj["lastUsed"] = static_cast<double>(pair.second.lastUsed);
+        obj["title"] = String::fromQString(meta.title);
+        obj["subtitle"] = String::fromQString(meta.subtitle);
+        obj["composer"] = String::fromQString(meta.composer);
+        obj["arranger"] = String::fromQString(meta.arranger);
+        obj["lyricist"] = String::fromQString(meta.lyricist);
+        obj["translator"] = String::fromQString(meta.translator);
+        obj["copyright"] = String::fromQString(meta.copyright);
+        obj["creationDate"] = String::fromQString(meta.creationDate.toString(Qt::ISODate));
+        obj["partsCount"] = static_cast<int>(meta.partsCount);
+        files << obj;
+    }
+
+    JsonObject root;
+    root["version"] = CACHE_VERSION;
+    root["files"] = files;
+
+    fileSystem()->makePath(cacheDir);
+    Ret ret = fileSystem()->writeFile(cacheDir.appendingComponent(CACHE_FILE_NAME),
+                                      JsonDocument(root).toJson(JsonDocument::Format::Compact));
+    if (!ret) {
+        LOGW() << "failed save project meta cache: " << ret.toString();
+    }
 }
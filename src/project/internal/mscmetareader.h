@@ -22,23 +22,31 @@
 #ifndef MU_PROJECT_MSCMETAREADER_H
 #define MU_PROJECT_MSCMETAREADER_H
 
+#include <map>
+#include <mutex>
+
 #include "imscmetareader.h"
 
 #include "io/ifilesystem.h"
 #include "modularity/ioc.h"
+#include "iprojectconfiguration.h"
 
-namespace mu::framework {
-class XmlReader;
+namespace mu {
+class XmlStreamReader;
 }
 
 namespace mu::project {
 class MscMetaReader : public IMscMetaReader
 {
     INJECT(io::IFileSystem, fileSystem)
+    INJECT(IProjectConfiguration, configuration)
 
 public:
     RetVal<ProjectMeta> readMeta(const io::path_t& filePath) const;
 
+    //! NOTE Writes the entries added since the last save, called on module deinit
+    void flushCache() const;
+
 private:
 
     struct RawMeta {
@@ -65,11 +73,23 @@ private:
         QString creationDate;
 
         size_t partsCount = 0;
+
+        //! NOTE Everything needed has been read, the rest of the score is not
+        bool isComplete = false;
     };
 
-    void doReadMeta(framework::XmlReader& xmlReader, ProjectMeta& meta) const;
-    RawMeta doReadBox(framework::XmlReader& xmlReader) const;
-    RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
+    //! NOTE The meta of a file stays valid as long as the file is not changed
+    struct CacheEntry {
+        String modified;
+        uint64_t size = 0;
+        ProjectMeta meta; // without the thumbnail
+        String thumbnail; // file name in the cache dir, empty if the project has none
+        uint64_t lastUsed = 0;
+    };
+
+    void doReadMeta(XmlStreamReader& xmlReader, ProjectMeta& meta) const;
+    RawMeta doReadBox(XmlStreamReader& xmlReader) const;
+    RawMeta doReadRawMeta(XmlStreamReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
     QString format(const std::string& str) const;
@@ -77,8 +97,20 @@ private:
     QString simplified(const std::string& str) const;
     std::string cutXmlTags(const std::string& str) const;
 
-    QString readText(framework::XmlReader& xmlReader) const;
-    QString readMetaTagText(framework::XmlReader& xmlReader) const;
+    QString readText(XmlStreamReader& xmlReader) const;
+    QString readMetaTagText(XmlStreamReader& xmlReader) const;
+
+    bool findCached(const io::path_t& filePath, const CacheEntry& key, ProjectMeta& meta) const;
+    void addCached(const io::path_t& filePath, CacheEntry entry, const ByteArray& thumbnailData) const;
+    void evictCached(std::map<io::path_t, CacheEntry>::iterator it) const;
+    void loadCache() const;
+    void saveCache() const;
+
+    mutable std::mutex m_cacheMutex;
+    mutable std::map<io::path_t, CacheEntry> m_cache;
+    mutable bool m_cacheLoaded = false;
+    mutable size_t m_cacheUnsaved = 0;
+    mutable uint64_t m_cacheUseCounter = 0;
 };
 }
 
@@ -24,7 +24,9 @@
 #include <QBuffer>
 #include <QDir>
 #include <QFile>
+#include <QtConcurrent>
 
+#include "async/async.h"
 #include "io/buffer.h"
 
 #include "engraving/dom/undo.h"
@@ -79,6 +81,107 @@ static QString scoreDefaultTitle()
     return qtrc("project", "Untitled score");
 }
 
+//! NOTE Writes to a temporary container next to the target, then replaces the target with it;
+//! uses nothing of the project, so that it can run on another thread
+static Ret saveToContainer(const std::shared_ptr<io::IFileSystem>& fileSystem, const io::path_t& path, MscIoMode ioMode,
+                           const std::function<Ret(MscWriter&)>& write, const std::function<void()>& beforeReplace)
+{
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    io::path_t targetMainFilePath = engraving::mainFilePath(path);
+    io::path_t targetMainFileName = engraving::mainFileName(path);
+    QString savePath = targetContainerPath + "_saving";
+
+    // Step 1: check writable
+    {
+        if (fileSystem->exists(savePath) && !fileSystem->isWritable(savePath)) {
+            LOGE() << "failed save, not writable path: " << savePath;
+            return make_ret(notation::Err::UnknownError);
+        }
+
+        if (ioMode == engraving::MscIoMode::Dir) {
+            // Dir needs to be created, otherwise we can't move to it
+            if (!QDir(targetContainerPath).mkpath(".")) {
+                LOGE() << "Couldn't create container directory";
+                return make_ret(notation::Err::UnknownError);
+            }
+        }
+    }
+
+    // Step 2: write project
+    {
+        MscWriter::Params params;
+        params.filePath = savePath;
+        params.mainFileName = targetMainFileName.toQString();
+        params.mode = ioMode;
+        IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
+            return make_ret(Ret::Code::InternalError);
+        }
+
+        MscWriter msczWriter(params);
+        Ret ret = write(msczWriter);
+        msczWriter.close();
+
+        if (!ret) {
+            LOGE() << "failed write project to buffer: " << ret.toString();
+            return ret;
+        }
+
+        if (msczWriter.hasError()) {
+            LOGE() << "MscWriter has error after writing project";
+            return make_ret(Ret::Code::UnknownError);
+        }
+    }
+
+    // Step 3: create backup if need
+    {
+        if (beforeReplace) {
+            beforeReplace();
+        }
+    }
+
+    // Step 4: replace to saved file
+    {
+        if (ioMode == MscIoMode::Dir) {
+            RetVal<io::paths_t> filesToBeMoved = fileSystem->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
+            if (!filesToBeMoved.ret) {
+                return filesToBeMoved.ret;
+            }
+
+            Ret ret = make_ok();
+
+            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
+                io::path_t destinationFile
+                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
+                LOGD() << fileToBeMoved << " to " << destinationFile;
+                ret = fileSystem->move(fileToBeMoved, destinationFile, true);
+                if (!ret) {
+                    return ret;
+                }
+            }
+
+            // Try to remove the temp save folder (not problematic if fails)
+            ret = fileSystem->remove(savePath, true);
+            if (!ret) {
+                LOGW() << ret.toString();
+            }
+        } else {
+            Ret ret = fileSystem->move(savePath, targetContainerPath, true);
+            if (!ret) {
+                return ret;
+            }
+        }
+    }
+
+    // make file readable by all
+    {
+        QFile::setPermissions(targetMainFilePath.toQString(),
+                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    }
+
+    LOGI() << "success save file: " << targetContainerPath;
+    return make_ret(Ret::Code::Ok);
+}
+
 NotationProject::~NotationProject()
 {
     m_projectAudioSettings = nullptr;
@@ -130,9 +233,25 @@ mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePat
     m_isNewlyCreated = treatAsImported;
     m_isImported = treatAsImported;
 
+    if (m_engravingProject->masterScore()->hasLazyExcerpts()) {
+        loadLazyExcerptsInBackground();
+    }
+
     return ret;
 }
 
+void NotationProject::loadLazyExcerptsInBackground()
+{
+    //! NOTE One part per event loop iteration, so that the app stays responsive.
+    //! The parts are read on the main thread, like any change of the score
+    async::Async::call(this, [this]() {
+        MasterScore* masterScore = m_engravingProject ? m_engravingProject->masterScore() : nullptr;
+        if (masterScore && masterScore->loadNextLazyExcerpt()) {
+            loadLazyExcerptsInBackground();
+        }
+    });
+}
+
 mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format)
 {
     TRACEFUNC;
@@ -154,7 +273,10 @@ mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& styleP
     m_engravingProject->setFileInfoProvider(std::make_shared<ProjectFileInfoProvider>(this));
 
     SettingsCompat settingsCompat;
-    ret = m_engravingProject->loadMscz(reader, settingsCompat, forceMode);
+    // in the app, parts that were not open are read in the background after opening,
+    // or earlier when they are needed
+    bool lazyExcerpts = application() && application()->runMode() == framework::IApplication::RunMode::GuiApp;
+    ret = m_engravingProject->loadMscz(reader, settingsCompat, forceMode, lazyExcerpts);
     if (!ret) {
         return ret;
     }
@@ -481,20 +603,79 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
         return ret;
     }
     case SaveMode::AutoSave:
-        std::string suffix = io::suffix(path);
-        if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
-            suffix = io::suffix(io::completeBasename(path));
-        }
+        return saveScore(path, autoSaveSuffix(path), false /*generateBackup*/, false /*createThumbnail*/);
+    }
+
+    return make_ret(notation::Err::UnknownError);
+}
+
+async::Promise<Ret> NotationProject::autoSaveInBackground(const io::path_t& path)
+{
+    TRACEFUNC;
+
+    std::string suffix = autoSaveSuffix(path);
+    if (!isMuseScoreFile(suffix)) {
+        Ret ret = save(path, SaveMode::AutoSave);
+        return async::Promise<Ret>([ret](auto resolve, auto) {
+            return resolve(ret);
+        });
+    }
+
+    MscIoMode ioMode = mscIoModeBySuffix(suffix);
 
-        if (suffix.empty()) {
-            // Then it must be a MSCX folder
-            suffix = engraving::MSCX;
+    // Snapshot: the project is written to memory here, only compressing and writing the files is left
+    auto files = std::make_shared<MscWriter::Files>();
+    {
+        MscWriter::Params params;
+        params.filePath = path;
+        params.mainFileName = engraving::mainFileName(path).toString();
+        params.mode = ioMode;
+        params.files = files.get();
+
+        MscWriter msczWriter(params);
+        Ret ret = writeProject(msczWriter, false /*onlySelection*/, false /*createThumbnail*/);
+        msczWriter.close();
+
+        if (!ret) {
+            LOGE() << "failed write project to memory: " << ret.toString();
+            return async::Promise<Ret>([ret](auto resolve, auto) {
+                return resolve(ret);
+            });
         }
+    }
 
-        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/);
+    std::shared_ptr<io::IFileSystem> fs = fileSystem();
+
+    return async::Promise<Ret>([fs, path, ioMode, files](auto resolve, auto) {
+        QtConcurrent::run([fs, path, ioMode, files, resolve]() {
+            auto write = [files](MscWriter& msczWriter) {
+                Ret ret = msczWriter.open();
+                if (ret) {
+                    msczWriter.addFiles(*files);
+                }
+                return ret;
+            };
+
+            (void)resolve(saveToContainer(fs, path, ioMode, write, nullptr));
+        });
+
+        return async::Promise<Ret>::Result::unchecked();
+    }, async::Promise<Ret>::AsynchronyType::ProvidedByPromise);
+}
+
+std::string NotationProject::autoSaveSuffix(const io::path_t& path) const
+{
+    std::string suffix = io::suffix(path);
+    if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
+        suffix = io::suffix(io::completeBasename(path));
     }
 
-    return make_ret(notation::Err::UnknownError);
+    if (suffix.empty()) {
+        // Then it must be a MSCX folder
+        suffix = engraving::MSCX;
+    }
+
+    return suffix;
 }
 
 mu::Ret NotationProject::writeToDevice(QIODevice* device)
@@ -552,100 +733,17 @@ mu::Ret NotationProject::doSave(const io::path_t& path, engraving::MscIoMode ioM
 {
     TRACEFUNC;
 
-    QString targetContainerPath = engraving::containerPath(path).toQString();
-    io::path_t targetMainFilePath = engraving::mainFilePath(path);
-    io::path_t targetMainFileName = engraving::mainFileName(path);
-    QString savePath = targetContainerPath + "_saving";
-
-    // Step 1: check writable
-    {
-        if (fileSystem()->exists(savePath) && !fileSystem()->isWritable(savePath)) {
-            LOGE() << "failed save, not writable path: " << savePath;
-            return make_ret(notation::Err::UnknownError);
-        }
-
-        if (ioMode == engraving::MscIoMode::Dir) {
-            // Dir needs to be created, otherwise we can't move to it
-            if (!QDir(targetContainerPath).mkpath(".")) {
-                LOGE() << "Couldn't create container directory";
-                return make_ret(notation::Err::UnknownError);
-            }
-        }
-    }
-
-    // Step 2: write project
-    {
-        MscWriter::Params params;
-        params.filePath = savePath;
-        params.mainFileName = targetMainFileName.toQString();
-        params.mode = ioMode;
-        IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
-            return make_ret(Ret::Code::InternalError);
-        }
-
-        MscWriter msczWriter(params);
-        Ret ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
-        msczWriter.close();
-
-        if (!ret) {
-            LOGE() << "failed write project to buffer: " << ret.toString();
-            return ret;
-        }
-
-        if (msczWriter.hasError()) {
-            LOGE() << "MscWriter has error after writing project";
-            return make_ret(Ret::Code::UnknownError);
-        }
-    }
+    auto write = [this, createThumbnail](MscWriter& msczWriter) {
+        return writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
+    };
 
-    // Step 3: create backup if need
-    {
+    auto beforeReplace = [this, generateBackup]() {
         if (generateBackup) {
             makeCurrentFileAsBackup();
         }
-    }
-
-    // Step 4: replace to saved file
-    {
-        if (ioMode == MscIoMode::Dir) {
-            RetVal<io::paths_t> filesToBeMoved = fileSystem()->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
-            if (!filesToBeMoved.ret) {
-                return filesToBeMoved.ret;
-            }
-
-            Ret ret = make_ok();
-
-            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
-                io::path_t destinationFile
-                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
-                LOGD() << fileToBeMoved << " to " << destinationFile;
-                ret = fileSystem()->move(fileToBeMoved, destinationFile, true);
-                if (!ret) {
-                    return ret;
-                }
-            }
-
-            // Try to remove the temp save folder (not problematic if fails)
-            ret = fileSystem()->remove(savePath, true);
-            if (!ret) {
-                LOGW() << ret.toString();
-            }
-        } else {
-            Ret ret = fileSystem()->move(savePath, targetContainerPath, true);
-            if (!ret) {
-                return ret;
-            }
-        }
-    }
-
-    // make file readable by all
-    {
-        QFile::setPermissions(targetMainFilePath.toQString(),
-                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
-    }
+    };
 
-    LOGI() << "success save file: " << targetContainerPath;
-    return make_ret(Ret::Code::Ok);
+    return saveToContainer(fileSystem(), path, ioMode, write, beforeReplace);
 }
 
 mu::Ret NotationProject::makeCurrentFileAsBackup()
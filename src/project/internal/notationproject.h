@@ -27,6 +27,7 @@
 #include "async/asyncable.h"
 
 #include "modularity/ioc.h"
+#include "global/iapplication.h"
 #include "io/ifilesystem.h"
 #include "../iprojectconfiguration.h"
 #include "inotationreadersregister.h"
@@ -54,6 +55,7 @@ class NotationProject : public INotationProject, public async::Asyncable
     INJECT(INotationReadersRegister, readers)
     INJECT(INotationWritersRegister, writers)
     INJECT(IProjectMigrator, migrator)
+    INJECT(framework::IApplication, application)
 
 public:
     ~NotationProject() override;
@@ -91,6 +93,7 @@ public:
 
     Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) override;
     Ret writeToDevice(QIODevice* device) override;
+    async::Promise<Ret> autoSaveInBackground(const io::path_t& path) override;
 
     ProjectMeta metaInfo() const override;
     void setMetaInfo(const ProjectMeta& meta, bool undoable = false) override;
@@ -105,7 +108,9 @@ private:
 
     Ret doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format);
     Ret doImport(const io::path_t& path, const io::path_t& stylePath, bool forceMode);
+    void loadLazyExcerptsInBackground();
 
+    std::string autoSaveSuffix(const io::path_t& path) const;
     Ret saveScore(const io::path_t& path, const std::string& fileSuffix, bool generateBackup = true, bool createThumbnail = true);
     Ret saveSelectionOnScore(const io::path_t& path = io::path_t());
     Ret exportProject(const io::path_t& path, const std::string& suffix);
@@ -21,6 +21,8 @@
  */
 #include "projectautosaver.h"
 
+#include <chrono>
+
 #include "engraving/infrastructure/mscio.h"
 
 #include "defer.h"
@@ -144,8 +146,9 @@ void ProjectAutoSaver::onTrySave()
 {
     TRACEFUNC;
 
+    bool restartTimer = true;
     DEFER {
-        if (configuration()->isAutoSaveEnabled()) {
+        if (restartTimer && configuration()->isAutoSaveEnabled()) {
             m_timer.start();
         }
     };
@@ -169,15 +172,42 @@ void ProjectAutoSaver::onTrySave()
     io::path_t projectPath = this->projectPath(project);
     io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
 
-    Ret ret = project->save(savePath, SaveMode::AutoSave);
-    if (!ret) {
-        LOGE() << "[autosave] failed to save project, err: " << ret.toString();
-        return;
-    }
+    //! NOTE Only the snapshot of the project blocks the UI,
+    //! the timer is restarted when the files are written
+    const auto start = std::chrono::steady_clock::now();
+    async::Promise<Ret> promise = project->autoSaveInBackground(savePath);
+    const auto snapshotEnd = std::chrono::steady_clock::now();
 
+    // the changes from now on are for the next autosave
     project->setNeedAutoSave(false);
+    restartTimer = false;
+
+    std::weak_ptr<INotationProject> weakProject = project;
+    promise.onResolve(this, [this, weakProject, projectPath, start, snapshotEnd](const Ret& ret) {
+        using ms = std::chrono::duration<double, std::milli>;
+        const auto end = std::chrono::steady_clock::now();
+
+        if (configuration()->isAutoSaveEnabled()) {
+            m_timer.start();
+        }
+
+        if (!ret) {
+            LOGE() << "[autosave] failed to save project, err: " << ret.toString();
+
+            if (INotationProjectPtr project = weakProject.lock()) {
+                project->setNeedAutoSave(true);
+            }
+            return;
+        }
+
+        LOGI() << "[autosave] successfully saved project, snapshot: " << ms(snapshotEnd - start).count()
+               << " ms, in background: " << ms(end - snapshotEnd).count() << " ms";
 
-    LOGD() << "[autosave] successfully saved project";
+        // saved or closed while the files were written, the autosave is not needed anymore
+        if (m_lastProjectPathNeedingAutosave != projectPath) {
+            removeProjectUnsavedChanges(projectPath);
+        }
+    });
 }
 
 mu::io::path_t ProjectAutoSaver::projectPath(INotationProjectPtr project) const
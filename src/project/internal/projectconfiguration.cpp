@@ -141,6 +141,11 @@ ByteArray ProjectConfiguration::compatRecentFilesData() const
     return ByteArray(data.data(), data.size());
 }
 
+io::path_t ProjectConfiguration::projectMetaCacheDirPath() const
+{
+    return globalConfiguration()->userAppDataPath().appendingComponent("project_meta_cache");
+}
+
 io::path_t ProjectConfiguration::myFirstProjectPath() const
 {
     return appTemplatesPath() + "/My_First_Score.mscx";
@@ -50,6 +50,8 @@ public:
     io::path_t recentFilesJsonPath() const override;
     ByteArray compatRecentFilesData() const override;
 
+    io::path_t projectMetaCacheDirPath() const override;
+
     io::path_t myFirstProjectPath() const override;
 
     io::paths_t availableTemplateDirs() const override;
@@ -45,6 +45,8 @@ public:
     virtual io::path_t recentFilesJsonPath() const = 0;
     virtual ByteArray compatRecentFilesData() const = 0;
 
+    virtual io::path_t projectMetaCacheDirPath() const = 0;
+
     virtual io::path_t myFirstProjectPath() const = 0;
 
     virtual io::paths_t availableTemplateDirs() const = 0;
@@ -83,6 +83,7 @@ void ProjectModule::registerExports()
     m_configuration = std::make_shared<ProjectConfiguration>();
     m_actionsController = std::make_shared<ProjectActionsController>();
     m_projectAutoSaver = std::make_shared<ProjectAutoSaver>();
+    m_mscMetaReader = std::make_shared<MscMetaReader>();
 
 #ifdef Q_OS_MAC
     m_recentFilesController = std::make_shared<MacOSRecentFilesController>();
@@ -98,7 +99,7 @@ void ProjectModule::registerExports()
     ioc()->registerExport<IOpenSaveProjectScenario>(moduleName(), new OpenSaveProjectScenario());
     ioc()->registerExport<IExportProjectScenario>(moduleName(), new ExportProjectScenario());
     ioc()->registerExport<IRecentFilesController>(moduleName(), m_recentFilesController);
-    ioc()->registerExport<IMscMetaReader>(moduleName(), new MscMetaReader());
+    ioc()->registerExport<IMscMetaReader>(moduleName(), m_mscMetaReader);
     ioc()->registerExport<ITemplatesRepository>(moduleName(), new TemplatesRepository());
     ioc()->registerExport<IProjectMigrator>(moduleName(), new ProjectMigrator());
     ioc()->registerExport<IProjectAutoSaver>(moduleName(), m_projectAutoSaver);
@@ -177,3 +178,8 @@ void ProjectModule::onInit(const framework::IApplication::RunMode& mode)
     m_recentFilesController->init();
     m_projectAutoSaver->init();
 }
+
+void ProjectModule::onDeinit()
+{
+    m_mscMetaReader->flushCache();
+}
@@ -31,6 +31,7 @@ class ProjectConfiguration;
 class ProjectActionsController;
 class RecentFilesController;
 class ProjectAutoSaver;
+class MscMetaReader;
 class ProjectModule : public modularity::IModuleSetup
 {
 public:
@@ -41,12 +42,14 @@ public:
     void registerResources() override;
     void registerUiTypes() override;
     void onInit(const framework::IApplication::RunMode& mode) override;
+    void onDeinit() override;
 
 private:
     std::shared_ptr<ProjectConfiguration> m_configuration;
     std::shared_ptr<ProjectActionsController> m_actionsController;
     std::shared_ptr<RecentFilesController> m_recentFilesController;
     std::shared_ptr<ProjectAutoSaver> m_projectAutoSaver;
+    std::shared_ptr<MscMetaReader> m_mscMetaReader;
 };
 }
 
@@ -33,6 +33,8 @@ public:
     MOCK_METHOD(io::path_t, recentFilesJsonPath, (), (const, override));
     MOCK_METHOD(ByteArray, compatRecentFilesData, (), (const, override));
 
+    MOCK_METHOD(io::path_t, projectMetaCacheDirPath, (), (const, override));
+
     MOCK_METHOD(io::path_t, myFirstProjectPath, (), (const, override));
 
     MOCK_METHOD(io::paths_t, availableTemplateDirs, (), (const, override));
@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "project/internal/mscmetareader.h"
+
+#include "mocks/projectconfigurationmock.h"
+#include "global/tests/mocks/filesystemmock.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::project;
+using namespace mu::io;
+
+namespace mu::project {
+class Project_MscMetaReaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_reader = std::make_shared<MscMetaReader>();
+        m_fileSystem = std::make_shared<NiceMock<FileSystemMock> >();
+        m_configuration = std::make_shared<NiceMock<ProjectConfigurationMock> >();
+
+        m_reader->setfileSystem(m_fileSystem);
+        m_reader->setconfiguration(m_configuration);
+
+        //! NOTE No cache dir: the cache is kept in memory only
+        ON_CALL(*m_configuration, projectMetaCacheDirPath()).WillByDefault(Return(io::path_t()));
+
+        m_filePath = m_dir.filePath("score.mscx");
+
+        ON_CALL(*m_fileSystem, exists(m_filePath)).WillByDefault(Return(make_ok()));
+        setFileStat(DateTime(Date(2023, 1, 1), Time(10, 0, 0)), 1000);
+    }
+
+    void setFileStat(const DateTime& modified, uint64_t size)
+    {
+        ON_CALL(*m_fileSystem, lastModified(m_filePath)).WillByDefault(Return(modified));
+        ON_CALL(*m_fileSystem, fileSize(m_filePath)).WillByDefault(Return(RetVal<uint64_t>::make_ok(size)));
+    }
+
+    void writeScore(const QByteArray& title, const QByteArray& rest = QByteArray())
+    {
+        QFile file(m_filePath.toQString());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+        file.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<museScore version=\"4.10\">\n"
+                   "  <Score>\n"
+                   "    <metaTag name=\"composer\">Tag Composer</metaTag>\n"
+                   "    <Part><Staff id=\"1\"/></Part>\n"
+                   "    <Part><Staff id=\"2\"/></Part>\n"
+                   "    <Staff id=\"1\">\n"
+                   "      <VBox>\n"
+                   "        <Text><style>title</style><text>" + title + "</text></Text>\n"
+                   "        <Text><style>instrument_excerpt</style><text>Flute</text></Text>\n"
+                   "        <Text><style>composer</style><text>Frame Composer</text></Text>\n"
+                   "      </VBox>\n");
+
+        if (rest.isEmpty()) {
+            file.write("      <Measure><voice/></Measure>\n"
+                       "    </Staff>\n"
+                       "  </Score>\n"
+                       "</museScore>\n");
+        } else {
+            file.write(rest);
+        }
+    }
+
+    QTemporaryDir m_dir;
+    io::path_t m_filePath;
+
+    std::shared_ptr<MscMetaReader> m_reader;
+    std::shared_ptr<NiceMock<FileSystemMock> > m_fileSystem;
+    std::shared_ptr<NiceMock<ProjectConfigurationMock> > m_configuration;
+};
+}
+
+TEST_F(Project_MscMetaReaderTest, ReadMeta)
+{
+    // [GIVEN] A score with a title frame
+    writeScore("Title A");
+
+    // [WHEN] Read its meta
+    RetVal<ProjectMeta> meta = m_reader->readMeta(m_filePath);
+
+    // [THEN] The texts of the frame take precedence over the meta tags
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title.toStdString(), "Title A");
+    EXPECT_EQ(meta.val.composer.toStdString(), "Frame Composer");
+    EXPECT_EQ(meta.val.partsCount, 2u);
+    EXPECT_EQ(meta.val.filePath, m_filePath);
+}
+
+TEST_F(Project_MscMetaReaderTest, StopsAfterFirstStaffFrames)
+{
+    // [GIVEN] A score with another title frame later in the first staff,
+    //         and broken after that
+    writeScore("Title A",
+               "      <Measure><voice/></Measure>\n"
+               "      <VBox>\n"
+               "        <Text><style>title</style><text>Late Title</text></Text>\n"
+               "      </VBox>\n"
+               "    </Staff>\n"
+               "    <Staff id=\"2\">\n"
+               "      <Measure><voice><Chord>\n"
+               "  </Score");
+
+    // [WHEN] Read its meta
+    RetVal<ProjectMeta> meta = m_reader->readMeta(m_filePath);
+
+    // [THEN] Only the frames at the start of the first staff are read
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title.toStdString(), "Title A");
+    EXPECT_EQ(meta.val.composer.toStdString(), "Frame Composer");
+}
+
+TEST_F(Project_MscMetaReaderTest, CacheHit)
+{
+    // [GIVEN] The meta of a score was read
+    writeScore("Title A");
+    ASSERT_TRUE(m_reader->readMeta(m_filePath).ret);
+
+    // [GIVEN] The file can't be opened anymore, but its modification time and size are the same
+    ASSERT_TRUE(QFile::remove(m_filePath.toQString()));
+
+    // [WHEN] Read its meta again
+    RetVal<ProjectMeta> meta = m_reader->readMeta(m_filePath);
+
+    // [THEN] The meta is taken from the cache, the file is not opened
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title.toStdString(), "Title A");
+    EXPECT_EQ(meta.val.composer.toStdString(), "Frame Composer");
+    EXPECT_EQ(meta.val.partsCount, 2u);
+}
+
+TEST_F(Project_MscMetaReaderTest, CacheMissOnModifiedChange)
+{
+    // [GIVEN] The meta of a score was read
+    writeScore("Title A");
+    ASSERT_TRUE(m_reader->readMeta(m_filePath).ret);
+
+    // [GIVEN] The score is changed, the size stays the same
+    writeScore("Title B");
+    setFileStat(DateTime(Date(2023, 1, 1), Time(10, 0, 1)), 1000);
+
+    // [WHEN] Read its meta again
+    RetVal<ProjectMeta> meta = m_reader->readMeta(m_filePath);
+
+    // [THEN] The file is read again
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title.toStdString(), "Title B");
+}
+
+TEST_F(Project_MscMetaReaderTest, CacheMissOnSizeChange)
+{
+    // [GIVEN] The meta of a score was read
+    writeScore("Title A");
+    ASSERT_TRUE(m_reader->readMeta(m_filePath).ret);
+
+    // [GIVEN] The score is changed, the modification time stays the same
+    writeScore("Title B");
+    setFileStat(DateTime(Date(2023, 1, 1), Time(10, 0, 0)), 1001);
+
+    // [WHEN] Read its meta again
+    RetVal<ProjectMeta> meta = m_reader->readMeta(m_filePath);
+
+    // [THEN] The file is read again
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title.toStdString(), "Title B");
+}